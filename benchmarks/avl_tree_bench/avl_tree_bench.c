@@ -0,0 +1,256 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/avl_tree.h"
+#include "lib-util-c/binary_tree.h"
+#include "lib-util-c/app_logging.h"
+#include "bench_harness.h"
+
+#define MAX_KEY_COUNT           100000
+#define FIND_OPS                100000
+#define SCAN_OPS                10000
+#define SCAN_LENGTH             100
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+static const size_t KEY_COUNTS[] = { 256, 10000, 100000 };
+
+// The caller's record, the intrusive tree links it in place while
+// binary_tree points at it from a node of its own
+typedef struct TEST_RECORD_TAG
+{
+    uint64_t key;
+    size_t value;
+    AVL_TREE_ENTRY tree_entry;
+} TEST_RECORD;
+
+typedef struct TREE_CONTEXT_TAG
+{
+    AVL_TREE_ROOT avl_tree;
+    BINARY_TREE_HANDLE binary_tree;
+    uint32_t options;
+    size_t key_count;
+    TEST_RECORD records[MAX_KEY_COUNT];
+    uint64_t random_state;
+    size_t checksum;
+} TREE_CONTEXT;
+
+static int compare_records(const AVL_TREE_ENTRY* entry_1, const AVL_TREE_ENTRY* entry_2)
+{
+    uint64_t key_1 = AVL_TREE_CONTAINING_RECORD(entry_1, TEST_RECORD, tree_entry)->key;
+    uint64_t key_2 = AVL_TREE_CONTAINING_RECORD(entry_2, TEST_RECORD, tree_entry)->key;
+    return key_1 < key_2 ? -1 : (key_1 > key_2 ? 1 : 0);
+}
+
+static void avl_tree_insert_remove_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)avl_tree_insert(&tree_context->avl_tree, &tree_context->records[index].tree_entry);
+    }
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        avl_tree_remove_entry(&tree_context->avl_tree, &tree_context->records[index].tree_entry);
+    }
+}
+
+static void binary_tree_insert_remove_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)binary_tree_insert(tree_context->binary_tree, tree_context->records[index].key, &tree_context->records[index]);
+    }
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)binary_tree_remove(tree_context->binary_tree, tree_context->records[index].key, NULL);
+    }
+}
+
+// Every lookup hits and reads the record it lands on
+static void avl_tree_find_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    TEST_RECORD key_record;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        PAVL_TREE_ENTRY entry;
+        key_record.key = tree_context->records[key_index].key;
+        if ((entry = avl_tree_find(&tree_context->avl_tree, &key_record.tree_entry)) != NULL)
+        {
+            tree_context->checksum += AVL_TREE_CONTAINING_RECORD(entry, TEST_RECORD, tree_entry)->value;
+        }
+    }
+}
+
+static void binary_tree_find_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        const TEST_RECORD* record = (const TEST_RECORD*)binary_tree_find(tree_context->binary_tree, tree_context->records[key_index].key);
+        if (record != NULL)
+        {
+            tree_context->checksum += record->value;
+        }
+    }
+}
+
+static void avl_tree_scan_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        PAVL_TREE_ENTRY entry = avl_tree_lower_bound(&tree_context->avl_tree, &tree_context->records[key_index].tree_entry);
+        for (size_t step = 0; step < SCAN_LENGTH && entry != NULL; step++, entry = avl_tree_next(entry))
+        {
+            tree_context->checksum += AVL_TREE_CONTAINING_RECORD(entry, TEST_RECORD, tree_entry)->value;
+        }
+    }
+}
+
+static void binary_tree_scan_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        BINARY_TREE_ITERATOR iterator;
+        const TEST_RECORD* record;
+        (void)binary_tree_lower_bound(tree_context->binary_tree, tree_context->records[key_index].key, &iterator);
+        for (size_t step = 0; step < SCAN_LENGTH && (record = (const TEST_RECORD*)binary_tree_iterator_next(tree_context->binary_tree, &iterator, NULL)) != NULL; step++)
+        {
+            tree_context->checksum += record->value;
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, TREE_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "%s/%zu", operation, context->key_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_avl_tree_benches(BENCH_REPORT* report, TREE_CONTEXT* context)
+{
+    int result;
+    avl_tree_init(&context->avl_tree, compare_records);
+    if ((result = run_bench(report, "avl_tree_insert_remove", avl_tree_insert_remove_bench, context, context->key_count)) == 0)
+    {
+        for (size_t index = 0; index < context->key_count; index++)
+        {
+            (void)avl_tree_insert(&context->avl_tree, &context->records[index].tree_entry);
+        }
+        if ((result = run_bench(report, "avl_tree_find", avl_tree_find_bench, context, FIND_OPS)) == 0)
+        {
+            result = run_bench(report, "avl_tree_scan", avl_tree_scan_bench, context, SCAN_OPS);
+        }
+    }
+    return result;
+}
+
+static int run_binary_tree_benches(BENCH_REPORT* report, TREE_CONTEXT* context, uint32_t options, const char* prefix)
+{
+    int result;
+    if ((context->binary_tree = binary_tree_create_with_options(options, 0, NULL)) == NULL)
+    {
+        (void)printf("Failure creating binary tree\n");
+        result = __LINE__;
+    }
+    else
+    {
+        char operation[48];
+        (void)sprintf(operation, "%s_insert_remove", prefix);
+        if ((result = run_bench(report, operation, binary_tree_insert_remove_bench, context, context->key_count)) == 0)
+        {
+            for (size_t index = 0; index < context->key_count; index++)
+            {
+                (void)binary_tree_insert(context->binary_tree, context->records[index].key, &context->records[index]);
+            }
+            (void)sprintf(operation, "%s_find", prefix);
+            if ((result = run_bench(report, operation, binary_tree_find_bench, context, FIND_OPS)) == 0)
+            {
+                (void)sprintf(operation, "%s_scan", prefix);
+                result = run_bench(report, operation, binary_tree_scan_bench, context, SCAN_OPS);
+            }
+        }
+        binary_tree_destroy(context->binary_tree);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    TREE_CONTEXT* context;
+
+    if ((context = (TREE_CONTEXT*)malloc(sizeof(TREE_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "avl_tree_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        // binary_tree logs misses at debug level, keep that out of the timings
+        log_set_level(log_error);
+        context->random_state = 0x9E3779B97F4A7C15ULL;
+        context->checksum = 0;
+        for (size_t index = 0; index < MAX_KEY_COUNT; index++)
+        {
+            context->records[index].key = bench_random(&context->random_state);
+            context->records[index].value = index;
+        }
+
+        for (size_t count_index = 0; count_index < sizeof(KEY_COUNTS)/sizeof(KEY_COUNTS[0]) && result == 0; count_index++)
+        {
+            context->key_count = KEY_COUNTS[count_index];
+            if ((result = run_avl_tree_benches(&report, context)) == 0 &&
+                (result = run_binary_tree_benches(&report, context, BINARY_TREE_OPTION_NONE, "binary_tree")) == 0)
+            {
+                result = run_binary_tree_benches(&report, context, BINARY_TREE_OPTION_NODE_POOL, "binary_tree_pool");
+            }
+        }
+        // Keeps the lookups from being optimized away
+        (void)printf("checksum %zu\n", context->checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context);
+    }
+    return result;
+}
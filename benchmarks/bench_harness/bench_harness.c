@@ -0,0 +1,219 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifndef WIN32
+#define _POSIX_C_SOURCE 200112L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef WIN32
+#include <windows.h>
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define USE_RDTSC
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <x86intrin.h>
+#define USE_RDTSC
+#endif
+
+#if defined(__GLIBC__) && (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 33))
+#include <malloc.h>
+#define USE_MALLINFO2
+#endif
+
+#include "bench_harness.h"
+
+static int compare_samples(const void* value_1, const void* value_2)
+{
+    uint64_t sample_1 = *(const uint64_t*)value_1;
+    uint64_t sample_2 = *(const uint64_t*)value_2;
+    return (sample_1 > sample_2) - (sample_1 < sample_2);
+}
+
+uint64_t bench_get_time_ns(void)
+{
+#ifdef WIN32
+    LARGE_INTEGER counter;
+    LARGE_INTEGER frequency;
+    (void)QueryPerformanceCounter(&counter);
+    (void)QueryPerformanceFrequency(&frequency);
+    return (uint64_t)((double)counter.QuadPart * 1000000000.0 / (double)frequency.QuadPart);
+#else
+    struct timespec curr_time;
+    (void)clock_gettime(CLOCK_MONOTONIC, &curr_time);
+    return ((uint64_t)curr_time.tv_sec * 1000000000) + (uint64_t)curr_time.tv_nsec;
+#endif
+}
+
+int bench_calculate_stats(uint64_t* samples, size_t count, BENCH_STATS* stats)
+{
+    int result;
+    if (samples == NULL || count == 0 || stats == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        double total = 0;
+        qsort(samples, count, sizeof(uint64_t), compare_samples);
+        for (size_t index = 0; index < count; index++)
+        {
+            total += (double)samples[index];
+        }
+        stats->min = samples[0];
+        stats->median = samples[count/2];
+        stats->p99 = samples[(count*99)/100];
+        stats->max = samples[count-1];
+        stats->mean = total/count;
+        result = 0;
+    }
+    return result;
+}
+
+size_t bench_get_heap_usage(void)
+{
+#ifdef USE_MALLINFO2
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+uint64_t bench_random(uint64_t* state)
+{
+    uint64_t value = *state;
+    value ^= value << 13;
+    value ^= value >> 7;
+    value ^= value << 17;
+    *state = value;
+    return value;
+}
+
+uint64_t bench_get_cycles(void)
+{
+#ifdef USE_RDTSC
+    return (uint64_t)__rdtsc();
+#else
+    return 0;
+#endif
+}
+
+int bench_run(const char* name, BENCH_FUNCTION bench_fn, void* context, const BENCH_CONFIG* config, BENCH_RESULT* result)
+{
+    int bench_result;
+    uint64_t* samples;
+    if (name == NULL || bench_fn == NULL || config == NULL || result == NULL || config->repetitions == 0 || config->ops_per_rep == 0)
+    {
+        bench_result = __LINE__;
+    }
+    else if ((samples = (uint64_t*)malloc(config->repetitions*sizeof(uint64_t)*2)) == NULL)
+    {
+        bench_result = __LINE__;
+    }
+    else
+    {
+        uint64_t* cycle_samples = samples + config->repetitions;
+        for (size_t index = 0; index < config->warmup; index++)
+        {
+            bench_fn(context, config->ops_per_rep);
+        }
+        for (size_t index = 0; index < config->repetitions; index++)
+        {
+            uint64_t start_cycles = bench_get_cycles();
+            uint64_t start_time = bench_get_time_ns();
+            bench_fn(context, config->ops_per_rep);
+            samples[index] = bench_get_time_ns() - start_time;
+            cycle_samples[index] = bench_get_cycles() - start_cycles;
+        }
+
+        memset(result, 0, sizeof(BENCH_RESULT));
+        result->name = name;
+        result->config = *config;
+        (void)bench_calculate_stats(samples, config->repetitions, &result->stats);
+        result->ns_per_op = (double)result->stats.median/config->ops_per_rep;
+        if (config->bytes_per_rep > 0)
+        {
+            BENCH_STATS cycle_stats;
+            (void)bench_calculate_stats(cycle_samples, config->repetitions, &cycle_stats);
+            result->cycles_per_byte = (double)cycle_stats.median/config->bytes_per_rep;
+        }
+        free(samples);
+        bench_result = 0;
+    }
+    return bench_result;
+}
+
+int bench_report_init(BENCH_REPORT* report, const char* suite, int argc, char* argv[])
+{
+    int result = 0;
+    if (report == NULL || suite == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        report->suite = suite;
+        report->json_file = NULL;
+        report->result_count = 0;
+        for (int index = 1; index < argc - 1; index++)
+        {
+            if (strcmp(argv[index], "--json") == 0)
+            {
+                if ((report->json_file = fopen(argv[index + 1], "w")) == NULL)
+                {
+                    (void)printf("Failure opening %s\n", argv[index + 1]);
+                    result = __LINE__;
+                }
+                else
+                {
+                    (void)fprintf(report->json_file, "{\n  \"suite\": \"%s\",\n  \"results\": [", suite);
+                }
+                break;
+            }
+        }
+        (void)printf("%-32s %6s %10s %12s %12s %12s %10s %8s\n", suite, "reps", "ops", "min_ns", "median_ns", "p99_ns", "ns_op", "cyc_byte");
+    }
+    return result;
+}
+
+void bench_report_add(BENCH_REPORT* report, const BENCH_RESULT* result)
+{
+    if (report != NULL && result != NULL)
+    {
+        (void)printf("%-32s %6zu %10zu %12llu %12llu %12llu %10.2f %8.2f\n", result->name, result->config.repetitions, result->config.ops_per_rep,
+            (unsigned long long)result->stats.min, (unsigned long long)result->stats.median, (unsigned long long)result->stats.p99,
+            result->ns_per_op, result->cycles_per_byte);
+        if (report->json_file != NULL)
+        {
+            (void)fprintf(report->json_file, "%s\n    { \"name\": \"%s\", \"repetitions\": %zu, \"ops_per_rep\": %zu, \"bytes_per_rep\": %zu, "
+                "\"min_ns\": %llu, \"median_ns\": %llu, \"p99_ns\": %llu, \"max_ns\": %llu, \"mean_ns\": %.1f, "
+                "\"ns_per_op\": %.3f, \"cycles_per_byte\": %.3f }",
+                report->result_count == 0 ? "" : ",", result->name, result->config.repetitions, result->config.ops_per_rep, result->config.bytes_per_rep,
+                (unsigned long long)result->stats.min, (unsigned long long)result->stats.median, (unsigned long long)result->stats.p99,
+                (unsigned long long)result->stats.max, result->stats.mean, result->ns_per_op, result->cycles_per_byte);
+        }
+        report->result_count++;
+    }
+}
+
+int bench_report_deinit(BENCH_REPORT* report)
+{
+    int result = 0;
+    if (report != NULL && report->json_file != NULL)
+    {
+        (void)fprintf(report->json_file, "\n  ]\n}\n");
+        if (fclose(report->json_file) != 0)
+        {
+            result = __LINE__;
+        }
+        report->json_file = NULL;
+    }
+    return result;
+}
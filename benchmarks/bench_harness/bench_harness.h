@@ -0,0 +1,84 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#endif
+
+typedef struct BENCH_STATS_TAG
+{
+    uint64_t min;
+    uint64_t median;
+    uint64_t p99;
+    uint64_t max;
+    double mean;
+} BENCH_STATS;
+
+// Monotonic clock in nanoseconds
+extern uint64_t bench_get_time_ns(void);
+
+// Sorts the samples in place and fills in the stats
+extern int bench_calculate_stats(uint64_t* samples, size_t count, BENCH_STATS* stats);
+
+// Bytes currently allocated from the heap, zero when the
+// platform has no way of reporting it
+extern size_t bench_get_heap_usage(void);
+
+// Simple xorshift generator so runs are repeatable
+extern uint64_t bench_random(uint64_t* state);
+
+// Time stamp counter, zero on targets without one.  Only used to
+// report cycles/byte, elapsed time always comes from the clock
+extern uint64_t bench_get_cycles(void);
+
+// Runs ops_per_rep operations, the context is whatever the bench needs
+typedef void(*BENCH_FUNCTION)(void* context, size_t ops_per_rep);
+
+typedef struct BENCH_CONFIG_TAG
+{
+    // Untimed repetitions run first to warm caches and the branch predictor
+    size_t warmup;
+    size_t repetitions;
+    size_t ops_per_rep;
+    // Bytes processed by each repetition, 0 when cycles/byte means nothing
+    size_t bytes_per_rep;
+} BENCH_CONFIG;
+
+typedef struct BENCH_RESULT_TAG
+{
+    const char* name;
+    BENCH_CONFIG config;
+    // Per repetition, in nanoseconds
+    BENCH_STATS stats;
+    double ns_per_op;
+    double cycles_per_byte;
+} BENCH_RESULT;
+
+typedef struct BENCH_REPORT_TAG
+{
+    const char* suite;
+    FILE* json_file;
+    size_t result_count;
+} BENCH_REPORT;
+
+// Times config->repetitions calls of bench_fn, the per op and per byte
+// figures come from the median repetition
+extern int bench_run(const char* name, BENCH_FUNCTION bench_fn, void* context, const BENCH_CONFIG* config, BENCH_RESULT* result);
+
+// Starts a report on stdout, when --json <file> is on the command line
+// the results are also written there for tracking between releases
+extern int bench_report_init(BENCH_REPORT* report, const char* suite, int argc, char* argv[]);
+extern void bench_report_add(BENCH_REPORT* report, const BENCH_RESULT* result);
+extern int bench_report_deinit(BENCH_REPORT* report);
+
+#ifdef __cplusplus
+}
+#endif
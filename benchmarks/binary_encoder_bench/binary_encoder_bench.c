@@ -0,0 +1,164 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/binary_encoder.h"
+#include "bench_harness.h"
+
+#define MAX_SOURCE_SIZE         (64*1024)
+#define BYTES_PER_REP           (1024*1024)
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+typedef int(*ENCODE_FUNCTION)(const unsigned char* source, size_t size, char* result, size_t* result_len);
+typedef int(*DECODE_FUNCTION)(const char* source, unsigned char* result, size_t* result_len);
+
+typedef struct ENCODER_CONFIG_TAG
+{
+    const char* name;
+    ENCODE_FUNCTION encode_fn;
+    DECODE_FUNCTION decode_fn;
+} ENCODER_CONFIG;
+
+static const ENCODER_CONFIG ENCODER_CONFIGS[] =
+{
+    { "base32", bin_encoder_32_encode, bin_encoder_32_decode },
+    { "base64", bin_encoder_64_encode, bin_encoder_64_decode }
+};
+
+static const size_t SOURCE_SIZES[] = { 16, 256, 4096, 64*1024 };
+
+typedef struct ENCODER_CONTEXT_TAG
+{
+    const ENCODER_CONFIG* config;
+    const unsigned char* source;
+    size_t source_size;
+    char* encoded;
+    size_t encoded_size;
+    unsigned char* decoded;
+    size_t decoded_size;
+} ENCODER_CONTEXT;
+
+static void encode_bench(void* context, size_t ops_per_rep)
+{
+    ENCODER_CONTEXT* encoder = (ENCODER_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t result_len = encoder->encoded_size;
+        (void)encoder->config->encode_fn(encoder->source, encoder->source_size, encoder->encoded, &result_len);
+    }
+}
+
+static void decode_bench(void* context, size_t ops_per_rep)
+{
+    ENCODER_CONTEXT* encoder = (ENCODER_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t result_len = encoder->decoded_size;
+        (void)encoder->config->decode_fn(encoder->encoded, encoder->decoded, &result_len);
+    }
+}
+
+static int run_encoder(BENCH_REPORT* report, const ENCODER_CONFIG* encoder_config, const unsigned char* source, size_t source_size)
+{
+    int result;
+    ENCODER_CONTEXT context;
+
+    memset(&context, 0, sizeof(context));
+    context.config = encoder_config;
+    context.source = source;
+    context.source_size = source_size;
+    // Base32 grows the input by 8/5 and base64 by 4/3, twice the
+    // input covers both along with padding and the terminator
+    context.encoded_size = (source_size*2) + 16;
+    context.decoded_size = source_size + 8;
+    if ((context.encoded = (char*)malloc(context.encoded_size)) == NULL ||
+        (context.decoded = (unsigned char*)malloc(context.decoded_size)) == NULL)
+    {
+        (void)printf("Failure allocating encoder buffers\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t result_len = context.encoded_size;
+        BENCH_CONFIG config;
+        BENCH_RESULT bench_result;
+        char name[64];
+
+        config.warmup = WARMUP_REPS;
+        config.repetitions = BENCH_REPS;
+        config.ops_per_rep = BYTES_PER_REP/source_size;
+        config.bytes_per_rep = config.ops_per_rep*source_size;
+
+        result = 0;
+        (void)sprintf(name, "%s_encode/%zu", encoder_config->name, source_size);
+        if (encoder_config->encode_fn(source, source_size, context.encoded, &result_len) != 0 ||
+            bench_run(name, encode_bench, &context, &config, &bench_result) != 0)
+        {
+            (void)printf("Failure running %s\n", name);
+            result = __LINE__;
+        }
+        else
+        {
+            bench_report_add(report, &bench_result);
+
+            (void)sprintf(name, "%s_decode/%zu", encoder_config->name, source_size);
+            if (bench_run(name, decode_bench, &context, &config, &bench_result) != 0)
+            {
+                (void)printf("Failure running %s\n", name);
+                result = __LINE__;
+            }
+            else
+            {
+                bench_report_add(report, &bench_result);
+            }
+        }
+    }
+    free(context.encoded);
+    free(context.decoded);
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    unsigned char* source;
+
+    if ((source = (unsigned char*)malloc(MAX_SOURCE_SIZE)) == NULL)
+    {
+        (void)printf("Failure allocating source\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "binary_encoder_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(source);
+        result = __LINE__;
+    }
+    else
+    {
+        uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+        for (size_t index = 0; index < MAX_SOURCE_SIZE; index++)
+        {
+            source[index] = (unsigned char)bench_random(&random_state);
+        }
+
+        for (size_t config_index = 0; config_index < sizeof(ENCODER_CONFIGS)/sizeof(ENCODER_CONFIGS[0]) && result == 0; config_index++)
+        {
+            for (size_t size_index = 0; size_index < sizeof(SOURCE_SIZES)/sizeof(SOURCE_SIZES[0]) && result == 0; size_index++)
+            {
+                result = run_encoder(&report, &ENCODER_CONFIGS[config_index], source, SOURCE_SIZES[size_index]);
+            }
+        }
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(source);
+    }
+    return result;
+}
@@ -0,0 +1,256 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/binary_tree.h"
+#include "lib-util-c/app_logging.h"
+#include "bench_harness.h"
+
+#define MAX_KEY_COUNT           100000
+#define STRING_KEY_LENGTH       24
+#define FIND_OPS                100000
+#define SCAN_OPS                10000
+#define SCAN_LENGTH             100
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+static const size_t KEY_COUNTS[] = { 256, 10000, 100000 };
+static const uint32_t TREE_OPTIONS[] = { BINARY_TREE_OPTION_NONE, BINARY_TREE_OPTION_NODE_POOL };
+
+typedef struct TREE_CONTEXT_TAG
+{
+    BINARY_TREE_HANDLE tree;
+    // Set for the trees keyed by string_keys
+    int use_string_keys;
+    uint32_t options;
+    size_t key_count;
+    NODE_KEY keys[MAX_KEY_COUNT];
+    char string_keys[MAX_KEY_COUNT][STRING_KEY_LENGTH];
+    size_t values[MAX_KEY_COUNT];
+    uint64_t random_state;
+    size_t checksum;
+} TREE_CONTEXT;
+
+static int compare_string_keys(const void* key_1, const void* key_2)
+{
+    return strcmp((const char*)key_1, (const char*)key_2);
+}
+
+static void fill_tree(TREE_CONTEXT* context, size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        if (context->use_string_keys)
+        {
+            (void)binary_tree_insert_key(context->tree, context->string_keys[index], &context->values[index]);
+        }
+        else
+        {
+            (void)binary_tree_insert(context->tree, context->keys[index], &context->values[index]);
+        }
+    }
+}
+
+static BINARY_TREE_HANDLE create_tree(const TREE_CONTEXT* context)
+{
+    return binary_tree_create_with_options(context->options, 0, context->use_string_keys ? compare_string_keys : NULL);
+}
+
+// Builds a whole tree and tears it down, the node pool trades the
+// per node mallocs and frees for a handful of slabs
+static void build_destroy_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    BINARY_TREE_HANDLE tree = tree_context->tree;
+    if ((tree_context->tree = create_tree(tree_context)) != NULL)
+    {
+        fill_tree(tree_context, ops_per_rep);
+        binary_tree_destroy(tree_context->tree);
+    }
+    tree_context->tree = tree;
+}
+
+static void insert_remove_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    fill_tree(tree_context, ops_per_rep);
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        if (tree_context->use_string_keys)
+        {
+            (void)binary_tree_remove_key(tree_context->tree, tree_context->string_keys[index], NULL);
+        }
+        else
+        {
+            (void)binary_tree_remove(tree_context->tree, tree_context->keys[index], NULL);
+        }
+    }
+}
+
+// Every lookup hits so the full path is walked
+static void find_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        const size_t* value;
+        if (tree_context->use_string_keys)
+        {
+            value = (const size_t*)binary_tree_find_key(tree_context->tree, tree_context->string_keys[key_index]);
+        }
+        else
+        {
+            value = (const size_t*)binary_tree_find(tree_context->tree, tree_context->keys[key_index]);
+        }
+        if (value != NULL)
+        {
+            tree_context->checksum += *value;
+        }
+    }
+}
+
+// Ordered walks from a random start, lower_bound costs O(log n) and each
+// step follows the parent links
+static void scan_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        BINARY_TREE_ITERATOR iterator;
+        const size_t* value = NULL;
+        if (tree_context->use_string_keys)
+        {
+            (void)binary_tree_lower_bound_key(tree_context->tree, tree_context->string_keys[key_index], &iterator);
+        }
+        else
+        {
+            (void)binary_tree_lower_bound(tree_context->tree, tree_context->keys[key_index], &iterator);
+        }
+        for (size_t step = 0; step < SCAN_LENGTH; step++)
+        {
+            if (tree_context->use_string_keys)
+            {
+                value = (const size_t*)binary_tree_iterator_next_key(tree_context->tree, &iterator, NULL);
+            }
+            else
+            {
+                value = (const size_t*)binary_tree_iterator_next(tree_context->tree, &iterator, NULL);
+            }
+            if (value == NULL)
+            {
+                break;
+            }
+            tree_context->checksum += *value;
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, TREE_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "binary_tree_%s%s_%s/%zu", (context->options & BINARY_TREE_OPTION_NODE_POOL) ? "pool_" : "", context->use_string_keys ? "string" : "u64", operation, context->key_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_tree_benches(BENCH_REPORT* report, TREE_CONTEXT* context)
+{
+    int result;
+    if ((context->tree = create_tree(context)) == NULL)
+    {
+        (void)printf("Failure creating binary tree\n");
+        result = __LINE__;
+    }
+    else
+    {
+        if ((result = run_bench(report, "build_destroy", build_destroy_bench, context, context->key_count)) == 0 &&
+            (result = run_bench(report, "insert_remove", insert_remove_bench, context, context->key_count)) == 0)
+        {
+            fill_tree(context, context->key_count);
+            if ((result = run_bench(report, "find", find_bench, context, FIND_OPS)) == 0)
+            {
+                result = run_bench(report, "scan", scan_bench, context, SCAN_OPS);
+            }
+        }
+        binary_tree_destroy(context->tree);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    TREE_CONTEXT* context;
+
+    if ((context = (TREE_CONTEXT*)malloc(sizeof(TREE_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "binary_tree_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        // binary_tree logs misses at debug level, keep that out of the timings
+        log_set_level(log_error);
+        context->random_state = 0x9E3779B97F4A7C15ULL;
+        context->checksum = 0;
+        // Random 64 bit keys arrive in no particular order so the balancing gets exercised
+        for (size_t index = 0; index < MAX_KEY_COUNT; index++)
+        {
+            context->keys[index] = bench_random(&context->random_state);
+            (void)sprintf(context->string_keys[index], "key-%016llx", (unsigned long long)context->keys[index]);
+            context->values[index] = index;
+        }
+
+        for (size_t count_index = 0; count_index < sizeof(KEY_COUNTS)/sizeof(KEY_COUNTS[0]) && result == 0; count_index++)
+        {
+            context->key_count = KEY_COUNTS[count_index];
+            for (size_t option_index = 0; option_index < sizeof(TREE_OPTIONS)/sizeof(TREE_OPTIONS[0]) && result == 0; option_index++)
+            {
+                context->options = TREE_OPTIONS[option_index];
+                context->use_string_keys = 0;
+                if ((result = run_tree_benches(&report, context)) == 0)
+                {
+                    context->use_string_keys = 1;
+                    result = run_tree_benches(&report, context);
+                }
+            }
+        }
+        // Keeps the lookups from being optimized away
+        (void)printf("checksum %zu\n", context->checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context);
+    }
+    return result;
+}
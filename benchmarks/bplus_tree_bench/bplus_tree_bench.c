@@ -0,0 +1,257 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/binary_tree.h"
+#include "lib-util-c/bplus_tree.h"
+#include "lib-util-c/app_logging.h"
+#include "bench_harness.h"
+
+#define MAX_KEY_COUNT           1000000
+#define FIND_OPS                100000
+#define SCAN_OPS                10000
+#define SCAN_LENGTH             100
+#define WARMUP_REPS             1
+#define BENCH_REPS              7
+
+// The largest count is well past the last level cache so every
+// level of the binary tree below the top few is a miss
+static const size_t KEY_COUNTS[] = { 10000, 100000, 1000000 };
+
+typedef struct TREE_CONTEXT_TAG
+{
+    BINARY_TREE_HANDLE binary_tree;
+    BPLUS_TREE_HANDLE bplus_tree;
+    size_t key_count;
+    uint64_t keys[MAX_KEY_COUNT];
+    // The same keys ascending, for the bulk load
+    uint64_t sorted_keys[MAX_KEY_COUNT];
+    size_t values[MAX_KEY_COUNT];
+    void* value_ptrs[MAX_KEY_COUNT];
+    uint64_t random_state;
+    size_t checksum;
+} TREE_CONTEXT;
+
+static int compare_keys(const void* key_1, const void* key_2)
+{
+    uint64_t value_1 = *(const uint64_t*)key_1;
+    uint64_t value_2 = *(const uint64_t*)key_2;
+    return value_1 < value_2 ? -1 : (value_1 > value_2 ? 1 : 0);
+}
+
+static void binary_tree_insert_remove_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)binary_tree_insert(tree_context->binary_tree, tree_context->keys[index], &tree_context->values[index]);
+    }
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)binary_tree_remove(tree_context->binary_tree, tree_context->keys[index], NULL);
+    }
+}
+
+static void bplus_tree_insert_remove_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)bplus_tree_insert(tree_context->bplus_tree, tree_context->keys[index], &tree_context->values[index]);
+    }
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)bplus_tree_remove(tree_context->bplus_tree, tree_context->keys[index], NULL);
+    }
+}
+
+// Every lookup hits so the full path is walked
+static void binary_tree_find_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        const size_t* value = (const size_t*)binary_tree_find(tree_context->binary_tree, tree_context->keys[key_index]);
+        if (value != NULL)
+        {
+            tree_context->checksum += *value;
+        }
+    }
+}
+
+static void bplus_tree_find_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t key_index = (size_t)(bench_random(&tree_context->random_state) % tree_context->key_count);
+        const size_t* value = (const size_t*)bplus_tree_find(tree_context->bplus_tree, tree_context->keys[key_index]);
+        if (value != NULL)
+        {
+            tree_context->checksum += *value;
+        }
+    }
+}
+
+static void bplus_tree_bulk_load_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    BPLUS_TREE_HANDLE bplus_tree = bplus_tree_create(NULL, NULL);
+    if (bplus_tree != NULL)
+    {
+        if (bplus_tree_bulk_load(bplus_tree, tree_context->sorted_keys, tree_context->value_ptrs, ops_per_rep) == 0)
+        {
+            tree_context->checksum += bplus_tree_height(bplus_tree);
+        }
+        bplus_tree_destroy(bplus_tree);
+    }
+}
+
+// Short ordered scans from a random start, the leaf links keep
+// each step inside a node or one pointer away
+static void bplus_tree_range_scan_bench(void* context, size_t ops_per_rep)
+{
+    TREE_CONTEXT* tree_context = (TREE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        BPLUS_TREE_ITERATOR iterator;
+        uint64_t key;
+        if (bplus_tree_lower_bound(tree_context->bplus_tree, bench_random(&tree_context->random_state), &iterator) == 0)
+        {
+            for (size_t step = 0; step < SCAN_LENGTH && bplus_tree_iterator_next(tree_context->bplus_tree, &iterator, &key, NULL) == 0; step++)
+            {
+                tree_context->checksum += (size_t)key;
+            }
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, TREE_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "%s/%zu", operation, context->key_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_binary_tree_benches(BENCH_REPORT* report, TREE_CONTEXT* context)
+{
+    int result;
+    if ((context->binary_tree = binary_tree_create()) == NULL)
+    {
+        (void)printf("Failure creating binary tree\n");
+        result = __LINE__;
+    }
+    else
+    {
+        if ((result = run_bench(report, "binary_tree_insert_remove", binary_tree_insert_remove_bench, context, context->key_count)) == 0)
+        {
+            for (size_t index = 0; index < context->key_count; index++)
+            {
+                (void)binary_tree_insert(context->binary_tree, context->keys[index], &context->values[index]);
+            }
+            result = run_bench(report, "binary_tree_find", binary_tree_find_bench, context, FIND_OPS);
+        }
+        binary_tree_destroy(context->binary_tree);
+    }
+    return result;
+}
+
+static int run_bplus_tree_benches(BENCH_REPORT* report, TREE_CONTEXT* context)
+{
+    int result;
+    if ((context->bplus_tree = bplus_tree_create(NULL, NULL)) == NULL)
+    {
+        (void)printf("Failure creating b+ tree\n");
+        result = __LINE__;
+    }
+    else
+    {
+        if ((result = run_bench(report, "bplus_tree_insert_remove", bplus_tree_insert_remove_bench, context, context->key_count)) == 0 &&
+            (result = run_bench(report, "bplus_tree_bulk_load", bplus_tree_bulk_load_bench, context, context->key_count)) == 0)
+        {
+            for (size_t index = 0; index < context->key_count; index++)
+            {
+                (void)bplus_tree_insert(context->bplus_tree, context->keys[index], &context->values[index]);
+            }
+            if ((result = run_bench(report, "bplus_tree_find", bplus_tree_find_bench, context, FIND_OPS)) == 0)
+            {
+                result = run_bench(report, "bplus_tree_range_scan", bplus_tree_range_scan_bench, context, SCAN_OPS);
+            }
+        }
+        bplus_tree_destroy(context->bplus_tree);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    TREE_CONTEXT* context;
+
+    if ((context = (TREE_CONTEXT*)malloc(sizeof(TREE_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "bplus_tree_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        // binary_tree logs misses at debug level, keep that out of the timings
+        log_set_level(log_error);
+        context->random_state = 0x9E3779B97F4A7C15ULL;
+        context->checksum = 0;
+        for (size_t index = 0; index < MAX_KEY_COUNT; index++)
+        {
+            context->keys[index] = bench_random(&context->random_state);
+            context->values[index] = index;
+            context->value_ptrs[index] = &context->values[index];
+        }
+
+        for (size_t count_index = 0; count_index < sizeof(KEY_COUNTS)/sizeof(KEY_COUNTS[0]) && result == 0; count_index++)
+        {
+            context->key_count = KEY_COUNTS[count_index];
+            memcpy(context->sorted_keys, context->keys, context->key_count*sizeof(uint64_t));
+            qsort(context->sorted_keys, context->key_count, sizeof(uint64_t), compare_keys);
+            if ((result = run_binary_tree_benches(&report, context)) == 0)
+            {
+                result = run_bplus_tree_benches(&report, context);
+            }
+        }
+        // Keeps the lookups from being optimized away
+        (void)printf("checksum %zu\n", context->checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context);
+    }
+    return result;
+}
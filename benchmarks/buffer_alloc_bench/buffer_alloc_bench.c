@@ -0,0 +1,263 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/buffer_alloc.h"
+#include "bench_harness.h"
+
+#define BYTES_PER_REP           (64*1024)
+#define MAX_CHUNK_SIZE          1024
+#define PAYLOAD_CHUNK_SIZE      256
+#define FRAGMENT_LENGTH         16
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+#define PAYLOAD_BENCH_REPS      5
+
+static const size_t CHUNK_SIZES[] = { 8, 64, 1024 };
+// Many small appends into one large payload, the growth steps and
+// whatever gets done to the new memory are most of the cost
+static const size_t PAYLOAD_SIZES[] = { 1024, 1024*1024, 100*1024*1024 };
+// Short string appends onto an ever longer string, a log line or json
+// document being built up a piece at a time
+static const size_t FRAGMENT_COUNTS[] = { 1000, 10000, 100000, 1000000 };
+// Short lived buffers holding a key, a header value or a small message,
+// the ones under BUFFER_INLINE_SIZE never go to the heap
+static const size_t SHORT_SIZES[] = { 8, 32, 48, 96 };
+
+typedef struct BUFFER_CONTEXT_TAG
+{
+    char string_chunk[MAX_CHUNK_SIZE + 1];
+    char fragment[FRAGMENT_LENGTH + 1];
+    unsigned char byte_chunk[MAX_CHUNK_SIZE];
+    size_t chunk_size;
+    size_t payload_size;
+    size_t checksum;
+} BUFFER_CONTEXT;
+
+// Every repetition builds a buffer from nothing so the growth
+// policy is part of what gets measured
+static void string_append_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    STRING_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)string_buffer_construct(&buffer, buffer_context->string_chunk);
+    }
+    buffer_context->checksum += (unsigned char)buffer.payload[0];
+    string_buffer_free(&buffer);
+}
+
+static void string_sprintf_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    STRING_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)string_buffer_construct_sprintf(&buffer, "%s", buffer_context->string_chunk);
+    }
+    buffer_context->checksum += (unsigned char)buffer.payload[0];
+    string_buffer_free(&buffer);
+}
+
+static void byte_append_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    BYTE_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)byte_buffer_construct(&buffer, buffer_context->byte_chunk, buffer_context->chunk_size);
+    }
+    buffer_context->checksum += buffer.payload_size;
+    byte_buffer_free(&buffer);
+}
+
+static void byte_payload_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    BYTE_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)byte_buffer_construct(&buffer, buffer_context->byte_chunk, PAYLOAD_CHUNK_SIZE);
+    }
+    buffer_context->checksum += buffer.payload_size;
+    byte_buffer_free(&buffer);
+}
+
+// The same appends after a single reserve, no growth at all
+static void byte_payload_reserve_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    BYTE_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    if (byte_buffer_reserve(&buffer, buffer_context->payload_size) == 0)
+    {
+        for (size_t index = 0; index < ops_per_rep; index++)
+        {
+            (void)byte_buffer_construct(&buffer, buffer_context->byte_chunk, PAYLOAD_CHUNK_SIZE);
+        }
+        buffer_context->checksum += buffer.payload_size;
+        byte_buffer_free(&buffer);
+    }
+}
+
+static void string_fragment_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    STRING_BUFFER buffer;
+    memset(&buffer, 0, sizeof(buffer));
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)string_buffer_construct(&buffer, buffer_context->fragment);
+    }
+    buffer_context->checksum += (unsigned char)buffer.payload[0];
+    string_buffer_free(&buffer);
+}
+
+// A buffer per message, built then thrown away
+static void string_short_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        STRING_BUFFER buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        (void)string_buffer_construct(&buffer, buffer_context->string_chunk);
+        buffer_context->checksum += buffer.payload_size;
+        string_buffer_free(&buffer);
+    }
+}
+
+static void byte_short_bench(void* context, size_t ops_per_rep)
+{
+    BUFFER_CONTEXT* buffer_context = (BUFFER_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        BYTE_BUFFER buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        (void)byte_buffer_construct(&buffer, buffer_context->byte_chunk, buffer_context->chunk_size);
+        buffer_context->checksum += buffer.payload_size;
+        byte_buffer_free(&buffer);
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, BUFFER_CONTEXT* context)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = BYTES_PER_REP/context->chunk_size;
+    config.bytes_per_rep = config.ops_per_rep*context->chunk_size;
+    (void)sprintf(name, "%s/%zu", operation, context->chunk_size);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_payload_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, BUFFER_CONTEXT* context, size_t ops_per_rep, size_t bytes_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = 1;
+    config.repetitions = PAYLOAD_BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = bytes_per_rep;
+    (void)sprintf(name, "%s/%zu", operation, bytes_per_rep);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    BUFFER_CONTEXT context;
+
+    memset(&context, 0, sizeof(context));
+    if (bench_report_init(&report, "buffer_alloc_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < MAX_CHUNK_SIZE; index++)
+        {
+            context.byte_chunk[index] = (unsigned char)index;
+        }
+
+        for (size_t size_index = 0; size_index < sizeof(CHUNK_SIZES)/sizeof(CHUNK_SIZES[0]) && result == 0; size_index++)
+        {
+            context.chunk_size = CHUNK_SIZES[size_index];
+            memset(context.string_chunk, 'a', context.chunk_size);
+            context.string_chunk[context.chunk_size] = '\0';
+            if ((result = run_bench(&report, "string_buffer_append", string_append_bench, &context)) == 0 &&
+                (result = run_bench(&report, "string_buffer_sprintf", string_sprintf_bench, &context)) == 0)
+            {
+                result = run_bench(&report, "byte_buffer_append", byte_append_bench, &context);
+            }
+        }
+        for (size_t size_index = 0; size_index < sizeof(PAYLOAD_SIZES)/sizeof(PAYLOAD_SIZES[0]) && result == 0; size_index++)
+        {
+            context.payload_size = PAYLOAD_SIZES[size_index];
+            if ((result = run_payload_bench(&report, "byte_buffer_payload", byte_payload_bench, &context, context.payload_size/PAYLOAD_CHUNK_SIZE, context.payload_size)) == 0)
+            {
+                result = run_payload_bench(&report, "byte_buffer_payload_reserve", byte_payload_reserve_bench, &context, context.payload_size/PAYLOAD_CHUNK_SIZE, context.payload_size);
+            }
+        }
+        for (size_t size_index = 0; size_index < sizeof(SHORT_SIZES)/sizeof(SHORT_SIZES[0]) && result == 0; size_index++)
+        {
+            context.chunk_size = SHORT_SIZES[size_index];
+            memset(context.string_chunk, 's', context.chunk_size);
+            context.string_chunk[context.chunk_size] = '\0';
+            if ((result = run_bench(&report, "string_buffer_short", string_short_bench, &context)) == 0)
+            {
+                result = run_bench(&report, "byte_buffer_short", byte_short_bench, &context);
+            }
+        }
+        memset(context.fragment, 'f', FRAGMENT_LENGTH);
+        context.fragment[FRAGMENT_LENGTH] = '\0';
+        for (size_t count_index = 0; count_index < sizeof(FRAGMENT_COUNTS)/sizeof(FRAGMENT_COUNTS[0]) && result == 0; count_index++)
+        {
+            result = run_payload_bench(&report, "string_buffer_fragments", string_fragment_bench, &context, FRAGMENT_COUNTS[count_index], FRAGMENT_COUNTS[count_index]*FRAGMENT_LENGTH);
+        }
+        // Keeps the appends from being optimized away
+        (void)printf("checksum %zu\n", context.checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,165 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/buffer_alloc.h"
+#include "lib-util-c/buffer_chain.h"
+#include "bench_harness.h"
+
+#define HEADER_LENGTH           16
+#define TRAILER_LENGTH          8
+#define MAX_PAYLOAD_SIZE        (1024*1024)
+#define BYTES_PER_REP           (16*1024*1024)
+#define MAX_IOV_COUNT           8
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+// A message framed with a header and trailer, what a send path does
+// before every write
+static const size_t PAYLOAD_SIZES[] = { 1024, 64*1024, 1024*1024 };
+
+typedef struct CHAIN_CONTEXT_TAG
+{
+    unsigned char header[HEADER_LENGTH];
+    unsigned char trailer[TRAILER_LENGTH];
+    unsigned char* payload;
+    size_t payload_size;
+    BUFFER_CHAIN_HANDLE chain;
+    size_t checksum;
+} CHAIN_CONTEXT;
+
+// Every piece is appended onto one contiguous buffer, the payload is
+// copied in and the buffer grows around it
+static void byte_buffer_frame_bench(void* context, size_t ops_per_rep)
+{
+    CHAIN_CONTEXT* chain_context = (CHAIN_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        BYTE_BUFFER buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        (void)byte_buffer_construct(&buffer, chain_context->header, HEADER_LENGTH);
+        (void)byte_buffer_construct(&buffer, chain_context->payload, chain_context->payload_size);
+        (void)byte_buffer_construct(&buffer, chain_context->trailer, TRAILER_LENGTH);
+        chain_context->checksum += buffer.payload[buffer.payload_size - 1];
+        byte_buffer_free(&buffer);
+    }
+}
+
+// The payload is linked in where it is and the iovec is what a writev
+// would be handed, then the whole message is consumed as if sent
+static void buffer_chain_frame_bench(void* context, size_t ops_per_rep)
+{
+    CHAIN_CONTEXT* chain_context = (CHAIN_CONTEXT*)context;
+    BUFFER_CHAIN_IOVEC iov_array[MAX_IOV_COUNT];
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t iov_count;
+        (void)buffer_chain_append(chain_context->chain, chain_context->payload, chain_context->payload_size, NULL, NULL);
+        (void)buffer_chain_prepend_copy(chain_context->chain, chain_context->header, HEADER_LENGTH);
+        (void)buffer_chain_append_copy(chain_context->chain, chain_context->trailer, TRAILER_LENGTH);
+        iov_count = buffer_chain_get_iovec(chain_context->chain, iov_array, MAX_IOV_COUNT);
+        chain_context->checksum += ((const unsigned char*)iov_array[iov_count - 1].iov_base)[TRAILER_LENGTH - 1];
+        (void)buffer_chain_consume(chain_context->chain, buffer_chain_get_length(chain_context->chain));
+    }
+}
+
+// The same framing for a caller that needs the message in one piece
+static void buffer_chain_flatten_bench(void* context, size_t ops_per_rep)
+{
+    CHAIN_CONTEXT* chain_context = (CHAIN_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        BYTE_BUFFER buffer;
+        memset(&buffer, 0, sizeof(buffer));
+        (void)buffer_chain_append(chain_context->chain, chain_context->payload, chain_context->payload_size, NULL, NULL);
+        (void)buffer_chain_prepend_copy(chain_context->chain, chain_context->header, HEADER_LENGTH);
+        (void)buffer_chain_append_copy(chain_context->chain, chain_context->trailer, TRAILER_LENGTH);
+        (void)buffer_chain_flatten(chain_context->chain, &buffer);
+        chain_context->checksum += buffer.payload[buffer.payload_size - 1];
+        byte_buffer_free(&buffer);
+        (void)buffer_chain_consume(chain_context->chain, buffer_chain_get_length(chain_context->chain));
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, CHAIN_CONTEXT* context)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = BYTES_PER_REP/context->payload_size;
+    config.bytes_per_rep = config.ops_per_rep*(HEADER_LENGTH + context->payload_size + TRAILER_LENGTH);
+    (void)sprintf(name, "%s/%zu", operation, context->payload_size);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    CHAIN_CONTEXT context;
+
+    memset(&context, 0, sizeof(context));
+    if ((context.payload = (unsigned char*)malloc(MAX_PAYLOAD_SIZE)) == NULL)
+    {
+        (void)printf("Failure allocating payload\n");
+        result = __LINE__;
+    }
+    else if ((context.chain = buffer_chain_create()) == NULL)
+    {
+        (void)printf("Failure creating buffer chain\n");
+        free(context.payload);
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "buffer_chain_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        buffer_chain_destroy(context.chain);
+        free(context.payload);
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < MAX_PAYLOAD_SIZE; index++)
+        {
+            context.payload[index] = (unsigned char)index;
+        }
+        memset(context.header, 'h', HEADER_LENGTH);
+        memset(context.trailer, 't', TRAILER_LENGTH);
+
+        for (size_t size_index = 0; size_index < sizeof(PAYLOAD_SIZES)/sizeof(PAYLOAD_SIZES[0]) && result == 0; size_index++)
+        {
+            context.payload_size = PAYLOAD_SIZES[size_index];
+            if ((result = run_bench(&report, "byte_buffer_frame", byte_buffer_frame_bench, &context)) == 0 &&
+                (result = run_bench(&report, "buffer_chain_frame", buffer_chain_frame_bench, &context)) == 0)
+            {
+                result = run_bench(&report, "buffer_chain_flatten", buffer_chain_flatten_bench, &context);
+            }
+        }
+        // Keeps the framing from being optimized away
+        (void)printf("checksum %zu\n", context.checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        buffer_chain_destroy(context.chain);
+        free(context.payload);
+    }
+    return result;
+}
@@ -0,0 +1,229 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/item_map.h"
+#include "lib-util-c/concurrent_map.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/thread_mgr.h"
+#include "bench_harness.h"
+
+#define KEY_COUNT               1000000
+#define OPS_PER_THREAD          100000
+#define MAX_THREADS             64
+#define WARMUP_REPS             1
+#define BENCH_REPS              5
+#define KEY_LENGTH              32
+// One in UPDATE_RATIO operations removes and re-adds a key,
+// everything else is a lookup
+#define UPDATE_RATIO            10
+
+static const size_t THREAD_COUNTS[] = { 1, 2, 4, 8, 16, 32, 64 };
+
+typedef struct LOCKED_MAP_TAG
+{
+    MUTEX_HANDLE lock;
+    ITEM_MAP_HANDLE map;
+} LOCKED_MAP;
+
+typedef struct BENCH_CONTEXT_TAG
+{
+    const char* keys;
+    size_t key_count;
+    LOCKED_MAP* locked_map;
+    CONCURRENT_MAP_HANDLE concurrent_map;
+    THREAD_START_FUNC worker;
+    size_t thread_count;
+    size_t found;
+} BENCH_CONTEXT;
+
+typedef struct THREAD_CONTEXT_TAG
+{
+    BENCH_CONTEXT* bench;
+    uint64_t random_state;
+    size_t found;
+} THREAD_CONTEXT;
+
+// Baseline: the global lock our services wrap around item_map today
+static int locked_map_worker(void* parameter)
+{
+    THREAD_CONTEXT* context = (THREAD_CONTEXT*)parameter;
+    BENCH_CONTEXT* bench = context->bench;
+
+    for (size_t index = 0; index < OPS_PER_THREAD; index++)
+    {
+        uint64_t random_value = bench_random(&context->random_state);
+        size_t key_index = (size_t)(random_value % bench->key_count);
+        const char* key = bench->keys + (key_index*KEY_LENGTH);
+
+        (void)mutex_mgr_lock(bench->locked_map->lock);
+        if ((random_value >> 32) % UPDATE_RATIO == 0)
+        {
+            (void)item_map_remove_item(bench->locked_map->map, key);
+            (void)item_map_add_item(bench->locked_map->map, key, &key_index, sizeof(key_index));
+        }
+        else
+        {
+            const size_t* value = (const size_t*)item_map_get_item(bench->locked_map->map, key);
+            if (value != NULL && *value == key_index)
+            {
+                context->found++;
+            }
+        }
+        (void)mutex_mgr_unlock(bench->locked_map->lock);
+    }
+    return 0;
+}
+
+static int concurrent_map_worker(void* parameter)
+{
+    THREAD_CONTEXT* context = (THREAD_CONTEXT*)parameter;
+    BENCH_CONTEXT* bench = context->bench;
+
+    for (size_t index = 0; index < OPS_PER_THREAD; index++)
+    {
+        uint64_t random_value = bench_random(&context->random_state);
+        size_t key_index = (size_t)(random_value % bench->key_count);
+        const char* key = bench->keys + (key_index*KEY_LENGTH);
+
+        if ((random_value >> 32) % UPDATE_RATIO == 0)
+        {
+            (void)concurrent_map_remove_item(bench->concurrent_map, key);
+            (void)concurrent_map_add_item(bench->concurrent_map, key, &key_index, sizeof(key_index));
+        }
+        else
+        {
+            size_t value;
+            if (concurrent_map_get_item(bench->concurrent_map, key, &value, sizeof(value), NULL) == 0 && value == key_index)
+            {
+                context->found++;
+            }
+        }
+    }
+    return 0;
+}
+
+// Thread start up is inside the timing, OPS_PER_THREAD is large
+// enough that it doesn't dominate
+static void map_threads_bench(void* context, size_t ops_per_rep)
+{
+    BENCH_CONTEXT* bench = (BENCH_CONTEXT*)context;
+    THREAD_MGR_HANDLE threads[MAX_THREADS];
+    THREAD_CONTEXT contexts[MAX_THREADS];
+    (void)ops_per_rep;
+
+    for (size_t index = 0; index < bench->thread_count; index++)
+    {
+        contexts[index].bench = bench;
+        contexts[index].random_state = 0x9E3779B97F4A7C15ULL + index;
+        contexts[index].found = 0;
+        threads[index] = thread_mgr_init(bench->worker, &contexts[index]);
+    }
+    for (size_t index = 0; index < bench->thread_count; index++)
+    {
+        if (threads[index] != NULL)
+        {
+            (void)thread_mgr_join(threads[index]);
+            bench->found += contexts[index].found;
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* map_name, THREAD_START_FUNC worker, BENCH_CONTEXT* bench)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    bench->worker = worker;
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = bench->thread_count*OPS_PER_THREAD;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "%s/%zu", map_name, bench->thread_count);
+    if (bench_run(name, map_threads_bench, bench, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    BENCH_CONTEXT bench;
+    LOCKED_MAP locked_map;
+    char* keys;
+
+    memset(&bench, 0, sizeof(bench));
+    if ((keys = (char*)malloc(KEY_COUNT*KEY_LENGTH)) == NULL)
+    {
+        (void)printf("Failure allocating keys\n");
+        result = __LINE__;
+    }
+    else if (mutex_mgr_create(&locked_map.lock) != 0)
+    {
+        (void)printf("Failure creating lock\n");
+        free(keys);
+        result = __LINE__;
+    }
+    else
+    {
+        locked_map.map = item_map_create_with_options(KEY_COUNT, ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE, NULL, NULL, NULL);
+        bench.concurrent_map = concurrent_map_create(0, KEY_COUNT, NULL, NULL, NULL);
+        if (locked_map.map == NULL || bench.concurrent_map == NULL)
+        {
+            (void)printf("Failure creating maps\n");
+            result = __LINE__;
+        }
+        else if (bench_report_init(&report, "concurrent_map_bench", argc, argv) != 0)
+        {
+            (void)printf("Failure starting report\n");
+            result = __LINE__;
+        }
+        else
+        {
+            for (size_t index = 0; index < KEY_COUNT; index++)
+            {
+                char* key = keys + (index*KEY_LENGTH);
+                (void)sprintf(key, "device/%zu/telemetry", index);
+                (void)item_map_add_item(locked_map.map, key, &index, sizeof(index));
+                (void)concurrent_map_add_item(bench.concurrent_map, key, &index, sizeof(index));
+            }
+            bench.keys = keys;
+            bench.key_count = KEY_COUNT;
+            bench.locked_map = &locked_map;
+
+            for (size_t index = 0; index < sizeof(THREAD_COUNTS)/sizeof(THREAD_COUNTS[0]) && result == 0; index++)
+            {
+                bench.thread_count = THREAD_COUNTS[index];
+                if ((result = run_bench(&report, "global_lock", locked_map_worker, &bench)) == 0)
+                {
+                    result = run_bench(&report, "sharded", concurrent_map_worker, &bench);
+                }
+            }
+            // Keeps the lookups from being optimized away
+            (void)printf("found %zu\n", bench.found);
+            if (bench_report_deinit(&report) != 0 && result == 0)
+            {
+                result = __LINE__;
+            }
+        }
+        item_map_destroy(locked_map.map);
+        concurrent_map_destroy(bench.concurrent_map);
+        mutex_mgr_destroy(locked_map.lock);
+        free(keys);
+    }
+    return result;
+}
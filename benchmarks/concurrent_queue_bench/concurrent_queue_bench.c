@@ -0,0 +1,327 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/item_list.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/condition_mgr.h"
+#include "lib-util-c/thread_mgr.h"
+#include "lib-util-c/concurrent_queue.h"
+#include "bench_harness.h"
+
+#define MESSAGE_COUNT           400000
+#define RING_CAPACITY           4096
+#define MAX_THREADS             8
+#define WARMUP_REPS             1
+#define BENCH_REPS              7
+
+typedef enum QUEUE_KIND_TAG
+{
+    QUEUE_KIND_LOCKED_LIST,
+    QUEUE_KIND_MPMC_RING,
+    QUEUE_KIND_MPSC_INTRUSIVE
+} QUEUE_KIND;
+
+typedef struct THREAD_MIX_TAG
+{
+    size_t producers;
+    size_t consumers;
+} THREAD_MIX;
+
+static const THREAD_MIX THREAD_MIXES[] = { { 1, 1 }, { 4, 1 }, { 4, 4 } };
+
+typedef struct MESSAGE_TAG
+{
+    size_t value;
+    DLLIST_ENTRY entry;
+} MESSAGE;
+
+// The work queue the library offered before, an item_list guarded
+// by a mutex with a condition to wake consumers
+typedef struct LOCKED_LIST_TAG
+{
+    ITEM_LIST_HANDLE list;
+    MUTEX_HANDLE lock;
+    SIGNAL_HANDLE signal;
+} LOCKED_LIST;
+
+typedef struct QUEUE_CONTEXT_TAG
+{
+    QUEUE_KIND kind;
+    LOCKED_LIST locked_list;
+    MPMC_QUEUE_HANDLE mpmc_queue;
+    MPSC_QUEUE_HANDLE mpsc_queue;
+    MESSAGE* messages;
+    size_t producers;
+    size_t consumers;
+    size_t per_producer;
+    size_t per_consumer;
+    size_t checksum[MAX_THREADS];
+} QUEUE_CONTEXT;
+
+typedef struct THREAD_CONTEXT_TAG
+{
+    QUEUE_CONTEXT* queue_context;
+    size_t index;
+} THREAD_CONTEXT;
+
+static void locked_list_push(LOCKED_LIST* locked_list, MESSAGE* message)
+{
+    (void)mutex_mgr_lock(locked_list->lock);
+    (void)item_list_add_item(locked_list->list, message);
+    (void)condition_mgr_signal(locked_list->signal);
+    (void)mutex_mgr_unlock(locked_list->lock);
+}
+
+static MESSAGE* locked_list_pop(LOCKED_LIST* locked_list)
+{
+    MESSAGE* result;
+    (void)mutex_mgr_lock(locked_list->lock);
+    while (item_list_item_count(locked_list->list) == 0)
+    {
+        (void)condition_mgr_wait(locked_list->signal, locked_list->lock);
+    }
+    result = (MESSAGE*)item_list_get_front(locked_list->list);
+    (void)item_list_remove_item(locked_list->list, 0);
+    (void)mutex_mgr_unlock(locked_list->lock);
+    return result;
+}
+
+static int producer_thread(void* parameter)
+{
+    THREAD_CONTEXT* thread_context = (THREAD_CONTEXT*)parameter;
+    QUEUE_CONTEXT* queue_context = thread_context->queue_context;
+    MESSAGE* messages = &queue_context->messages[thread_context->index*queue_context->per_producer];
+    for (size_t index = 0; index < queue_context->per_producer; index++)
+    {
+        switch (queue_context->kind)
+        {
+            case QUEUE_KIND_LOCKED_LIST:
+                locked_list_push(&queue_context->locked_list, &messages[index]);
+                break;
+            case QUEUE_KIND_MPMC_RING:
+                // Give the consumers the core while the ring is full
+                while (mpmc_queue_push(queue_context->mpmc_queue, &messages[index]) != 0)
+                {
+                    thread_mgr_sleep(0);
+                }
+                break;
+            case QUEUE_KIND_MPSC_INTRUSIVE:
+                (void)mpsc_queue_push(queue_context->mpsc_queue, &messages[index].entry);
+                break;
+        }
+    }
+    return 0;
+}
+
+static int consumer_thread(void* parameter)
+{
+    THREAD_CONTEXT* thread_context = (THREAD_CONTEXT*)parameter;
+    QUEUE_CONTEXT* queue_context = thread_context->queue_context;
+    size_t checksum = 0;
+    for (size_t index = 0; index < queue_context->per_consumer; index++)
+    {
+        MESSAGE* message = NULL;
+        switch (queue_context->kind)
+        {
+            case QUEUE_KIND_LOCKED_LIST:
+                message = locked_list_pop(&queue_context->locked_list);
+                break;
+            case QUEUE_KIND_MPMC_RING:
+            {
+                void* item;
+                if (mpmc_queue_pop(queue_context->mpmc_queue, &item) == 0)
+                {
+                    message = (MESSAGE*)item;
+                }
+                break;
+            }
+            case QUEUE_KIND_MPSC_INTRUSIVE:
+            {
+                PDLLIST_ENTRY entry = mpsc_queue_pop(queue_context->mpsc_queue);
+                if (entry != NULL)
+                {
+                    message = LIST_CONTAINING_RECORD(entry, MESSAGE, entry);
+                }
+                break;
+            }
+        }
+        if (message != NULL)
+        {
+            checksum += message->value;
+        }
+    }
+    queue_context->checksum[thread_context->index] = checksum;
+    return 0;
+}
+
+// Thread start up is inside the timing, MESSAGE_COUNT is large
+// enough that it doesn't dominate
+static void queue_transfer_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    THREAD_MGR_HANDLE threads[MAX_THREADS*2];
+    THREAD_CONTEXT thread_contexts[MAX_THREADS*2];
+    size_t thread_count = 0;
+
+    queue_context->per_producer = ops_per_rep/queue_context->producers;
+    queue_context->per_consumer = ops_per_rep/queue_context->consumers;
+    for (size_t index = 0; index < queue_context->consumers; index++, thread_count++)
+    {
+        thread_contexts[thread_count].queue_context = queue_context;
+        thread_contexts[thread_count].index = index;
+        threads[thread_count] = thread_mgr_init(consumer_thread, &thread_contexts[thread_count]);
+    }
+    for (size_t index = 0; index < queue_context->producers; index++, thread_count++)
+    {
+        thread_contexts[thread_count].queue_context = queue_context;
+        thread_contexts[thread_count].index = index;
+        threads[thread_count] = thread_mgr_init(producer_thread, &thread_contexts[thread_count]);
+    }
+    for (size_t index = 0; index < thread_count; index++)
+    {
+        if (threads[index] != NULL)
+        {
+            (void)thread_mgr_join(threads[index]);
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* queue_name, QUEUE_CONTEXT* context)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = MESSAGE_COUNT;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "%s/%zup_%zuc", queue_name, context->producers, context->consumers);
+    if (bench_run(name, queue_transfer_bench, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int create_queues(QUEUE_CONTEXT* context)
+{
+    int result;
+    memset(context, 0, sizeof(QUEUE_CONTEXT));
+    if ((context->messages = (MESSAGE*)malloc(sizeof(MESSAGE)*MESSAGE_COUNT)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else if ((context->locked_list.list = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 0, NULL, NULL)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else if (mutex_mgr_create(&context->locked_list.lock) != 0)
+    {
+        result = __LINE__;
+    }
+    else if (condition_mgr_init(&context->locked_list.signal) != 0)
+    {
+        result = __LINE__;
+    }
+    else if ((context->mpmc_queue = mpmc_queue_create(RING_CAPACITY)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else if ((context->mpsc_queue = mpsc_queue_create()) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < MESSAGE_COUNT; index++)
+        {
+            context->messages[index].value = index;
+        }
+        result = 0;
+    }
+    return result;
+}
+
+static void destroy_queues(QUEUE_CONTEXT* context)
+{
+    mpsc_queue_destroy(context->mpsc_queue);
+    mpmc_queue_destroy(context->mpmc_queue);
+    condition_mgr_deinit(context->locked_list.signal);
+    mutex_mgr_destroy(context->locked_list.lock);
+    item_list_destroy(context->locked_list.list);
+    free(context->messages);
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    QUEUE_CONTEXT* context;
+
+    if ((context = (QUEUE_CONTEXT*)malloc(sizeof(QUEUE_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (create_queues(context) != 0)
+    {
+        (void)printf("Failure creating queues\n");
+        destroy_queues(context);
+        free(context);
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "concurrent_queue_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        destroy_queues(context);
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t checksum = 0;
+        for (size_t mix_index = 0; mix_index < sizeof(THREAD_MIXES)/sizeof(THREAD_MIXES[0]) && result == 0; mix_index++)
+        {
+            context->producers = THREAD_MIXES[mix_index].producers;
+            context->consumers = THREAD_MIXES[mix_index].consumers;
+
+            context->kind = QUEUE_KIND_LOCKED_LIST;
+            if ((result = run_bench(&report, "locked_item_list", context)) == 0)
+            {
+                context->kind = QUEUE_KIND_MPMC_RING;
+                result = run_bench(&report, "mpmc_ring", context);
+            }
+            // The intrusive queue only has a single consumer
+            if (result == 0 && context->consumers == 1)
+            {
+                context->kind = QUEUE_KIND_MPSC_INTRUSIVE;
+                result = run_bench(&report, "mpsc_intrusive", context);
+            }
+        }
+        for (size_t index = 0; index < MAX_THREADS; index++)
+        {
+            checksum += context->checksum[index];
+        }
+        // Keeps the transfers from being optimized away
+        (void)printf("checksum %zu\n", checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        destroy_queues(context);
+        free(context);
+    }
+    return result;
+}
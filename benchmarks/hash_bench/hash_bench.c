@@ -0,0 +1,237 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/hash_functions.h"
+#include "bench_harness.h"
+
+#define KEY_COUNT               1000000
+#define KEY_LENGTH              48
+#define THROUGHPUT_BYTES        (16*1024*1024)
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+// Prime bucket count for the modulo run and power of two for the mask run
+#define MODULO_BUCKETS          65521
+#define MASK_BUCKETS            65536
+#define DJB2_START_VALUE        5381
+
+typedef struct HASH_CONFIG_TAG
+{
+    const char* name;
+    uint64_t(*buffer_hash)(const void* data, size_t len);
+    uint32_t(*string_hash)(const char* key);
+} HASH_CONFIG;
+
+static const unsigned char SIPHASH_BENCH_KEY[HASH_SIPHASH_KEY_SIZE] =
+{
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+};
+
+static const size_t INPUT_LENGTHS[] = { 8, 16, 32, 64, 256, 4096 };
+
+typedef struct HASH_CONTEXT_TAG
+{
+    const HASH_CONFIG* hash_config;
+    size_t input_len;
+    unsigned char buffer[4096 + 64];
+    uint64_t sink;
+} HASH_CONTEXT;
+
+// Same djb2 loop item_map uses when no hash function is supplied
+static uint64_t djb2_buffer(const void* data, size_t len)
+{
+    const unsigned char* input = (const unsigned char*)data;
+    uint32_t result = DJB2_START_VALUE;
+    for (size_t index = 0; index < len; index++)
+    {
+        result = ((result << 5) + result) + input[index];
+    }
+    return result;
+}
+
+static uint32_t djb2_string(const char* key)
+{
+    return (uint32_t)djb2_buffer(key, strlen(key));
+}
+
+static uint64_t wyhash_buffer(const void* data, size_t len)
+{
+    return hash_wyhash(data, len, 0);
+}
+
+static uint64_t xxh3_buffer(const void* data, size_t len)
+{
+    return hash_xxh3(data, len, 0);
+}
+
+static uint64_t siphash_buffer(const void* data, size_t len)
+{
+    return hash_siphash(data, len, SIPHASH_BENCH_KEY);
+}
+
+static const HASH_CONFIG HASH_CONFIGS[] =
+{
+    { "djb2", djb2_buffer, djb2_string },
+    { "wyhash", wyhash_buffer, hash_wyhash_string },
+    { "xxh3", xxh3_buffer, hash_xxh3_string },
+    { "siphash", siphash_buffer, hash_siphash_string }
+};
+
+static int compare_hash_value(const void* lhs, const void* rhs)
+{
+    uint32_t left = *(const uint32_t*)lhs;
+    uint32_t right = *(const uint32_t*)rhs;
+    return (left > right) - (left < right);
+}
+
+// Feed each hash into the next input offset so the calls can't be hoisted
+static void throughput_bench(void* context, size_t ops_per_rep)
+{
+    HASH_CONTEXT* hash_context = (HASH_CONTEXT*)context;
+    uint64_t sink = hash_context->sink;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        sink += hash_context->hash_config->buffer_hash(hash_context->buffer + (sink & 63), hash_context->input_len);
+    }
+    hash_context->sink = sink;
+}
+
+static int run_throughput_bench(BENCH_REPORT* report, HASH_CONTEXT* context)
+{
+    int result = 0;
+    for (size_t index = 0; index < sizeof(INPUT_LENGTHS)/sizeof(INPUT_LENGTHS[0]) && result == 0; index++)
+    {
+        char name[64];
+        BENCH_CONFIG config;
+        BENCH_RESULT bench_result;
+
+        context->input_len = INPUT_LENGTHS[index];
+        config.warmup = WARMUP_REPS;
+        config.repetitions = BENCH_REPS;
+        config.ops_per_rep = THROUGHPUT_BYTES/context->input_len;
+        config.bytes_per_rep = THROUGHPUT_BYTES;
+        (void)sprintf(name, "%s/%zu", context->hash_config->name, context->input_len);
+        if (bench_run(name, throughput_bench, context, &config, &bench_result) != 0)
+        {
+            (void)printf("Failure running %s\n", name);
+            result = __LINE__;
+        }
+        else
+        {
+            bench_report_add(report, &bench_result);
+        }
+    }
+    return result;
+}
+
+// Reports the fullest bucket and the chi squared statistic divided by the
+// bucket count, a uniform hash lands close to 1.0
+static void report_distribution(const char* name, const char* mode, const uint32_t* hash_values, size_t key_count, size_t* buckets, size_t bucket_count, uint32_t mask)
+{
+    double expected = (double)key_count/bucket_count;
+    double chi_squared = 0;
+    size_t max_load = 0;
+
+    memset(buckets, 0, bucket_count*sizeof(size_t));
+    for (size_t index = 0; index < key_count; index++)
+    {
+        size_t bucket = (mask != 0) ? (hash_values[index] & mask) : (hash_values[index] % bucket_count);
+        buckets[bucket]++;
+    }
+    for (size_t index = 0; index < bucket_count; index++)
+    {
+        double diff = (double)buckets[index] - expected;
+        chi_squared += (diff*diff)/expected;
+        if (buckets[index] > max_load)
+        {
+            max_load = buckets[index];
+        }
+    }
+    (void)printf("%-10s %-8s %10zu %10.2f %10zu %12.3f", name, mode, bucket_count, expected, max_load, chi_squared/bucket_count);
+}
+
+static int run_distribution_bench(const HASH_CONFIG* config, size_t key_count)
+{
+    int result;
+    uint32_t* hash_values = (uint32_t*)malloc(key_count*sizeof(uint32_t));
+    size_t* buckets = (size_t*)malloc(MASK_BUCKETS*sizeof(size_t));
+    if (hash_values == NULL || buckets == NULL)
+    {
+        (void)printf("Failure allocating distribution buffers\n");
+        result = __LINE__;
+    }
+    else
+    {
+        char key[KEY_LENGTH];
+        for (size_t index = 0; index < key_count; index++)
+        {
+            (void)sprintf(key, "device/%zu/telemetry", index);
+            hash_values[index] = config->string_hash(key);
+        }
+
+        report_distribution(config->name, "modulo", hash_values, key_count, buckets, MODULO_BUCKETS, 0);
+        (void)printf("\n");
+        report_distribution(config->name, "mask", hash_values, key_count, buckets, MASK_BUCKETS, MASK_BUCKETS - 1);
+
+        // Full 32 bit collisions can't be fixed by any bucket count
+        size_t collisions = 0;
+        qsort(hash_values, key_count, sizeof(uint32_t), compare_hash_value);
+        for (size_t index = 1; index < key_count; index++)
+        {
+            if (hash_values[index] == hash_values[index - 1])
+            {
+                collisions++;
+            }
+        }
+        (void)printf(" %10zu\n", collisions);
+        result = 0;
+    }
+    free(hash_values);
+    free(buckets);
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    HASH_CONTEXT context;
+    uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+
+    if (bench_report_init(&report, "hash_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        result = __LINE__;
+    }
+    else
+    {
+        context.sink = 0;
+        for (size_t index = 0; index < sizeof(context.buffer); index++)
+        {
+            context.buffer[index] = (unsigned char)bench_random(&random_state);
+        }
+
+        for (size_t index = 0; index < sizeof(HASH_CONFIGS)/sizeof(HASH_CONFIGS[0]) && result == 0; index++)
+        {
+            context.hash_config = &HASH_CONFIGS[index];
+            result = run_throughput_bench(&report, &context);
+        }
+        // Keeps the hashes from being optimized away
+        (void)printf("checksum %llx\n", (unsigned long long)context.sink);
+
+        // Bucket quality is not a timing so it stays out of the report
+        (void)printf("\n%-10s %-8s %10s %10s %10s %12s %10s\n", "hash", "mode", "buckets", "expected", "max_load", "chi2_ratio", "collisions");
+        for (size_t index = 0; index < sizeof(HASH_CONFIGS)/sizeof(HASH_CONFIGS[0]) && result == 0; index++)
+        {
+            result = run_distribution_bench(&HASH_CONFIGS[index], KEY_COUNT);
+        }
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+    }
+    return result;
+}
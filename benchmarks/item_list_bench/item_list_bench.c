@@ -0,0 +1,207 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/item_list.h"
+#include "bench_harness.h"
+
+#define MAX_ITEM_COUNT          10000
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+static const size_t ITEM_COUNTS[] = { 100, 1000, 10000 };
+
+typedef struct LIST_MODE_TAG
+{
+    const char* name;
+    uint32_t options;
+} LIST_MODE;
+
+static const LIST_MODE LIST_MODES[] =
+{
+    { "linked", ITEM_LIST_OPTION_NONE },
+    { "pooled", ITEM_LIST_OPTION_NODE_POOL },
+    { "array", ITEM_LIST_OPTION_ARRAY }
+};
+
+typedef struct LIST_CONTEXT_TAG
+{
+    ITEM_LIST_HANDLE list;
+    const char* mode;
+    size_t item_count;
+    size_t items[MAX_ITEM_COUNT];
+    uint64_t random_state;
+    size_t checksum;
+} LIST_CONTEXT;
+
+static void fill_list(LIST_CONTEXT* context, size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        (void)item_list_add_item(context->list, &context->items[index]);
+    }
+}
+
+static void add_clear_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    fill_list(list_context, ops_per_rep);
+    (void)item_list_clear(list_context->list);
+}
+
+static void get_index_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        size_t item_index = (size_t)(bench_random(&list_context->random_state) % list_context->item_count);
+        list_context->checksum += *(const size_t*)item_list_get_item(list_context->list, item_index);
+    }
+}
+
+static void iterate_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    ITERATOR_HANDLE iterator = item_list_iterator(list_context->list);
+    const size_t* item;
+    (void)ops_per_rep;
+    while ((item = (const size_t*)item_list_get_next(list_context->list, &iterator)) != NULL)
+    {
+        list_context->checksum += *item;
+    }
+}
+
+// Filling is part of the timing so every repetition drains a full list
+static void remove_front_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    fill_list(list_context, ops_per_rep);
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)item_list_remove_item(list_context->list, 0);
+    }
+}
+
+// Expires every other item in a single pass, the rest are
+// cleared so every repetition starts from an empty list
+static void sweep_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    ITEM_LIST_ITERATOR iterator;
+    const size_t* item;
+    fill_list(list_context, ops_per_rep);
+    (void)item_list_iterator_init(list_context->list, &iterator);
+    while ((item = (const size_t*)item_list_iterator_next(list_context->list, &iterator)) != NULL)
+    {
+        if (*item & 1)
+        {
+            (void)item_list_iterator_remove_current(list_context->list, &iterator);
+        }
+    }
+    (void)item_list_clear(list_context->list);
+}
+
+// Queue style workload, the list stays at item_count while
+// items are pushed at the back and popped from the front
+static void push_pop_bench(void* context, size_t ops_per_rep)
+{
+    LIST_CONTEXT* list_context = (LIST_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)item_list_add_item(list_context->list, &list_context->items[index]);
+        (void)item_list_remove_item(list_context->list, 0);
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, LIST_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "item_list_%s_%s/%zu", context->mode, operation, context->item_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    LIST_CONTEXT* context;
+
+    if ((context = (LIST_CONTEXT*)malloc(sizeof(LIST_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "item_list_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        context->random_state = 0x9E3779B97F4A7C15ULL;
+        context->checksum = 0;
+        for (size_t index = 0; index < MAX_ITEM_COUNT; index++)
+        {
+            context->items[index] = index;
+        }
+
+        for (size_t mode_index = 0; mode_index < sizeof(LIST_MODES)/sizeof(LIST_MODES[0]) && result == 0; mode_index++)
+        {
+            context->mode = LIST_MODES[mode_index].name;
+            if ((context->list = item_list_create_with_options(LIST_MODES[mode_index].options, 0, NULL, NULL)) == NULL)
+            {
+                (void)printf("Failure creating item list\n");
+                result = __LINE__;
+                break;
+            }
+            for (size_t count_index = 0; count_index < sizeof(ITEM_COUNTS)/sizeof(ITEM_COUNTS[0]) && result == 0; count_index++)
+            {
+                size_t item_count = ITEM_COUNTS[count_index];
+                context->item_count = item_count;
+                if ((result = run_bench(&report, "add_clear", add_clear_bench, context, item_count)) == 0 &&
+                    (result = run_bench(&report, "remove_front", remove_front_bench, context, item_count)) == 0 &&
+                    (result = run_bench(&report, "sweep", sweep_bench, context, item_count)) == 0)
+                {
+                    fill_list(context, item_count);
+                    if ((result = run_bench(&report, "get_index", get_index_bench, context, item_count)) == 0 &&
+                        (result = run_bench(&report, "push_pop", push_pop_bench, context, item_count)) == 0)
+                    {
+                        result = run_bench(&report, "iterate", iterate_bench, context, item_count);
+                    }
+                    (void)item_list_clear(context->list);
+                }
+            }
+            item_list_destroy(context->list);
+        }
+        // Keeps the lookups from being optimized away
+        (void)printf("checksum %zu\n", context->checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context);
+    }
+    return result;
+}
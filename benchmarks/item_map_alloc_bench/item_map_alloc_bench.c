@@ -0,0 +1,151 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "lib-util-c/item_map.h"
+#include "bench_harness.h"
+
+#define KEY_COUNT               1000000
+#define KEY_LENGTH              48
+#define WARMUP_REPS             1
+#define BENCH_REPS              7
+
+typedef struct MAP_CONFIG_TAG
+{
+    const char* name;
+    uint32_t options;
+} MAP_CONFIG;
+
+static const MAP_CONFIG MAP_CONFIGS[] =
+{
+    { "chained", ITEM_MAP_OPTION_NONE },
+    { "chained_inline", ITEM_MAP_OPTION_INLINE_STORAGE },
+    { "open_addressing", ITEM_MAP_OPTION_OPEN_ADDRESSING },
+    { "open_inline", ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE }
+};
+
+typedef struct MAP_CONTEXT_TAG
+{
+    ITEM_MAP_HANDLE map;
+    char* keys;
+} MAP_CONTEXT;
+
+static void fill_map(MAP_CONTEXT* context, size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        (void)item_map_add_item(context->map, context->keys + (index*KEY_LENGTH), &index, sizeof(index));
+    }
+}
+
+// The map is sized up front so only the entry storage is measured, the
+// clear hands every entry back so each repetition allocates them again
+static void insert_clear_bench(void* context, size_t ops_per_rep)
+{
+    MAP_CONTEXT* map_context = (MAP_CONTEXT*)context;
+    fill_map(map_context, ops_per_rep);
+    (void)item_map_clear_all(map_context->map);
+}
+
+static int run_bench(BENCH_REPORT* report, const MAP_CONFIG* map_config, MAP_CONTEXT* context)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = KEY_COUNT;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "item_map_%s_insert_clear/%d", map_config->name, KEY_COUNT);
+    if (bench_run(name, insert_clear_bench, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+// Heap bytes per key for the entries alone and for the whole map,
+// zero where the platform can't report heap usage
+static int report_memory(const MAP_CONFIG* map_config, MAP_CONTEXT* context)
+{
+    int result;
+    size_t heap_start = bench_get_heap_usage();
+    if ((context->map = item_map_create_with_options(KEY_COUNT, map_config->options, NULL, NULL, NULL)) == NULL)
+    {
+        (void)printf("Failure creating item map\n");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t heap_table = bench_get_heap_usage();
+        fill_map(context, KEY_COUNT);
+        size_t heap_end = bench_get_heap_usage();
+        (void)printf("%-18s %12.1f %12.1f\n", map_config->name,
+            (double)(heap_end - heap_table)/KEY_COUNT, (double)(heap_end - heap_start)/KEY_COUNT);
+        item_map_destroy(context->map);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    MAP_CONTEXT context;
+
+    if ((context.keys = (char*)malloc(KEY_COUNT*KEY_LENGTH)) == NULL)
+    {
+        (void)printf("Failure allocating keys\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "item_map_alloc_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context.keys);
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < KEY_COUNT; index++)
+        {
+            (void)sprintf(context.keys + (index*KEY_LENGTH), "device/%zu/telemetry", index);
+        }
+
+        for (size_t index = 0; index < sizeof(MAP_CONFIGS)/sizeof(MAP_CONFIGS[0]) && result == 0; index++)
+        {
+            if ((context.map = item_map_create_with_options(KEY_COUNT, MAP_CONFIGS[index].options, NULL, NULL, NULL)) == NULL)
+            {
+                (void)printf("Failure creating item map\n");
+                result = __LINE__;
+            }
+            else
+            {
+                result = run_bench(&report, &MAP_CONFIGS[index], &context);
+                item_map_destroy(context.map);
+            }
+        }
+
+        (void)printf("\n%-18s %12s %12s\n", "map", "entry_bytes", "total_bytes");
+        for (size_t index = 0; index < sizeof(MAP_CONFIGS)/sizeof(MAP_CONFIGS[0]) && result == 0; index++)
+        {
+            result = report_memory(&MAP_CONFIGS[index], &context);
+        }
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context.keys);
+    }
+    return result;
+}
@@ -0,0 +1,223 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/item_map.h"
+#include "bench_harness.h"
+
+#define MAX_KEY_COUNT           4000000
+#define KEY_LENGTH              32
+#define LOOKUP_COUNT            2000000
+#define WARMUP_REPS             1
+#define BENCH_REPS              5
+// Keys handed to each batch call, big enough that the per call
+// overhead disappears but small enough to mirror a request batch
+#define BATCH_SIZE              256
+
+static const size_t KEY_COUNTS[] = { 1000000, 4000000 };
+
+typedef struct MAP_CONFIG_TAG
+{
+    const char* name;
+    uint32_t options;
+} MAP_CONFIG;
+
+static const MAP_CONFIG MAP_CONFIGS[] =
+{
+    { "flat_inline", ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE },
+    { "chained_pow2", ITEM_MAP_OPTION_POWER_OF_TWO }
+};
+
+typedef struct BENCH_DATA_TAG
+{
+    const MAP_CONFIG* map_config;
+    ITEM_MAP_HANDLE map;
+    const char** keys;
+    const void** values;
+    size_t* lens;
+    size_t* items;
+    const char** lookup_keys;
+    const void** results;
+    size_t key_count;
+    size_t found;
+} BENCH_DATA;
+
+static void add_single_bench(void* context, size_t ops_per_rep)
+{
+    BENCH_DATA* data = (BENCH_DATA*)context;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(ops_per_rep, data->map_config->options, NULL, NULL, NULL);
+    if (handle != NULL)
+    {
+        for (size_t index = 0; index < ops_per_rep; index++)
+        {
+            (void)item_map_add_item(handle, data->keys[index], data->values[index], data->lens[index]);
+        }
+        item_map_destroy(handle);
+    }
+}
+
+static void add_batch_bench(void* context, size_t ops_per_rep)
+{
+    BENCH_DATA* data = (BENCH_DATA*)context;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(ops_per_rep, data->map_config->options, NULL, NULL, NULL);
+    if (handle != NULL)
+    {
+        for (size_t index = 0; index < ops_per_rep; index += BATCH_SIZE)
+        {
+            size_t count = (ops_per_rep - index < BATCH_SIZE) ? ops_per_rep - index : BATCH_SIZE;
+            (void)item_map_add_batch(handle, data->keys + index, data->values + index, data->lens + index, count);
+        }
+        item_map_destroy(handle);
+    }
+}
+
+static void get_single_bench(void* context, size_t ops_per_rep)
+{
+    BENCH_DATA* data = (BENCH_DATA*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        if (item_map_get_item(data->map, data->lookup_keys[index]) != NULL)
+        {
+            data->found++;
+        }
+    }
+}
+
+static void get_batch_bench(void* context, size_t ops_per_rep)
+{
+    BENCH_DATA* data = (BENCH_DATA*)context;
+    for (size_t index = 0; index < ops_per_rep; index += BATCH_SIZE)
+    {
+        size_t count = (ops_per_rep - index < BATCH_SIZE) ? ops_per_rep - index : BATCH_SIZE;
+        data->found += item_map_get_batch(data->map, data->lookup_keys + index, count, data->results + index);
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, BENCH_DATA* data, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "item_map_%s_%s/%zu", data->map_config->name, operation, data->key_count);
+    if (bench_run(name, bench_fn, data, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_config(BENCH_REPORT* report, BENCH_DATA* data)
+{
+    int result;
+    if ((result = run_bench(report, "add_single", add_single_bench, data, data->key_count)) != 0 ||
+        (result = run_bench(report, "add_batch", add_batch_bench, data, data->key_count)) != 0)
+    {
+        (void)printf("Failure running add benches\n");
+    }
+    else if ((data->map = item_map_create_with_options(data->key_count, data->map_config->options, NULL, NULL, NULL)) == NULL)
+    {
+        (void)printf("Failure creating item map\n");
+        result = __LINE__;
+    }
+    else
+    {
+        if (item_map_add_batch(data->map, data->keys, data->values, data->lens, data->key_count) != 0)
+        {
+            (void)printf("Failure populating item map\n");
+            result = __LINE__;
+        }
+        else if ((result = run_bench(report, "get_single", get_single_bench, data, LOOKUP_COUNT)) == 0)
+        {
+            result = run_bench(report, "get_batch", get_batch_bench, data, LOOKUP_COUNT);
+        }
+        item_map_destroy(data->map);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    BENCH_DATA data;
+    char* key_buffer;
+
+    memset(&data, 0, sizeof(data));
+    key_buffer = (char*)malloc(MAX_KEY_COUNT*KEY_LENGTH);
+    data.keys = (const char**)malloc(MAX_KEY_COUNT*sizeof(const char*));
+    data.values = (const void**)malloc(MAX_KEY_COUNT*sizeof(const void*));
+    data.lens = (size_t*)malloc(MAX_KEY_COUNT*sizeof(size_t));
+    data.items = (size_t*)malloc(MAX_KEY_COUNT*sizeof(size_t));
+    data.lookup_keys = (const char**)malloc(LOOKUP_COUNT*sizeof(const char*));
+    data.results = (const void**)malloc(LOOKUP_COUNT*sizeof(const void*));
+    if (key_buffer == NULL || data.keys == NULL || data.values == NULL || data.lens == NULL ||
+        data.items == NULL || data.lookup_keys == NULL || data.results == NULL)
+    {
+        (void)printf("Failure allocating bench buffers\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "item_map_batch_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < MAX_KEY_COUNT; index++)
+        {
+            char* key = key_buffer + (index*KEY_LENGTH);
+            (void)sprintf(key, "device/%zu/telemetry", index);
+            data.keys[index] = key;
+            data.items[index] = index;
+            data.values[index] = &data.items[index];
+            data.lens[index] = sizeof(size_t);
+        }
+
+        for (size_t count_index = 0; count_index < sizeof(KEY_COUNTS)/sizeof(KEY_COUNTS[0]) && result == 0; count_index++)
+        {
+            uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+            data.key_count = KEY_COUNTS[count_index];
+
+            // Random order so every lookup is a likely cache miss, which is
+            // the case the prefetching is meant to hide
+            for (size_t index = 0; index < LOOKUP_COUNT; index++)
+            {
+                data.lookup_keys[index] = data.keys[bench_random(&random_state) % data.key_count];
+            }
+            for (size_t config_index = 0; config_index < sizeof(MAP_CONFIGS)/sizeof(MAP_CONFIGS[0]) && result == 0; config_index++)
+            {
+                data.map_config = &MAP_CONFIGS[config_index];
+                result = run_config(&report, &data);
+            }
+        }
+        // Every lookup hits, keeps them from being optimized away
+        (void)printf("found %zu\n", data.found);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+    }
+    free(key_buffer);
+    free((void*)data.keys);
+    free((void*)data.values);
+    free(data.lens);
+    free(data.items);
+    free((void*)data.lookup_keys);
+    free((void*)data.results);
+    return result;
+}
@@ -0,0 +1,171 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include "lib-util-c/item_map.h"
+#include "bench_harness.h"
+
+#define MAX_KEY_COUNT           1000000
+// The chained map is created with a guessed size so the chains grow
+// with the key count, past this point the inserts alone take minutes
+#define CHAINED_MAX_KEYS        100000
+#define INITIAL_MAP_SIZE        1024
+#define GET_OPS                 200000
+#define KEY_LENGTH              48
+#define WARMUP_REPS             1
+#define BENCH_REPS              7
+
+static const size_t KEY_COUNTS[] = { 10000, 100000, 1000000 };
+
+typedef struct MAP_CONTEXT_TAG
+{
+    ITEM_MAP_HANDLE map;
+    const char* map_name;
+    uint32_t options;
+    size_t key_count;
+    char* keys;
+    const char** lookup_keys;
+    size_t checksum;
+} MAP_CONTEXT;
+
+static void fill_map(MAP_CONTEXT* context, size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        (void)item_map_add_item(context->map, context->keys + (index*KEY_LENGTH), &index, sizeof(index));
+    }
+}
+
+// Starts from INITIAL_MAP_SIZE so the growth is part of the timing
+static void build_destroy_bench(void* context, size_t ops_per_rep)
+{
+    MAP_CONTEXT* map_context = (MAP_CONTEXT*)context;
+    ITEM_MAP_HANDLE map = map_context->map;
+    if ((map_context->map = item_map_create_with_options(INITIAL_MAP_SIZE, map_context->options, NULL, NULL, NULL)) != NULL)
+    {
+        fill_map(map_context, ops_per_rep);
+        item_map_destroy(map_context->map);
+    }
+    map_context->map = map;
+}
+
+// The lookup keys are drawn at random up front, every one of them hits
+static void get_bench(void* context, size_t ops_per_rep)
+{
+    MAP_CONTEXT* map_context = (MAP_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        const size_t* value = (const size_t*)item_map_get_item(map_context->map, map_context->lookup_keys[index]);
+        if (value != NULL)
+        {
+            map_context->checksum += *value;
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, MAP_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "item_map_%s_%s/%zu", context->map_name, operation, context->key_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_map_benches(BENCH_REPORT* report, MAP_CONTEXT* context)
+{
+    int result;
+    if ((context->map = item_map_create_with_options(INITIAL_MAP_SIZE, context->options, NULL, NULL, NULL)) == NULL)
+    {
+        (void)printf("Failure creating item map\n");
+        result = __LINE__;
+    }
+    else
+    {
+        if ((result = run_bench(report, "build_destroy", build_destroy_bench, context, context->key_count)) == 0)
+        {
+            fill_map(context, context->key_count);
+            result = run_bench(report, "get", get_bench, context, GET_OPS);
+        }
+        item_map_destroy(context->map);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    MAP_CONTEXT context;
+
+    context.checksum = 0;
+    context.keys = (char*)malloc(MAX_KEY_COUNT*KEY_LENGTH);
+    context.lookup_keys = (const char**)malloc(GET_OPS*sizeof(const char*));
+    if (context.keys == NULL || context.lookup_keys == NULL)
+    {
+        (void)printf("Failure allocating bench buffers\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "item_map_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < MAX_KEY_COUNT; index++)
+        {
+            (void)sprintf(context.keys + (index*KEY_LENGTH), "device/%zu/telemetry", index);
+        }
+
+        for (size_t count_index = 0; count_index < sizeof(KEY_COUNTS)/sizeof(KEY_COUNTS[0]) && result == 0; count_index++)
+        {
+            uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+            context.key_count = KEY_COUNTS[count_index];
+            for (size_t index = 0; index < GET_OPS; index++)
+            {
+                context.lookup_keys[index] = context.keys + ((bench_random(&random_state) % context.key_count)*KEY_LENGTH);
+            }
+
+            if (context.key_count <= CHAINED_MAX_KEYS)
+            {
+                context.map_name = "chained";
+                context.options = ITEM_MAP_OPTION_NONE;
+                result = run_map_benches(&report, &context);
+            }
+            if (result == 0)
+            {
+                context.map_name = "open_addressing";
+                context.options = ITEM_MAP_OPTION_OPEN_ADDRESSING;
+                result = run_map_benches(&report, &context);
+            }
+        }
+        // Keeps the lookups from being optimized away
+        (void)printf("checksum %zu\n", context.checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+    }
+    free(context.keys);
+    free((void*)context.lookup_keys);
+    return result;
+}
@@ -0,0 +1,244 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/item_list.h"
+#include "lib-util-c/priority_queue.h"
+#include "bench_harness.h"
+
+#define MAX_PENDING_COUNT       400000
+#define LIST_OPS_PER_REP        200
+#define DEADLINE_RANGE          0xFFFFFF
+#define WARMUP_REPS             2
+#define BENCH_REPS              7
+
+static const size_t PENDING_COUNTS[] = { 100000, 400000 };
+
+// A scheduled task, the deadline is its priority
+typedef struct TIMER_ITEM_TAG
+{
+    uint64_t deadline;
+    PRIORITY_QUEUE_ENTRY_HANDLE entry;
+} TIMER_ITEM;
+
+typedef struct QUEUE_CONTEXT_TAG
+{
+    PRIORITY_QUEUE_HANDLE queue;
+    ITEM_LIST_HANDLE list;
+    size_t pending_count;
+    uint64_t random_state;
+    uint64_t checksum;
+    TIMER_ITEM items[MAX_PENDING_COUNT];
+    void* item_ptrs[MAX_PENDING_COUNT];
+    uint64_t deadlines[MAX_PENDING_COUNT];
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[MAX_PENDING_COUNT];
+} QUEUE_CONTEXT;
+
+static void reset_deadlines(QUEUE_CONTEXT* context)
+{
+    for (size_t index = 0; index < context->pending_count; index++)
+    {
+        context->deadlines[index] = context->items[index].deadline = bench_random(&context->random_state) & DEADLINE_RANGE;
+        context->item_ptrs[index] = &context->items[index];
+    }
+}
+
+// Loads the pending items one push at a time
+static void push_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    PRIORITY_QUEUE_HANDLE queue = priority_queue_create(0, NULL, NULL);
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)priority_queue_push(queue, queue_context->deadlines[index], queue_context->item_ptrs[index], NULL);
+    }
+    priority_queue_destroy(queue);
+}
+
+// Loads the same items with one bulk heapify
+static void heapify_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    PRIORITY_QUEUE_HANDLE queue = priority_queue_create(0, NULL, NULL);
+    (void)priority_queue_heapify(queue, queue_context->deadlines, queue_context->item_ptrs, ops_per_rep, NULL);
+    priority_queue_destroy(queue);
+}
+
+// Scheduler hold model, the earliest task runs and is rescheduled
+// later so the queue stays at pending_count
+static void heap_hold_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        void* item;
+        uint64_t deadline;
+        if (priority_queue_pop(queue_context->queue, &item, &deadline) == 0)
+        {
+            TIMER_ITEM* timer = (TIMER_ITEM*)item;
+            timer->deadline = deadline + (bench_random(&queue_context->random_state) & DEADLINE_RANGE);
+            (void)priority_queue_push(queue_context->queue, timer->deadline, timer, &timer->entry);
+            queue_context->checksum += deadline;
+        }
+    }
+}
+
+// Pulls random tasks forward, the heap keeps the handle up to date
+static void decrease_key_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        TIMER_ITEM* timer = &queue_context->items[bench_random(&queue_context->random_state) % queue_context->pending_count];
+        timer->deadline -= timer->deadline >> 4;
+        (void)priority_queue_decrease_key(queue_context->queue, timer->entry, timer->deadline);
+    }
+}
+
+// The hold model on an item_list, every run has to find the earliest
+// task by scanning, the same O(n) a sorted insert pays
+static void list_hold_bench(void* context, size_t ops_per_rep)
+{
+    QUEUE_CONTEXT* queue_context = (QUEUE_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        ITEM_LIST_ITERATOR iterator;
+        const TIMER_ITEM* item;
+        TIMER_ITEM* earliest = NULL;
+        size_t earliest_index = 0;
+        (void)item_list_iterator_init(queue_context->list, &iterator);
+        while ((item = (const TIMER_ITEM*)item_list_iterator_next(queue_context->list, &iterator)) != NULL)
+        {
+            if (earliest == NULL || item->deadline < earliest->deadline)
+            {
+                earliest = (TIMER_ITEM*)item;
+                earliest_index = iterator.index;
+            }
+        }
+        if (earliest != NULL)
+        {
+            queue_context->checksum += earliest->deadline;
+            (void)item_list_remove_item(queue_context->list, earliest_index);
+            earliest->deadline += bench_random(&queue_context->random_state) & DEADLINE_RANGE;
+            (void)item_list_add_item(queue_context->list, earliest);
+        }
+    }
+}
+
+static int run_bench(BENCH_REPORT* report, const char* operation, BENCH_FUNCTION bench_fn, QUEUE_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    char name[64];
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    (void)sprintf(name, "%s/%zu", operation, context->pending_count);
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+static int run_heap_benches(BENCH_REPORT* report, QUEUE_CONTEXT* context)
+{
+    int result;
+    reset_deadlines(context);
+    if ((result = run_bench(report, "heap_push", push_bench, context, context->pending_count)) == 0 &&
+        (result = run_bench(report, "heap_heapify", heapify_bench, context, context->pending_count)) == 0)
+    {
+        if ((context->queue = priority_queue_create(context->pending_count, NULL, NULL)) == NULL ||
+            priority_queue_heapify(context->queue, context->deadlines, context->item_ptrs, context->pending_count, context->entries) != 0)
+        {
+            (void)printf("Failure loading priority queue\n");
+            result = __LINE__;
+        }
+        else
+        {
+            for (size_t index = 0; index < context->pending_count; index++)
+            {
+                context->items[index].entry = context->entries[index];
+            }
+            if ((result = run_bench(report, "heap_hold", heap_hold_bench, context, context->pending_count)) == 0)
+            {
+                result = run_bench(report, "heap_decrease_key", decrease_key_bench, context, context->pending_count);
+            }
+        }
+        priority_queue_destroy(context->queue);
+    }
+    return result;
+}
+
+static int run_list_benches(BENCH_REPORT* report, QUEUE_CONTEXT* context)
+{
+    int result;
+    reset_deadlines(context);
+    if ((context->list = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, context->pending_count, NULL, NULL)) == NULL)
+    {
+        (void)printf("Failure creating item list\n");
+        result = __LINE__;
+    }
+    else
+    {
+        for (size_t index = 0; index < context->pending_count; index++)
+        {
+            (void)item_list_add_item(context->list, &context->items[index]);
+        }
+        result = run_bench(report, "item_list_hold", list_hold_bench, context, LIST_OPS_PER_REP);
+        item_list_destroy(context->list);
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    QUEUE_CONTEXT* context;
+
+    if ((context = (QUEUE_CONTEXT*)malloc(sizeof(QUEUE_CONTEXT))) == NULL)
+    {
+        (void)printf("Failure allocating bench context\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "priority_queue_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(context);
+        result = __LINE__;
+    }
+    else
+    {
+        context->random_state = 0x9E3779B97F4A7C15ULL;
+        context->checksum = 0;
+        for (size_t count_index = 0; count_index < sizeof(PENDING_COUNTS)/sizeof(PENDING_COUNTS[0]) && result == 0; count_index++)
+        {
+            context->pending_count = PENDING_COUNTS[count_index];
+            if ((result = run_heap_benches(&report, context)) == 0)
+            {
+                result = run_list_benches(&report, context);
+            }
+        }
+        // Keeps the pops from being optimized away
+        (void)printf("checksum %llu\n", (unsigned long long)context->checksum);
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(context);
+    }
+    return result;
+}
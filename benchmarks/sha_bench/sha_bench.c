@@ -0,0 +1,115 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sha_algorithms.h"
+#include "lib-util-c/sha256_impl.h"
+#include "lib-util-c/sha512_impl.h"
+#include "bench_harness.h"
+
+#define MAX_MESSAGE_SIZE        (64*1024)
+#define BYTES_PER_REP           (1024*1024)
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+typedef struct SHA_CONFIG_TAG
+{
+    const char* name;
+    const SHA_HASH_INTERFACE*(*get_interface)(void);
+    size_t digest_size;
+} SHA_CONFIG;
+
+static const SHA_CONFIG SHA_CONFIGS[] =
+{
+    { "sha256", sha256_get_interface, SHA256_HASH_SIZE },
+    { "sha512", sha512_get_interface, SHA512_HASH_SIZE }
+};
+
+static const size_t MESSAGE_SIZES[] = { 64, 1024, 16*1024, 64*1024 };
+
+typedef struct SHA_CONTEXT_TAG
+{
+    const SHA_CONFIG* config;
+    const uint8_t* message;
+    size_t message_size;
+    uint8_t digest[SHA512_HASH_SIZE];
+} SHA_CONTEXT;
+
+// Each op is a complete digest the way callers use the api, context
+// setup included, so small messages show the fixed cost
+static void sha_digest_bench(void* context, size_t ops_per_rep)
+{
+    SHA_CONTEXT* sha_context = (SHA_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        SHA_CTX_HANDLE handle = sha_algorithms_init(sha_context->config->get_interface());
+        (void)sha_algorithms_process(handle, sha_context->message, sha_context->message_size, sha_context->digest, sha_context->config->digest_size);
+        sha_algorithms_deinit(handle);
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    uint8_t* message;
+
+    if ((message = (uint8_t*)malloc(MAX_MESSAGE_SIZE)) == NULL)
+    {
+        (void)printf("Failure allocating message\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "sha_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        free(message);
+        result = __LINE__;
+    }
+    else
+    {
+        uint64_t random_state = 0x9E3779B97F4A7C15ULL;
+        for (size_t index = 0; index < MAX_MESSAGE_SIZE; index++)
+        {
+            message[index] = (uint8_t)bench_random(&random_state);
+        }
+
+        for (size_t config_index = 0; config_index < sizeof(SHA_CONFIGS)/sizeof(SHA_CONFIGS[0]) && result == 0; config_index++)
+        {
+            for (size_t size_index = 0; size_index < sizeof(MESSAGE_SIZES)/sizeof(MESSAGE_SIZES[0]) && result == 0; size_index++)
+            {
+                char name[64];
+                SHA_CONTEXT context;
+                BENCH_CONFIG config;
+                BENCH_RESULT bench_result;
+
+                context.config = &SHA_CONFIGS[config_index];
+                context.message = message;
+                context.message_size = MESSAGE_SIZES[size_index];
+                config.warmup = WARMUP_REPS;
+                config.repetitions = BENCH_REPS;
+                config.ops_per_rep = BYTES_PER_REP/MESSAGE_SIZES[size_index];
+                config.bytes_per_rep = config.ops_per_rep*MESSAGE_SIZES[size_index];
+
+                (void)sprintf(name, "%s/%zu", SHA_CONFIGS[config_index].name, MESSAGE_SIZES[size_index]);
+                if (bench_run(name, sha_digest_bench, &context, &config, &bench_result) != 0)
+                {
+                    (void)printf("Failure running %s\n", name);
+                    result = __LINE__;
+                }
+                else
+                {
+                    bench_report_add(&report, &bench_result);
+                }
+            }
+        }
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        free(message);
+    }
+    return result;
+}
@@ -0,0 +1,198 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/thread_mgr.h"
+#include "lib-util-c/atomic_operations.h"
+#include "bench_harness.h"
+
+#define UNCONTENDED_OPS         1000000
+#define THREAD_CREATE_OPS       200
+#define CONTENDED_OPS           200000
+#define MAX_THREADS             8
+#define WARMUP_REPS             2
+#define BENCH_REPS              15
+
+static const size_t CONTENDED_THREADS[] = { 2, 4, 8 };
+
+typedef struct PAL_CONTEXT_TAG
+{
+    MUTEX_HANDLE lock;
+    long counter;
+    int64_t counter64;
+    size_t thread_count;
+    size_t ops_per_thread;
+} PAL_CONTEXT;
+
+static void mutex_uncontended_bench(void* context, size_t ops_per_rep)
+{
+    PAL_CONTEXT* pal_context = (PAL_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)mutex_mgr_lock(pal_context->lock);
+        pal_context->counter++;
+        (void)mutex_mgr_unlock(pal_context->lock);
+    }
+}
+
+static void atomic_increment_bench(void* context, size_t ops_per_rep)
+{
+    PAL_CONTEXT* pal_context = (PAL_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)atomic_increment(&pal_context->counter);
+    }
+}
+
+static void atomic_increment64_bench(void* context, size_t ops_per_rep)
+{
+    PAL_CONTEXT* pal_context = (PAL_CONTEXT*)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        (void)atomic_increment64(&pal_context->counter64);
+    }
+}
+
+static int empty_thread(void* parameter)
+{
+    (void)parameter;
+    return 0;
+}
+
+static void thread_create_join_bench(void* context, size_t ops_per_rep)
+{
+    (void)context;
+    for (size_t index = 0; index < ops_per_rep; index++)
+    {
+        THREAD_MGR_HANDLE thread = thread_mgr_init(empty_thread, NULL);
+        if (thread != NULL)
+        {
+            (void)thread_mgr_join(thread);
+        }
+    }
+}
+
+static int mutex_contended_worker(void* parameter)
+{
+    PAL_CONTEXT* pal_context = (PAL_CONTEXT*)parameter;
+    for (size_t index = 0; index < pal_context->ops_per_thread; index++)
+    {
+        (void)mutex_mgr_lock(pal_context->lock);
+        pal_context->counter++;
+        (void)mutex_mgr_unlock(pal_context->lock);
+    }
+    return 0;
+}
+
+static int atomic_contended_worker(void* parameter)
+{
+    PAL_CONTEXT* pal_context = (PAL_CONTEXT*)parameter;
+    for (size_t index = 0; index < pal_context->ops_per_thread; index++)
+    {
+        (void)atomic_increment(&pal_context->counter);
+    }
+    return 0;
+}
+
+// Thread start up is inside the timing, CONTENDED_OPS is large
+// enough per thread that it doesn't dominate
+static void run_contended(PAL_CONTEXT* pal_context, THREAD_START_FUNC worker, size_t ops_per_rep)
+{
+    THREAD_MGR_HANDLE threads[MAX_THREADS];
+    pal_context->ops_per_thread = ops_per_rep/pal_context->thread_count;
+    for (size_t index = 0; index < pal_context->thread_count; index++)
+    {
+        threads[index] = thread_mgr_init(worker, pal_context);
+    }
+    for (size_t index = 0; index < pal_context->thread_count; index++)
+    {
+        if (threads[index] != NULL)
+        {
+            (void)thread_mgr_join(threads[index]);
+        }
+    }
+}
+
+static void mutex_contended_bench(void* context, size_t ops_per_rep)
+{
+    run_contended((PAL_CONTEXT*)context, mutex_contended_worker, ops_per_rep);
+}
+
+static void atomic_contended_bench(void* context, size_t ops_per_rep)
+{
+    run_contended((PAL_CONTEXT*)context, atomic_contended_worker, ops_per_rep);
+}
+
+static int run_bench(BENCH_REPORT* report, const char* name, BENCH_FUNCTION bench_fn, PAL_CONTEXT* context, size_t ops_per_rep)
+{
+    int result;
+    BENCH_CONFIG config;
+    BENCH_RESULT bench_result;
+
+    config.warmup = WARMUP_REPS;
+    config.repetitions = BENCH_REPS;
+    config.ops_per_rep = ops_per_rep;
+    config.bytes_per_rep = 0;
+    if (bench_run(name, bench_fn, context, &config, &bench_result) != 0)
+    {
+        (void)printf("Failure running %s\n", name);
+        result = __LINE__;
+    }
+    else
+    {
+        bench_report_add(report, &bench_result);
+        result = 0;
+    }
+    return result;
+}
+
+int main(int argc, char* argv[])
+{
+    int result = 0;
+    BENCH_REPORT report;
+    PAL_CONTEXT context;
+
+    memset(&context, 0, sizeof(context));
+    if (mutex_mgr_create(&context.lock) != 0)
+    {
+        (void)printf("Failure creating mutex\n");
+        result = __LINE__;
+    }
+    else if (bench_report_init(&report, "thread_pal_bench", argc, argv) != 0)
+    {
+        (void)printf("Failure starting report\n");
+        mutex_mgr_destroy(context.lock);
+        result = __LINE__;
+    }
+    else
+    {
+        if ((result = run_bench(&report, "mutex_lock_unlock", mutex_uncontended_bench, &context, UNCONTENDED_OPS)) == 0 &&
+            (result = run_bench(&report, "atomic_increment", atomic_increment_bench, &context, UNCONTENDED_OPS)) == 0 &&
+            (result = run_bench(&report, "atomic_increment64", atomic_increment64_bench, &context, UNCONTENDED_OPS)) == 0)
+        {
+            result = run_bench(&report, "thread_create_join", thread_create_join_bench, &context, THREAD_CREATE_OPS);
+        }
+
+        for (size_t thread_index = 0; thread_index < sizeof(CONTENDED_THREADS)/sizeof(CONTENDED_THREADS[0]) && result == 0; thread_index++)
+        {
+            char name[64];
+            context.thread_count = CONTENDED_THREADS[thread_index];
+            (void)sprintf(name, "mutex_contended/%zu", context.thread_count);
+            if ((result = run_bench(&report, name, mutex_contended_bench, &context, CONTENDED_OPS)) == 0)
+            {
+                (void)sprintf(name, "atomic_contended/%zu", context.thread_count);
+                result = run_bench(&report, name, atomic_contended_bench, &context, CONTENDED_OPS);
+            }
+        }
+        if (bench_report_deinit(&report) != 0 && result == 0)
+        {
+            result = __LINE__;
+        }
+        mutex_mgr_destroy(context.lock);
+    }
+    return result;
+}
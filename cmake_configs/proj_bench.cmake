@@ -0,0 +1,26 @@
+#Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+function(add_benchmark_directory bench_directory)
+    if (${lib_util_c_bench})
+        add_subdirectory(${bench_directory})
+    endif()
+endfunction()
+
+function(build_bench_project whatIsBuilding folder)
+    add_executable(${whatIsBuilding}_exe
+        ${${whatIsBuilding}_bench_files}
+        ${${whatIsBuilding}_h_files}
+    )
+    compileTargetAsC99(${whatIsBuilding}_exe)
+    addCompileSettings(${whatIsBuilding}_exe)
+
+    set_target_properties(${whatIsBuilding}_exe
+               PROPERTIES
+               FOLDER ${folder})
+
+    target_link_libraries(${whatIsBuilding}_exe lib-util-c bench_harness)
+    if (WIN32)
+    else()
+        target_link_libraries(${whatIsBuilding}_exe m)
+    endif()
+endfunction()
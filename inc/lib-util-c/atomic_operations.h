@@ -7,6 +7,7 @@ extern "C" {
 #include <cstdint>
 #else
 #include <stdint.h>
+#include <stdbool.h>
 #endif
 
 #include "macro_utils/macro_utils.h"
@@ -19,6 +20,17 @@ MOCKABLE_FUNCTION(, int64_t, atomic_decrement64, int64_t*, value);
 MOCKABLE_FUNCTION(, long, atomic_add, long*, operand, long, value);
 MOCKABLE_FUNCTION(, long, atomic_subtract, long*, operand, long, value);
 
+// The load, store, exchange and compare operations below are sequentially
+// consistent so they can publish data written before them to other threads
+MOCKABLE_FUNCTION(, int64_t, atomic_load64, int64_t*, value);
+MOCKABLE_FUNCTION(, void, atomic_store64, int64_t*, value, int64_t, new_value);
+// Stores desired when the value equals expected, returns true when stored
+MOCKABLE_FUNCTION(, bool, atomic_compare_exchange64, int64_t*, value, int64_t, expected, int64_t, desired);
+MOCKABLE_FUNCTION(, void*, atomic_load_ptr, void**, value);
+MOCKABLE_FUNCTION(, void, atomic_store_ptr, void**, value, void*, new_value);
+// Returns the pointer that was replaced
+MOCKABLE_FUNCTION(, void*, atomic_exchange_ptr, void**, value, void*, new_value);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,75 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+extern "C" {
+#else
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+// Intrusive AVL tree, the AVL_TREE_ENTRY lives inside the caller's record
+// the same way a DLLIST_ENTRY does, so insert and remove never allocate.
+// AVL_TREE_CONTAINING_RECORD gets from an entry back to its record.
+#define AVL_TREE_CONTAINING_RECORD(address, type, field) ((type *)((uintptr_t)(address) - offsetof(type,field)))
+
+typedef struct AVL_TREE_ENTRY_TAG
+{
+    struct AVL_TREE_ENTRY_TAG* parent;
+    struct AVL_TREE_ENTRY_TAG* left;
+    struct AVL_TREE_ENTRY_TAG* right;
+    size_t height;
+} AVL_TREE_ENTRY, *PAVL_TREE_ENTRY;
+
+// Orders the records holding two entries, returns < 0, 0 or > 0 like strcmp
+typedef int(*AVL_TREE_COMPARE)(const AVL_TREE_ENTRY* entry_1, const AVL_TREE_ENTRY* entry_2);
+
+typedef struct AVL_TREE_ROOT_TAG
+{
+    PAVL_TREE_ENTRY root_entry;
+    AVL_TREE_COMPARE compare_cb;
+    size_t entry_count;
+} AVL_TREE_ROOT, *PAVL_TREE_ROOT;
+
+MOCKABLE_FUNCTION(, void, avl_tree_init, PAVL_TREE_ROOT, tree_root, AVL_TREE_COMPARE, compare_cb);
+MOCKABLE_FUNCTION(, bool, avl_tree_is_empty, const AVL_TREE_ROOT*, tree_root);
+MOCKABLE_FUNCTION(, size_t, avl_tree_count, const AVL_TREE_ROOT*, tree_root);
+MOCKABLE_FUNCTION(, size_t, avl_tree_height, const AVL_TREE_ROOT*, tree_root);
+
+// Links entry into the tree, fails without touching the tree when an
+// entry comparing equal is already there
+MOCKABLE_FUNCTION(, int, avl_tree_insert, PAVL_TREE_ROOT, tree_root, PAVL_TREE_ENTRY, entry);
+// Unlinks an entry that is in the tree, no search is needed
+MOCKABLE_FUNCTION(, void, avl_tree_remove_entry, PAVL_TREE_ROOT, tree_root, PAVL_TREE_ENTRY, entry);
+
+// For containers that search with their own keys: links entry into the
+// empty slot link below parent_entry, either &parent_entry->left,
+// &parent_entry->right or &tree_root->root_entry, then rebalances
+MOCKABLE_FUNCTION(, void, avl_tree_link_entry, PAVL_TREE_ROOT, tree_root, PAVL_TREE_ENTRY, parent_entry, PAVL_TREE_ENTRY*, link, PAVL_TREE_ENTRY, entry);
+// Refreshes the height of an entry whose subtrees are balanced and rotates
+// it if needed, returns the entry now at the top of the subtree for the
+// caller to store wherever entry was linked
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_rebalance_entry, PAVL_TREE_ENTRY, entry);
+
+// Lookups take an entry embedded in a record holding the search key,
+// usually a local on the caller's stack
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_find, const AVL_TREE_ROOT*, tree_root, const AVL_TREE_ENTRY*, key_entry);
+// The first entry that does not order before key_entry
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_lower_bound, const AVL_TREE_ROOT*, tree_root, const AVL_TREE_ENTRY*, key_entry);
+
+// In order walks, NULL past either end
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_first, const AVL_TREE_ROOT*, tree_root);
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_last, const AVL_TREE_ROOT*, tree_root);
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_next, const AVL_TREE_ENTRY*, entry);
+MOCKABLE_FUNCTION(, PAVL_TREE_ENTRY, avl_tree_prev, const AVL_TREE_ENTRY*, entry);
+
+#ifdef __cplusplus
+}
+#endif
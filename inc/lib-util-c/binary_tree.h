@@ -4,10 +4,12 @@
 
 #ifdef __cplusplus
 #include <cstdio>
+#include <cstdint>
 extern "C" {
 #else // __cplusplus
 #include <stdio.h>
 #include <stddef.h>
+#include <stdint.h>
 #endif // __cplusplus
 
 #include "macro_utils/macro_utils.h"
@@ -17,16 +19,66 @@ typedef struct BINARY_TREE_INFO_TAG* BINARY_TREE_HANDLE;
 
 typedef void (*tree_remove_callback)(void* data);
 
-// Used as the type value
-typedef unsigned char NODE_KEY;
+// Used as the type value, wide enough for timestamps and 64 bit ids
+typedef uint64_t NODE_KEY;
 
+// Orders user keys, returns < 0, 0 or > 0 like strcmp
+typedef int (*BINARY_TREE_COMPARE)(const void* key_1, const void* key_2);
+
+// Called for each item of a range in key order, return non-zero to stop
+// the walk.  The tree must not be changed from inside the callback
+typedef int (*BINARY_TREE_VISIT)(void* user_ctx, void* data);
+
+// Position in an in order walk, lives on the caller's stack and follows
+// the parent links so walking needs no allocation.  Any insert or remove
+// invalidates it
+typedef struct BINARY_TREE_ITERATOR_TAG
+{
+    void* node;
+} BINARY_TREE_ITERATOR;
+
+// Options passed to binary_tree_create_with_options
+#define BINARY_TREE_OPTION_NONE         0x00
+// Carve nodes from per tree slabs and recycle removed nodes instead of
+// returning them to the heap.  Nodes built together sit together, and
+// destroy releases the slabs without visiting each node
+#define BINARY_TREE_OPTION_NODE_POOL    0x01
+
+// Creates a tree keyed by NODE_KEY values
 MOCKABLE_FUNCTION(, BINARY_TREE_HANDLE, binary_tree_create);
+// Creates a tree keyed by user keys ordered with compare_cb.  The tree
+// stores the key pointer so the key must live as long as its item,
+// usually the key is part of the data
+MOCKABLE_FUNCTION(, BINARY_TREE_HANDLE, binary_tree_create_with_compare, BINARY_TREE_COMPARE, compare_cb);
+// capacity is the number of nodes to preallocate for the node pool, 0
+// allocates on the first insert.  compare_cb is NULL for NODE_KEY values
+MOCKABLE_FUNCTION(, BINARY_TREE_HANDLE, binary_tree_create_with_options, uint32_t, options, size_t, capacity, BINARY_TREE_COMPARE, compare_cb);
 MOCKABLE_FUNCTION(, void, binary_tree_destroy, BINARY_TREE_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, int, binary_tree_insert, BINARY_TREE_HANDLE, handle, NODE_KEY, value, void*, data);
 MOCKABLE_FUNCTION(, int, binary_tree_remove, BINARY_TREE_HANDLE, handle, NODE_KEY, value, tree_remove_callback, remove_callback);
 MOCKABLE_FUNCTION(, void*, binary_tree_find, BINARY_TREE_HANDLE, handle, NODE_KEY, find_value);
 
+// The user key versions for trees made with binary_tree_create_with_compare
+MOCKABLE_FUNCTION(, int, binary_tree_insert_key, BINARY_TREE_HANDLE, handle, const void*, key, void*, data);
+MOCKABLE_FUNCTION(, int, binary_tree_remove_key, BINARY_TREE_HANDLE, handle, const void*, key, tree_remove_callback, remove_callback);
+MOCKABLE_FUNCTION(, void*, binary_tree_find_key, BINARY_TREE_HANDLE, handle, const void*, key);
+
+// Positions the iterator at the smallest key
+MOCKABLE_FUNCTION(, int, binary_tree_iterator_init, BINARY_TREE_HANDLE, handle, BINARY_TREE_ITERATOR*, iterator);
+// Positions the iterator at the first key >= value, O(log n)
+MOCKABLE_FUNCTION(, int, binary_tree_lower_bound, BINARY_TREE_HANDLE, handle, NODE_KEY, value, BINARY_TREE_ITERATOR*, iterator);
+MOCKABLE_FUNCTION(, int, binary_tree_lower_bound_key, BINARY_TREE_HANDLE, handle, const void*, key, BINARY_TREE_ITERATOR*, iterator);
+// Returns the data at the iterator and moves it to the next larger key,
+// or NULL once every item has been visited.  value is optional
+MOCKABLE_FUNCTION(, void*, binary_tree_iterator_next, BINARY_TREE_HANDLE, handle, BINARY_TREE_ITERATOR*, iterator, NODE_KEY*, value);
+MOCKABLE_FUNCTION(, void*, binary_tree_iterator_next_key, BINARY_TREE_HANDLE, handle, BINARY_TREE_ITERATOR*, iterator, const void**, key);
+
+// Calls visit_cb for every item with start <= key < end in key order,
+// O(log n + k) for k items visited
+MOCKABLE_FUNCTION(, int, binary_tree_range_for_each, BINARY_TREE_HANDLE, handle, NODE_KEY, start, NODE_KEY, end, BINARY_TREE_VISIT, visit_cb, void*, user_ctx);
+MOCKABLE_FUNCTION(, int, binary_tree_range_for_each_key, BINARY_TREE_HANDLE, handle, const void*, start, const void*, end, BINARY_TREE_VISIT, visit_cb, void*, user_ctx);
+
 // Diagnostic function
 MOCKABLE_FUNCTION(, size_t, binary_tree_item_count, BINARY_TREE_HANDLE, handle);
 MOCKABLE_FUNCTION(, size_t, binary_tree_height, BINARY_TREE_HANDLE, handle);
@@ -0,0 +1,76 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+typedef struct BPLUS_TREE_INFO_TAG* BPLUS_TREE_HANDLE;
+
+typedef void(*BPLUS_TREE_DESTROY_ITEM)(void* user_ctx, void* remove_item);
+
+// Position in the leaf level, lives on the caller's stack.  Any insert
+// or remove invalidates it
+typedef struct BPLUS_TREE_ITERATOR_TAG
+{
+    void* leaf;
+    size_t index;
+} BPLUS_TREE_ITERATOR;
+
+/**
+* @brief    Creates an ordered map of uint64_t keys.  The keys are packed
+*           into wide nodes so a lookup touches a few cache lines per
+*           level instead of one node per level, and the leaves are
+*           linked for range scans
+*
+* @param    destroy_cb  Called for each value still in the tree when it's destroyed
+* @param    user_ctx    Passed to destroy_cb
+*
+* @return   A handle to the tree or NULL on failure
+*/
+MOCKABLE_FUNCTION(, BPLUS_TREE_HANDLE, bplus_tree_create, BPLUS_TREE_DESTROY_ITEM, destroy_cb, void*, user_ctx);
+MOCKABLE_FUNCTION(, void, bplus_tree_destroy, BPLUS_TREE_HANDLE, handle);
+
+// Fails if the key is already in the tree
+MOCKABLE_FUNCTION(, int, bplus_tree_insert, BPLUS_TREE_HANDLE, handle, uint64_t, key, void*, value);
+// value is optional and receives the removed value, destroy_cb is not called
+MOCKABLE_FUNCTION(, int, bplus_tree_remove, BPLUS_TREE_HANDLE, handle, uint64_t, key, void**, value);
+MOCKABLE_FUNCTION(, void*, bplus_tree_find, BPLUS_TREE_HANDLE, handle, uint64_t, key);
+
+/**
+* @brief    Builds the tree from sorted input in O(n), filling the nodes
+*           instead of splitting them one insert at a time
+*
+* @param    keys        Strictly ascending keys
+* @param    values      The value of each key
+* @param    count       The number of entries in keys and values
+*
+* @return   0 on success.  Fails if the tree isn't empty or the keys aren't
+*           ascending, the tree is left empty on failure
+*/
+MOCKABLE_FUNCTION(, int, bplus_tree_bulk_load, BPLUS_TREE_HANDLE, handle, const uint64_t*, keys, void**, values, size_t, count);
+
+// Positions the iterator at the first key >= key
+MOCKABLE_FUNCTION(, int, bplus_tree_lower_bound, BPLUS_TREE_HANDLE, handle, uint64_t, key, BPLUS_TREE_ITERATOR*, iterator);
+// Positions the iterator at the first key > key
+MOCKABLE_FUNCTION(, int, bplus_tree_upper_bound, BPLUS_TREE_HANDLE, handle, uint64_t, key, BPLUS_TREE_ITERATOR*, iterator);
+// Returns the entry at the iterator and moves it along the leaf links,
+// fails once the last entry has been returned.  key and value are optional
+MOCKABLE_FUNCTION(, int, bplus_tree_iterator_next, BPLUS_TREE_HANDLE, handle, BPLUS_TREE_ITERATOR*, iterator, uint64_t*, key, void**, value);
+
+MOCKABLE_FUNCTION(, size_t, bplus_tree_item_count, BPLUS_TREE_HANDLE, handle);
+// Diagnostic function, the number of levels including the leaves
+MOCKABLE_FUNCTION(, size_t, bplus_tree_height, BPLUS_TREE_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -12,11 +12,24 @@ extern "C" {
 #include "macro_utils/macro_utils.h"
 #include "umock_c/umock_c_prod.h"
 
+// Bytes held inside the struct itself, one of them for the terminator.
+// Payloads that fit never touch the heap
+#define BUFFER_INLINE_SIZE      64
+
+// A full buffer grows by growth_percent of its current size, or to the
+// exact size needed when that is larger.  0 selects doubling.
+// payload_size is the string length, kept up to date by every call below
+// so appends never have to strlen the payload.
+// While the payload fits inline, payload points into the struct, so a
+// buffer must not be copied by value, only passed by pointer
 typedef struct STRING_BUFFER_TAG
 {
     char* payload;
     size_t alloc_size;
     size_t default_alloc;
+    size_t growth_percent;
+    size_t payload_size;
+    char inline_payload[BUFFER_INLINE_SIZE];
 } STRING_BUFFER;
 
 typedef struct BYTE_BUFFER_TAG
@@ -24,7 +37,9 @@ typedef struct BYTE_BUFFER_TAG
     unsigned char* payload;
     size_t alloc_size;
     size_t default_alloc;
+    size_t growth_percent;
     size_t payload_size;
+    unsigned char inline_payload[BUFFER_INLINE_SIZE];
 } BYTE_BUFFER;
 
 MOCKABLE_FUNCTION(, int, string_buffer_construct, STRING_BUFFER*, buffer, const char*, value);
@@ -32,9 +47,26 @@ MOCKABLE_FUNCTION(, void, string_buffer_free, STRING_BUFFER*, buffer);
 
 int string_buffer_construct_sprintf(STRING_BUFFER* buffer, const char* format, ...);
 
+// Appends length characters of value, which needs no terminator
+MOCKABLE_FUNCTION(, int, string_buffer_append, STRING_BUFFER*, buffer, const char*, value, size_t, length);
+// Inserts length characters of value at position, the characters after it move up
+MOCKABLE_FUNCTION(, int, string_buffer_insert, STRING_BUFFER*, buffer, size_t, position, const char*, value, size_t, length);
+// Cuts the string down to length characters, keeping the memory
+MOCKABLE_FUNCTION(, int, string_buffer_truncate, STRING_BUFFER*, buffer, size_t, length);
+
+// Grows the buffer to hold at least capacity characters, never shrinks it
+MOCKABLE_FUNCTION(, int, string_buffer_reserve, STRING_BUFFER*, buffer, size_t, capacity);
+// Gives back everything past the current string
+MOCKABLE_FUNCTION(, int, string_buffer_shrink_to_fit, STRING_BUFFER*, buffer);
+
 MOCKABLE_FUNCTION(, int, byte_buffer_construct, BYTE_BUFFER*, buffer, const unsigned char*, payload, size_t, length);
 MOCKABLE_FUNCTION(, void, byte_buffer_free, BYTE_BUFFER*, buffer);
 
+// Grows the buffer to hold at least capacity bytes, never shrinks it
+MOCKABLE_FUNCTION(, int, byte_buffer_reserve, BYTE_BUFFER*, buffer, size_t, capacity);
+// Gives back everything past payload_size
+MOCKABLE_FUNCTION(, int, byte_buffer_shrink_to_fit, BYTE_BUFFER*, buffer);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,81 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+#include <cstdint>
+extern "C" {
+#else
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#include "lib-util-c/buffer_alloc.h"
+
+// A message held as a chain of segments instead of one contiguous
+// payload.  Segments are linked in where they are, so framing a payload
+// with a header and trailer never copies the payload, and adding at
+// either end is O(1).  The bytes only get copied into one place by
+// buffer_chain_flatten, for the callers that really need that.
+typedef struct BUFFER_CHAIN_INFO_TAG* BUFFER_CHAIN_HANDLE;
+
+// Called once the chain is done with a segment it was given ownership
+// of, with the data and length it was added with
+typedef void(*BUFFER_CHAIN_RELEASE)(void* release_ctx, const unsigned char* data, size_t length);
+
+// Laid out like the posix struct iovec, an array of these can be handed
+// to writev or sendmsg as is
+typedef struct BUFFER_CHAIN_IOVEC_TAG
+{
+    void* iov_base;
+    size_t iov_len;
+} BUFFER_CHAIN_IOVEC;
+
+MOCKABLE_FUNCTION(, BUFFER_CHAIN_HANDLE, buffer_chain_create);
+// Releases every segment still in the chain
+MOCKABLE_FUNCTION(, void, buffer_chain_destroy, BUFFER_CHAIN_HANDLE, handle);
+
+// Links data into the chain without copying it.  With a NULL release_cb
+// the data is only referenced and has to outlive the chain, otherwise
+// the chain owns it and calls release_cb when it's done with it.  On
+// failure the data is not released
+MOCKABLE_FUNCTION(, int, buffer_chain_append, BUFFER_CHAIN_HANDLE, handle, const unsigned char*, data, size_t, length, BUFFER_CHAIN_RELEASE, release_cb, void*, release_ctx);
+MOCKABLE_FUNCTION(, int, buffer_chain_prepend, BUFFER_CHAIN_HANDLE, handle, const unsigned char*, data, size_t, length, BUFFER_CHAIN_RELEASE, release_cb, void*, release_ctx);
+
+// Copies data into the segment's own allocation, for headers, trailers
+// and other short pieces that don't live long enough to be referenced
+MOCKABLE_FUNCTION(, int, buffer_chain_append_copy, BUFFER_CHAIN_HANDLE, handle, const unsigned char*, data, size_t, length);
+MOCKABLE_FUNCTION(, int, buffer_chain_prepend_copy, BUFFER_CHAIN_HANDLE, handle, const unsigned char*, data, size_t, length);
+
+// Takes over the payload of buffer and leaves it empty.  A heap payload
+// moves into the chain as it is, one held inline in the BYTE_BUFFER is
+// copied since it goes away with the struct
+MOCKABLE_FUNCTION(, int, buffer_chain_append_byte_buffer, BUFFER_CHAIN_HANDLE, handle, BYTE_BUFFER*, buffer);
+MOCKABLE_FUNCTION(, int, buffer_chain_prepend_byte_buffer, BUFFER_CHAIN_HANDLE, handle, BYTE_BUFFER*, buffer);
+
+// Moves every segment of source onto the end of handle, source is left empty
+MOCKABLE_FUNCTION(, int, buffer_chain_append_chain, BUFFER_CHAIN_HANDLE, handle, BUFFER_CHAIN_HANDLE, source);
+
+// Number of bytes in the chain
+MOCKABLE_FUNCTION(, size_t, buffer_chain_get_length, BUFFER_CHAIN_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, buffer_chain_get_segment_count, BUFFER_CHAIN_HANDLE, handle);
+
+// Fills up to iov_count entries from the front of the chain and returns
+// how many it filled.  The entries point into the chain and stay valid
+// until the segments are consumed or the chain is destroyed
+MOCKABLE_FUNCTION(, size_t, buffer_chain_get_iovec, BUFFER_CHAIN_HANDLE, handle, BUFFER_CHAIN_IOVEC*, iov_array, size_t, iov_count);
+// Drops length bytes from the front of the chain, usually what a writev
+// just sent, releasing every segment that is used up
+MOCKABLE_FUNCTION(, int, buffer_chain_consume, BUFFER_CHAIN_HANDLE, handle, size_t, length);
+
+// Appends a copy of every byte in the chain to buffer with a single
+// allocation, the chain itself is left as it is
+MOCKABLE_FUNCTION(, int, buffer_chain_flatten, BUFFER_CHAIN_HANDLE, handle, BYTE_BUFFER*, buffer);
+
+#ifdef __cplusplus
+}
+#endif
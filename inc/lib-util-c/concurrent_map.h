@@ -0,0 +1,50 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#include "lib-util-c/item_map.h"
+
+// Shard count used when zero is passed to concurrent_map_create
+#define CONCURRENT_MAP_DEFAULT_SHARDS   64
+
+typedef struct CONCURRENT_MAP_INFO_TAG* CONCURRENT_MAP_HANDLE;
+
+/**
+* @brief    Creates a map whose keyspace is split across independently locked
+*           item_map shards so threads working on different keys don't contend
+*
+* @param    shard_count     The number of shards, CONCURRENT_MAP_DEFAULT_SHARDS when 0
+* @param    size            Expected total number of items, spread across the shards
+* @param    destroy_cb      Called when an item is removed from the map
+* @param    user_ctx        Context passed to destroy_cb
+* @param    hash_function   Hash used for both shard selection and the shards themselves
+*
+* @return   A handle to the map or NULL on failure
+*/
+MOCKABLE_FUNCTION(, CONCURRENT_MAP_HANDLE, concurrent_map_create, size_t, shard_count, size_t, size, ITEM_MAP_DESTROY_ITEM, destroy_cb, void*, user_ctx, ITEM_MAP_HASH_FUNCTION, hash_function);
+MOCKABLE_FUNCTION(, void, concurrent_map_destroy, CONCURRENT_MAP_HANDLE, handle);
+MOCKABLE_FUNCTION(, int, concurrent_map_add_item, CONCURRENT_MAP_HANDLE, handle, const char*, key, const void*, value, size_t, len);
+// The value is copied out while the shard is locked since a pointer into
+// the shard could be freed by another thread. At most len bytes are copied,
+// value_len (optional) receives the length the item was added with so a
+// caller can tell when its buffer was too small
+MOCKABLE_FUNCTION(, int, concurrent_map_get_item, CONCURRENT_MAP_HANDLE, handle, const char*, key, void*, value, size_t, len, size_t*, value_len);
+MOCKABLE_FUNCTION(, int, concurrent_map_remove_item, CONCURRENT_MAP_HANDLE, handle, const char*, key);
+MOCKABLE_FUNCTION(, int, concurrent_map_clear_all, CONCURRENT_MAP_HANDLE, handle);
+MOCKABLE_FUNCTION(, size_t, concurrent_map_size, CONCURRENT_MAP_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
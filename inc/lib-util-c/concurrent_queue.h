@@ -0,0 +1,62 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#include "lib-util-c/dllist.h"
+
+typedef struct MPMC_QUEUE_INFO_TAG* MPMC_QUEUE_HANDLE;
+typedef struct MPSC_QUEUE_INFO_TAG* MPSC_QUEUE_HANDLE;
+
+/**
+* @brief    Creates a bounded lock free queue that any number of threads
+*           can push to and pop from
+*
+* @param    capacity    The number of items the queue holds, rounded up to a power of two
+*
+* @return   A handle to the queue or NULL on failure
+*/
+MOCKABLE_FUNCTION(, MPMC_QUEUE_HANDLE, mpmc_queue_create, size_t, capacity);
+// Items still in the queue are not released
+MOCKABLE_FUNCTION(, void, mpmc_queue_destroy, MPMC_QUEUE_HANDLE, handle);
+// Fails without blocking when the queue is full
+MOCKABLE_FUNCTION(, int, mpmc_queue_push, MPMC_QUEUE_HANDLE, handle, void*, item);
+// Fails without blocking when the queue is empty
+MOCKABLE_FUNCTION(, int, mpmc_queue_try_pop, MPMC_QUEUE_HANDLE, handle, void**, item);
+// Waits until an item arrives, push a sentinel item per consumer to release
+// blocked consumers on shutdown
+MOCKABLE_FUNCTION(, int, mpmc_queue_pop, MPMC_QUEUE_HANDLE, handle, void**, item);
+
+/**
+* @brief    Creates an unbounded queue of DLLIST_ENTRY records that any number
+*           of threads can push to and a single thread pops from.  The queue
+*           links the records through their fwd_link so pushing never allocates,
+*           use LIST_CONTAINING_RECORD to get back to the record
+*
+* @return   A handle to the queue or NULL on failure
+*/
+MOCKABLE_FUNCTION(, MPSC_QUEUE_HANDLE, mpsc_queue_create);
+// Records still in the queue are not released
+MOCKABLE_FUNCTION(, void, mpsc_queue_destroy, MPSC_QUEUE_HANDLE, handle);
+// The entry must not be in another list until it's popped
+MOCKABLE_FUNCTION(, int, mpsc_queue_push, MPSC_QUEUE_HANDLE, handle, PDLLIST_ENTRY, entry);
+// Returns NULL without blocking when the queue is empty or the only
+// record is still being linked by its producer
+MOCKABLE_FUNCTION(, PDLLIST_ENTRY, mpsc_queue_try_pop, MPSC_QUEUE_HANDLE, handle);
+// Waits until a record arrives, returns NULL on failure
+MOCKABLE_FUNCTION(, PDLLIST_ENTRY, mpsc_queue_pop, MPSC_QUEUE_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
@@ -15,11 +15,13 @@ extern "C" {
 #ifdef WIN32
     #include <windows.h>
 
-    typedef CONDITION_VARIABLE SIGNAL_HANDLE;
+    typedef CONDITION_VARIABLE* SIGNAL_HANDLE;
 #else
     #include <pthread.h>
 
-    typedef pthread_cond_t SIGNAL_HANDLE;
+    // Points at the allocated condition so copies of the handle
+    // all signal the same object
+    typedef pthread_cond_t* SIGNAL_HANDLE;
 #endif
 
 MOCKABLE_FUNCTION(, int, condition_mgr_init, SIGNAL_HANDLE*, signal_item);
@@ -0,0 +1,62 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+#define HASH_SIPHASH_KEY_SIZE       16
+
+/**
+* @brief    64 bit wyhash of a buffer, processes 16 to 48 bytes per step
+*
+* @param    data    The bytes to hash
+* @param    len     The length in bytes of data
+* @param    seed    Seed value mixed into the result
+*
+* @return   The 64 bit hash of the data
+*/
+MOCKABLE_FUNCTION(, uint64_t, hash_wyhash, const void*, data, size_t, len, uint64_t, seed);
+
+/**
+* @brief    64 bit XXH3 hash of a buffer, matches XXH3_64bits_withSeed
+*
+* @param    data    The bytes to hash
+* @param    len     The length in bytes of data
+* @param    seed    Seed value mixed into the result
+*
+* @return   The 64 bit hash of the data
+*/
+MOCKABLE_FUNCTION(, uint64_t, hash_xxh3, const void*, data, size_t, len, uint64_t, seed);
+
+/**
+* @brief    SipHash-2-4 of a buffer. Use a random secret key when the
+*           hashed data comes from an untrusted source
+*
+* @param    data    The bytes to hash
+* @param    len     The length in bytes of data
+* @param    key     HASH_SIPHASH_KEY_SIZE byte secret key
+*
+* @return   The 64 bit hash of the data
+*/
+MOCKABLE_FUNCTION(, uint64_t, hash_siphash, const void*, data, size_t, len, const unsigned char*, key);
+
+// String hashes that can be passed to item_map as an ITEM_MAP_HASH_FUNCTION.
+// hash_siphash_string keys SipHash with a per process secret read from the
+// OS random source on first use, so its values differ between runs
+MOCKABLE_FUNCTION(, uint32_t, hash_wyhash_string, const char*, key);
+MOCKABLE_FUNCTION(, uint32_t, hash_xxh3_string, const char*, key);
+MOCKABLE_FUNCTION(, uint32_t, hash_siphash_string, const char*, key);
+
+#ifdef __cplusplus
+}
+#endif
@@ -4,8 +4,11 @@
 
 #ifdef __cplusplus
 extern "C" {
+#include <cstdint>
+#include <cstddef>
 #else
-
+#include <stdint.h>
+#include <stddef.h>
 #endif
 
 #include "macro_utils/macro_utils.h"
@@ -15,9 +18,35 @@ typedef struct ITEM_LIST_INFO_TAG* ITEM_LIST_HANDLE;
 
 typedef struct ITEM_NODE_TAG* ITERATOR_HANDLE;
 
+// Position in a walk over the list, lives on the caller's stack so any
+// number of walks can run at once.  Only item_list_iterator_remove_current
+// may change the list while walking, other adds or removes invalidate it
+typedef struct ITEM_LIST_ITERATOR_TAG
+{
+    size_t index;
+    void* prev_node;
+    void* current_node;
+    void* next_node;
+} ITEM_LIST_ITERATOR;
+
 typedef void(*ITEM_LIST_DESTROY_ITEM)(void* user_ctx, void* remove_item);
 
+// Options passed to item_list_create_with_options
+#define ITEM_LIST_OPTION_NONE           0x00
+// Store items in a contiguous growable array instead of linked nodes,
+// indexed access is O(1) and item_list_remove_item shifts the following
+// items down.
+// Adding or removing items invalidates iterators, adding may move the array
+#define ITEM_LIST_OPTION_ARRAY          0x01
+// Carve linked nodes from per list slabs and recycle removed nodes
+// instead of returning them to the heap.  The slabs are only
+// released when the list is destroyed
+#define ITEM_LIST_OPTION_NODE_POOL      0x02
+
 MOCKABLE_FUNCTION(, ITEM_LIST_HANDLE, item_list_create, ITEM_LIST_DESTROY_ITEM, destroy_cb, void*, user_ctx);
+// capacity is the number of items to preallocate for the array or the
+// node pool, 0 allocates on the first add
+MOCKABLE_FUNCTION(, ITEM_LIST_HANDLE, item_list_create_with_options, uint32_t, options, size_t, capacity, ITEM_LIST_DESTROY_ITEM, destroy_cb, void*, user_ctx);
 MOCKABLE_FUNCTION(, void, item_list_destroy, ITEM_LIST_HANDLE, handle);
 
 MOCKABLE_FUNCTION(, int, item_list_add_item, ITEM_LIST_HANDLE, handle, const void*, item);
@@ -30,9 +59,21 @@ MOCKABLE_FUNCTION(, int, item_list_clear, ITEM_LIST_HANDLE, handle);
 
 // Resets the iterator to the inital item
 MOCKABLE_FUNCTION(, ITERATOR_HANDLE, item_list_iterator, ITEM_LIST_HANDLE, handle);
-// Moves the iterator the the next item
+// Moves the iterator the the next item.  With ITEM_LIST_OPTION_ARRAY the
+// iterator points into the array, so it must be restarted with
+// item_list_iterator after any add or remove.  Use ITEM_LIST_ITERATOR to
+// remove items while walking
 MOCKABLE_FUNCTION(, const void*, item_list_get_next, ITEM_LIST_HANDLE, handle, ITERATOR_HANDLE*, iterator);
 
+MOCKABLE_FUNCTION(, int, item_list_iterator_init, ITEM_LIST_HANDLE, handle, ITEM_LIST_ITERATOR*, iterator);
+// Returns the next item, or NULL once every item has been visited
+MOCKABLE_FUNCTION(, const void*, item_list_iterator_next, ITEM_LIST_HANDLE, handle, ITEM_LIST_ITERATOR*, iterator);
+// Removes the item the last item_list_iterator_next returned, the walk
+// carries on from the following item.  O(1) for both storage kinds, array
+// lists leave a hole that item_list_iterator_next slides forward so a full
+// sweep moves each item at most once
+MOCKABLE_FUNCTION(, int, item_list_iterator_remove_current, ITEM_LIST_HANDLE, handle, ITEM_LIST_ITERATOR*, iterator);
+
 
 #ifdef __cplusplus
 }
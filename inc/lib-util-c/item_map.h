@@ -5,8 +5,11 @@
 #ifdef __cplusplus
 extern "C" {
 #include <cstdint>
+#include <cstddef>
 #else
 #include <stdint.h>
+#include <stddef.h>
+#include <stdbool.h>
 #endif
 
 #include "macro_utils/macro_utils.h"
@@ -14,17 +17,64 @@ extern "C" {
 
 typedef struct ITEM_MAP_INFO_TAG* ITEM_MAP_HANDLE;
 
+// Position in a walk over the map, lives on the caller's stack.  Adding
+// or removing items while walking invalidates it
+typedef struct ITEM_MAP_ITERATOR_TAG
+{
+    size_t index;
+    void* node;
+} ITEM_MAP_ITERATOR;
+
+// Called when a borrowed item leaves the map, copied items are freed by the map
 typedef void(*ITEM_MAP_DESTROY_ITEM)(void* user_ctx, const char* key, void* remove_value);
 typedef uint32_t(*ITEM_MAP_HASH_FUNCTION)(const char* key);
 
+// Options passed to item_map_create_with_options
+#define ITEM_MAP_OPTION_NONE                0x00
+// Store items in a flat open addressing table that grows
+// incrementally instead of fixed size chained buckets
+#define ITEM_MAP_OPTION_OPEN_ADDRESSING     0x01
+// Carve entries from per map slabs and copy short keys
+// and small values into the entry instead of the heap
+#define ITEM_MAP_OPTION_INLINE_STORAGE      0x02
+// Round the chained bucket count up to a power of two and
+// select buckets with a mask instead of a modulo
+#define ITEM_MAP_OPTION_POWER_OF_TWO        0x04
+
 MOCKABLE_FUNCTION(, ITEM_MAP_HANDLE, item_map_create, size_t, size, ITEM_MAP_DESTROY_ITEM, destroy_cb, void*, user_ctx, ITEM_MAP_HASH_FUNCTION, hash_function);
+MOCKABLE_FUNCTION(, ITEM_MAP_HANDLE, item_map_create_with_options, size_t, size, uint32_t, options, ITEM_MAP_DESTROY_ITEM, destroy_cb, void*, user_ctx, ITEM_MAP_HASH_FUNCTION, hash_function);
 MOCKABLE_FUNCTION(, void, item_map_destroy, ITEM_MAP_HANDLE, handle);
+// Does not check for an existing key, use item_map_upsert to replace items
 MOCKABLE_FUNCTION(, int, item_map_add_item, ITEM_MAP_HANDLE, handle, const char*, key, const void*, value, size_t, len);
+// Replaces the value of an existing key in place or adds the item
+MOCKABLE_FUNCTION(, int, item_map_upsert, ITEM_MAP_HANDLE, handle, const char*, key, const void*, value, size_t, len);
+// Returns the writable value for the key, adding a zeroed value of len bytes
+// when it isn't in the map.  The pointer stays valid until the item is removed
+MOCKABLE_FUNCTION(, void*, item_map_get_or_insert, ITEM_MAP_HANDLE, handle, const char*, key, size_t, len, bool*, inserted);
+// Stores the key and value pointers without copying them.  Both must stay
+// valid until the item is removed, at which point destroy_cb is called
+// with them so the caller can release them
+MOCKABLE_FUNCTION(, int, item_map_add_borrowed_item, ITEM_MAP_HANDLE, handle, const char*, key, void*, value, size_t, len);
 MOCKABLE_FUNCTION(, const void*, item_map_get_item, ITEM_MAP_HANDLE, handle, const char*, key);
+// Looks up a key using a hash the caller already holds, the hash must be the value
+// item_map_hash_key returns for the key and key_len the strlen of the key.
+// len, when not NULL, receives the length the value was added with
+MOCKABLE_FUNCTION(, const void*, item_map_get_item_prehashed, ITEM_MAP_HANDLE, handle, const char*, key, size_t, key_len, uint32_t, hash, size_t*, len);
+// Adds count items, hashing and prefetching ahead of the inserts.  Items
+// added before a failure stay in the map
+MOCKABLE_FUNCTION(, int, item_map_add_batch, ITEM_MAP_HANDLE, handle, const char**, keys, const void**, values, const size_t*, lens, size_t, count);
+// Looks up count keys, filling values with the item or NULL when missing.
+// Returns the number of keys found
+MOCKABLE_FUNCTION(, size_t, item_map_get_batch, ITEM_MAP_HANDLE, handle, const char**, keys, size_t, count, const void**, values);
+MOCKABLE_FUNCTION(, uint32_t, item_map_hash_key, ITEM_MAP_HANDLE, handle, const char*, key);
 MOCKABLE_FUNCTION(, int, item_map_remove_item, ITEM_MAP_HANDLE, handle, const char*, key);
 MOCKABLE_FUNCTION(, int, item_map_clear_all, ITEM_MAP_HANDLE, handle);
 MOCKABLE_FUNCTION(, size_t, item_map_size, ITEM_MAP_HANDLE, handle);
 
+MOCKABLE_FUNCTION(, int, item_map_iterator, ITEM_MAP_HANDLE, handle, ITEM_MAP_ITERATOR*, iterator);
+// Returns the next live value, or NULL once every item has been visited
+MOCKABLE_FUNCTION(, const void*, item_map_get_next, ITEM_MAP_HANDLE, handle, ITEM_MAP_ITERATOR*, iterator, const char**, key, size_t*, len);
+
 #ifdef __cplusplus
 }
 #endif
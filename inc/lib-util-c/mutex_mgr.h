@@ -18,7 +18,9 @@ extern "C" {
 #else
     #include <pthread.h>
 
-    typedef pthread_mutex_t MUTEX_HANDLE;
+    // Points at the allocated mutex so copies of the handle all
+    // lock the same object
+    typedef pthread_mutex_t* MUTEX_HANDLE;
 #endif
 
 MOCKABLE_FUNCTION(, int, mutex_mgr_create, MUTEX_HANDLE*, handle);
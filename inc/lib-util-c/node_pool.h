@@ -0,0 +1,37 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+// Fixed size nodes carved from slabs and recycled through a free list.
+// The pool is embedded in the owning container, the free list link is
+// kept in the node itself at link_offset so no extra storage is needed
+typedef struct NODE_POOL_TAG
+{
+    struct NODE_SLAB_TAG* slab_list;
+    void* free_nodes;
+    size_t node_size;
+    size_t link_offset;
+} NODE_POOL;
+
+MOCKABLE_FUNCTION(, void, node_pool_init, NODE_POOL*, pool, size_t, node_size, size_t, link_offset);
+// Frees every slab, nodes still handed out go with them
+MOCKABLE_FUNCTION(, void, node_pool_deinit, NODE_POOL*, pool);
+// Adds a slab of node_count nodes to the free list
+MOCKABLE_FUNCTION(, int, node_pool_reserve, NODE_POOL*, pool, size_t, node_count);
+// Takes a node from the free list, each new slab doubles the previous one
+MOCKABLE_FUNCTION(, void*, node_pool_allocate, NODE_POOL*, pool);
+MOCKABLE_FUNCTION(, void, node_pool_release, NODE_POOL*, pool, void*, node);
+
+#ifdef __cplusplus
+}
+#endif
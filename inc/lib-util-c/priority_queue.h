@@ -0,0 +1,68 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstdint>
+#include <cstddef>
+extern "C" {
+#else
+#include <stdint.h>
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+typedef struct PRIORITY_QUEUE_INFO_TAG* PRIORITY_QUEUE_HANDLE;
+
+// Refers to an item while it's in the queue, popping the item
+// releases the entry and the handle must not be used again
+typedef struct PRIORITY_QUEUE_ENTRY_TAG* PRIORITY_QUEUE_ENTRY_HANDLE;
+
+typedef void(*PRIORITY_QUEUE_DESTROY_ITEM)(void* user_ctx, void* remove_item);
+
+/**
+* @brief    Creates a min priority queue, the item with the lowest priority
+*           value is popped first.  Items with equal priority pop in no
+*           particular order
+*
+* @param    capacity    The number of items to preallocate, 0 allocates on the first push
+* @param    destroy_cb  Called for each item still queued when the queue is destroyed
+* @param    user_ctx    Passed to destroy_cb
+*
+* @return   A handle to the queue or NULL on failure
+*/
+MOCKABLE_FUNCTION(, PRIORITY_QUEUE_HANDLE, priority_queue_create, size_t, capacity, PRIORITY_QUEUE_DESTROY_ITEM, destroy_cb, void*, user_ctx);
+MOCKABLE_FUNCTION(, void, priority_queue_destroy, PRIORITY_QUEUE_HANDLE, handle);
+
+// entry is optional, pass it to priority_queue_decrease_key to reorder the item
+MOCKABLE_FUNCTION(, int, priority_queue_push, PRIORITY_QUEUE_HANDLE, handle, uint64_t, priority, void*, item, PRIORITY_QUEUE_ENTRY_HANDLE*, entry);
+// Removes the item with the lowest priority, fails when the queue is empty.
+// priority is optional
+MOCKABLE_FUNCTION(, int, priority_queue_pop, PRIORITY_QUEUE_HANDLE, handle, void**, item, uint64_t*, priority);
+// Returns the item with the lowest priority without removing it, or NULL
+// when the queue is empty.  priority is optional
+MOCKABLE_FUNCTION(, void*, priority_queue_peek, PRIORITY_QUEUE_HANDLE, handle, uint64_t*, priority);
+// Lowers the priority of a queued item, fails if priority is higher than
+// the current one
+MOCKABLE_FUNCTION(, int, priority_queue_decrease_key, PRIORITY_QUEUE_HANDLE, handle, PRIORITY_QUEUE_ENTRY_HANDLE, entry, uint64_t, priority);
+
+/**
+* @brief    Adds count items at once and rebuilds the heap in O(n), which is
+*           cheaper than count pushes when loading many items
+*
+* @param    priorities  The priority of each item
+* @param    items       The items to add
+* @param    count       The number of entries in priorities and items
+* @param    entries     Optional array of count handles that receives the entry of each item
+*
+* @return   0 on success, nothing is added on failure
+*/
+MOCKABLE_FUNCTION(, int, priority_queue_heapify, PRIORITY_QUEUE_HANDLE, handle, const uint64_t*, priorities, void**, items, size_t, count, PRIORITY_QUEUE_ENTRY_HANDLE*, entries);
+
+MOCKABLE_FUNCTION(, size_t, priority_queue_item_count, PRIORITY_QUEUE_HANDLE, handle);
+
+#ifdef __cplusplus
+}
+#endif
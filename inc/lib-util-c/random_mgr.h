@@ -0,0 +1,21 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#pragma once
+
+#ifdef __cplusplus
+#include <cstddef>
+extern "C" {
+#else
+#include <stddef.h>
+#endif
+
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c_prod.h"
+
+// Fills buffer with len bytes from the operating system's secure random
+// source, suitable for seeding keyed hashes
+MOCKABLE_FUNCTION(, int, random_mgr_get_bytes, unsigned char*, buffer, size_t, len);
+
+#ifdef __cplusplus
+}
+#endif
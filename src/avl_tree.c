@@ -0,0 +1,345 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+#include "lib-util-c/avl_tree.h"
+
+static size_t entry_height(const AVL_TREE_ENTRY* entry)
+{
+    return entry == NULL ? 0 : entry->height;
+}
+
+static void update_entry_height(PAVL_TREE_ENTRY entry)
+{
+    size_t left_height = entry_height(entry->left);
+    size_t right_height = entry_height(entry->right);
+    entry->height = (left_height > right_height ? left_height : right_height) + 1;
+}
+
+static int balance_factor(const AVL_TREE_ENTRY* entry)
+{
+    return (int)entry_height(entry->left) - (int)entry_height(entry->right);
+}
+
+// Rotations return the entry that now sits where entry was,
+// the caller stores it in whatever pointed at entry
+static PAVL_TREE_ENTRY rotate_right(PAVL_TREE_ENTRY entry)
+{
+    PAVL_TREE_ENTRY pivot_entry = entry->left;
+
+    entry->left = pivot_entry->right;
+    if (pivot_entry->right != NULL)
+    {
+        pivot_entry->right->parent = entry;
+    }
+    pivot_entry->parent = entry->parent;
+    pivot_entry->right = entry;
+    entry->parent = pivot_entry;
+
+    update_entry_height(entry);
+    update_entry_height(pivot_entry);
+    return pivot_entry;
+}
+
+static PAVL_TREE_ENTRY rotate_left(PAVL_TREE_ENTRY entry)
+{
+    PAVL_TREE_ENTRY pivot_entry = entry->right;
+
+    entry->right = pivot_entry->left;
+    if (pivot_entry->left != NULL)
+    {
+        pivot_entry->left->parent = entry;
+    }
+    pivot_entry->parent = entry->parent;
+    pivot_entry->left = entry;
+    entry->parent = pivot_entry;
+
+    update_entry_height(entry);
+    update_entry_height(pivot_entry);
+    return pivot_entry;
+}
+
+PAVL_TREE_ENTRY avl_tree_rebalance_entry(PAVL_TREE_ENTRY entry)
+{
+    PAVL_TREE_ENTRY result = entry;
+    int balance;
+
+    update_entry_height(entry);
+    balance = balance_factor(entry);
+    if (balance > 1)
+    {
+        // Left right case, turn it into a left left case first
+        if (balance_factor(entry->left) < 0)
+        {
+            entry->left = rotate_left(entry->left);
+        }
+        result = rotate_right(entry);
+    }
+    else if (balance < -1)
+    {
+        // Right left case, turn it into a right right case first
+        if (balance_factor(entry->right) > 0)
+        {
+            entry->right = rotate_right(entry->right);
+        }
+        result = rotate_left(entry);
+    }
+    return result;
+}
+
+// The link in the parent, or the root, that points at entry
+static PAVL_TREE_ENTRY* parent_link(PAVL_TREE_ROOT tree_root, const AVL_TREE_ENTRY* entry)
+{
+    PAVL_TREE_ENTRY* result;
+    if (entry->parent == NULL)
+    {
+        result = &tree_root->root_entry;
+    }
+    else if (entry->parent->left == entry)
+    {
+        result = &entry->parent->left;
+    }
+    else
+    {
+        result = &entry->parent->right;
+    }
+    return result;
+}
+
+// Walks from entry to the root rebalancing each entry, stopping once a
+// subtree comes out the same height it went in
+static void rebalance_to_root(PAVL_TREE_ROOT tree_root, PAVL_TREE_ENTRY entry)
+{
+    while (entry != NULL)
+    {
+        size_t previous_height = entry->height;
+        PAVL_TREE_ENTRY* link = parent_link(tree_root, entry);
+        PAVL_TREE_ENTRY parent_entry = entry->parent;
+        *link = avl_tree_rebalance_entry(entry);
+        if ((*link)->height == previous_height)
+        {
+            break;
+        }
+        entry = parent_entry;
+    }
+}
+
+static PAVL_TREE_ENTRY leftmost_entry(PAVL_TREE_ENTRY entry)
+{
+    while (entry != NULL && entry->left != NULL)
+    {
+        entry = entry->left;
+    }
+    return entry;
+}
+
+static PAVL_TREE_ENTRY rightmost_entry(PAVL_TREE_ENTRY entry)
+{
+    while (entry != NULL && entry->right != NULL)
+    {
+        entry = entry->right;
+    }
+    return entry;
+}
+
+void avl_tree_init(PAVL_TREE_ROOT tree_root, AVL_TREE_COMPARE compare_cb)
+{
+    if (tree_root != NULL)
+    {
+        tree_root->root_entry = NULL;
+        tree_root->compare_cb = compare_cb;
+        tree_root->entry_count = 0;
+    }
+}
+
+bool avl_tree_is_empty(const AVL_TREE_ROOT* tree_root)
+{
+    return (tree_root->root_entry == NULL);
+}
+
+size_t avl_tree_count(const AVL_TREE_ROOT* tree_root)
+{
+    return tree_root->entry_count;
+}
+
+size_t avl_tree_height(const AVL_TREE_ROOT* tree_root)
+{
+    return entry_height(tree_root->root_entry);
+}
+
+int avl_tree_insert(PAVL_TREE_ROOT tree_root, PAVL_TREE_ENTRY entry)
+{
+    int result;
+    if (tree_root == NULL || entry == NULL || tree_root->compare_cb == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        PAVL_TREE_ENTRY parent_entry = NULL;
+        PAVL_TREE_ENTRY* target_entry = &tree_root->root_entry;
+
+        result = 0;
+        while (*target_entry != NULL)
+        {
+            int compare_value = tree_root->compare_cb(entry, *target_entry);
+            if (compare_value == 0)
+            {
+                result = __LINE__;
+                break;
+            }
+            parent_entry = *target_entry;
+            target_entry = compare_value > 0 ? &parent_entry->right : &parent_entry->left;
+        }
+
+        if (result == 0)
+        {
+            avl_tree_link_entry(tree_root, parent_entry, target_entry, entry);
+        }
+    }
+    return result;
+}
+
+void avl_tree_link_entry(PAVL_TREE_ROOT tree_root, PAVL_TREE_ENTRY parent_entry, PAVL_TREE_ENTRY* link, PAVL_TREE_ENTRY entry)
+{
+    entry->parent = parent_entry;
+    entry->left = entry->right = NULL;
+    entry->height = 1;
+    *link = entry;
+    tree_root->entry_count++;
+    // Height changes ripple up the path the insert took
+    rebalance_to_root(tree_root, parent_entry);
+}
+
+void avl_tree_remove_entry(PAVL_TREE_ROOT tree_root, PAVL_TREE_ENTRY entry)
+{
+    PAVL_TREE_ENTRY* link = parent_link(tree_root, entry);
+    PAVL_TREE_ENTRY rebalance_entry;
+
+    if (entry->left == NULL || entry->right == NULL)
+    {
+        // Zero or one child, the child moves up
+        PAVL_TREE_ENTRY child_entry = entry->left != NULL ? entry->left : entry->right;
+        if (child_entry != NULL)
+        {
+            child_entry->parent = entry->parent;
+        }
+        *link = child_entry;
+        rebalance_entry = entry->parent;
+    }
+    else
+    {
+        // Two children, the smallest entry of the right subtree takes its place
+        PAVL_TREE_ENTRY successor = leftmost_entry(entry->right);
+        if (successor->parent == entry)
+        {
+            rebalance_entry = successor;
+        }
+        else
+        {
+            rebalance_entry = successor->parent;
+            successor->parent->left = successor->right;
+            if (successor->right != NULL)
+            {
+                successor->right->parent = successor->parent;
+            }
+            successor->right = entry->right;
+            successor->right->parent = successor;
+        }
+        successor->left = entry->left;
+        successor->left->parent = successor;
+        successor->parent = entry->parent;
+        // Takes over the removed entry's height so the walk up
+        // can stop early without leaving a stale height behind
+        successor->height = entry->height;
+        *link = successor;
+    }
+    entry->parent = entry->left = entry->right = NULL;
+    tree_root->entry_count--;
+    rebalance_to_root(tree_root, rebalance_entry);
+}
+
+PAVL_TREE_ENTRY avl_tree_find(const AVL_TREE_ROOT* tree_root, const AVL_TREE_ENTRY* key_entry)
+{
+    PAVL_TREE_ENTRY result = tree_root->root_entry;
+    while (result != NULL)
+    {
+        int compare_value = tree_root->compare_cb(key_entry, result);
+        if (compare_value == 0)
+        {
+            break;
+        }
+        result = compare_value > 0 ? result->right : result->left;
+    }
+    return result;
+}
+
+// Remembers the last entry the walk went left from
+PAVL_TREE_ENTRY avl_tree_lower_bound(const AVL_TREE_ROOT* tree_root, const AVL_TREE_ENTRY* key_entry)
+{
+    PAVL_TREE_ENTRY result = NULL;
+    PAVL_TREE_ENTRY entry = tree_root->root_entry;
+    while (entry != NULL)
+    {
+        if (tree_root->compare_cb(key_entry, entry) <= 0)
+        {
+            result = entry;
+            entry = entry->left;
+        }
+        else
+        {
+            entry = entry->right;
+        }
+    }
+    return result;
+}
+
+PAVL_TREE_ENTRY avl_tree_first(const AVL_TREE_ROOT* tree_root)
+{
+    return leftmost_entry(tree_root->root_entry);
+}
+
+PAVL_TREE_ENTRY avl_tree_last(const AVL_TREE_ROOT* tree_root)
+{
+    return rightmost_entry(tree_root->root_entry);
+}
+
+// The smallest entry of the right subtree or the first ancestor
+// reached from its left side
+PAVL_TREE_ENTRY avl_tree_next(const AVL_TREE_ENTRY* entry)
+{
+    PAVL_TREE_ENTRY result;
+    if (entry->right != NULL)
+    {
+        result = leftmost_entry(entry->right);
+    }
+    else
+    {
+        while (entry->parent != NULL && entry == entry->parent->right)
+        {
+            entry = entry->parent;
+        }
+        result = entry->parent;
+    }
+    return result;
+}
+
+PAVL_TREE_ENTRY avl_tree_prev(const AVL_TREE_ENTRY* entry)
+{
+    PAVL_TREE_ENTRY result;
+    if (entry->left != NULL)
+    {
+        result = rightmost_entry(entry->left);
+    }
+    else
+    {
+        while (entry->parent != NULL && entry == entry->parent->left)
+        {
+            entry = entry->parent;
+        }
+        result = entry->parent;
+    }
+    return result;
+}
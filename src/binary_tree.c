@@ -2,40 +2,66 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
 #include <string.h>
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/binary_tree.h"
+#include "lib-util-c/avl_tree.h"
 #include "lib-util-c/app_logging.h"
+#include "lib-util-c/node_pool.h"
 
-#define USE_RECURSION
-#define NUM_OF_CHARS    8
+#define NUM_OF_CHARS    16
 static const char LEFT_PARENTHESIS = '(';
 static const char RIGHT_PARENTHESIS = ')';
 
 
+// Value keys compare as integers, user keys are owned by the caller
+// and ordered by the tree's compare callback
+typedef union TREE_KEY_TAG
+{
+    NODE_KEY value;
+    const void* user_key;
+} TREE_KEY;
+
+// The links and heights are kept by avl_tree, the tree only
+// adds its keys and the search that orders them
 typedef struct NODE_INFO_TAG
 {
-    NODE_KEY key;
+    AVL_TREE_ENTRY entry;
+    TREE_KEY key;
     void* data;
-    struct NODE_INFO_TAG* parent;
-    struct NODE_INFO_TAG* right;
-    struct NODE_INFO_TAG* left;
-    // Keeps track of the child nodes balance
-    // child on right = -1
-    // child on left = +1
-    int balance_factor;
-    size_t height;
 } NODE_INFO;
 
 typedef struct BINARY_TREE_INFO_TAG
 {
     size_t items;
-    size_t height;
-    NODE_INFO* root_node;
+    uint32_t options;
+    AVL_TREE_ROOT tree_root;
+    // NULL for trees keyed by NODE_KEY values
+    BINARY_TREE_COMPARE compare_cb;
+    // Recycled nodes used by BINARY_TREE_OPTION_NODE_POOL, free
+    // nodes are chained through their right link
+    NODE_POOL node_pool;
 } BINARY_TREE_INFO;
 
-static size_t construct_visual_representation(const NODE_INFO* node_info, char* visualization, size_t pos)
+static NODE_INFO* get_node(const AVL_TREE_ENTRY* entry)
+{
+    return entry == NULL ? NULL : AVL_TREE_CONTAINING_RECORD(entry, NODE_INFO, entry);
+}
+
+static size_t append_node_key(const BINARY_TREE_INFO* tree_info, const NODE_INFO* node_info, char* visualization, size_t pos)
+{
+    char temp[NUM_OF_CHARS + 1];
+    // User keys are opaque so their address stands in for them
+    unsigned long long key_value = tree_info->compare_cb == NULL ? (unsigned long long)node_info->key.value : (unsigned long long)(uintptr_t)node_info->key.user_key;
+    int len = sprintf(temp, "%llx", key_value);
+    memcpy(visualization + pos, temp, len);
+    return pos + len;
+}
+
+static size_t construct_visual_representation(const BINARY_TREE_INFO* tree_info, const AVL_TREE_ENTRY* entry, char* visualization, size_t pos)
 {
     /*
             10
@@ -48,627 +74,571 @@ static size_t construct_visual_representation(const NODE_INFO* node_info, char*
     // [1, 2, 3, 4]
     // 1(2(4))(3)
 
-    if (node_info != NULL)
+    // Pre order walk over the parent links, previous_entry tells whether
+    // the walk arrived from above, from the left child or from the right
+    const AVL_TREE_ENTRY* root_parent = entry == NULL ? NULL : entry->parent;
+    const AVL_TREE_ENTRY* previous_entry = root_parent;
+    while (entry != NULL && entry != root_parent)
     {
-        char temp[8];
-        int len = sprintf(temp, "%x", node_info->key);
-        memcpy(visualization+pos, temp, len);
-        pos += len;
-        if (node_info->left != NULL)
+        const AVL_TREE_ENTRY* next_entry;
+        if (previous_entry == entry->parent)
         {
-            memcpy(visualization + pos, &LEFT_PARENTHESIS, 1);
-            pos += 1;
-            pos = construct_visual_representation(node_info->left, visualization, pos);
-            memcpy(visualization + pos, &RIGHT_PARENTHESIS, 1);
-            pos += 1;
+            pos = append_node_key(tree_info, get_node(entry), visualization, pos);
+            next_entry = entry->left != NULL ? entry->left : (entry->right != NULL ? entry->right : entry->parent);
+        }
+        else if (previous_entry == entry->left)
+        {
+            next_entry = entry->right != NULL ? entry->right : entry->parent;
+        }
+        else
+        {
+            next_entry = entry->parent;
+        }
+
+        if (next_entry == entry->parent)
+        {
+            if (next_entry != root_parent)
+            {
+                memcpy(visualization + pos, &RIGHT_PARENTHESIS, 1);
+                pos += 1;
+            }
         }
-        if (node_info->right != NULL)
+        else
         {
             memcpy(visualization + pos, &LEFT_PARENTHESIS, 1);
             pos += 1;
-            pos = construct_visual_representation(node_info->right, visualization, pos);
-            memcpy(visualization + pos, &RIGHT_PARENTHESIS, 1);
-            pos += 1;
         }
+        previous_entry = entry;
+        entry = next_entry;
     }
     return pos;
 }
 
-static int calculate_balance_factor(const NODE_INFO* node_info)
-{
-    int result;
-    result = (int)(node_info->left == NULL ? 0 : node_info->left->height);
-    result -= (int)(node_info->right == NULL ? 0 : node_info->right->height);
-    return result;
-}
-
-static NODE_INFO* create_new_node(NODE_KEY key_value, void* data)
+static NODE_INFO* allocate_node(BINARY_TREE_INFO* tree_info)
 {
     NODE_INFO* result;
-    if ((result = (NODE_INFO*)malloc(sizeof(NODE_INFO))) == NULL)
+    if (!(tree_info->options & BINARY_TREE_OPTION_NODE_POOL))
     {
-        log_error("Failure allocating tree node");
+        result = (NODE_INFO*)malloc(sizeof(NODE_INFO));
     }
     else
     {
-        memset(result, 0, sizeof(NODE_INFO));
-        result->key = key_value;
-        result->data = data;
+        result = (NODE_INFO*)node_pool_allocate(&tree_info->node_pool);
     }
     return result;
 }
 
-static void print_tree(const NODE_INFO* node_info, size_t indent_level)
+static void release_node(BINARY_TREE_INFO* tree_info, NODE_INFO* node_info)
 {
-    if (node_info != NULL)
+    if (tree_info->options & BINARY_TREE_OPTION_NODE_POOL)
     {
-        for (size_t index = 0; index < indent_level; index++)
-            printf("\t");
-        printf("%d\n", node_info->key);
-        print_tree(node_info->left, indent_level + 1);
-        print_tree(node_info->right, indent_level + 1);
+        node_pool_release(&tree_info->node_pool, node_info);
+    }
+    else
+    {
+        free(node_info);
     }
 }
 
-static void rotate_right(NODE_INFO* node_info)
+static NODE_INFO* create_new_node(BINARY_TREE_INFO* tree_info, const TREE_KEY* key, void* data)
 {
-    NODE_INFO* tpm_node = node_info;
-
-    node_info->parent->left = node_info->left;
-    node_info->parent->left->balance_factor = 0;
-    node_info->parent->left->parent = node_info->parent;
-    node_info->parent->balance_factor++;
-    if (node_info->parent->left->right == NULL)
+    NODE_INFO* result;
+    if ((result = allocate_node(tree_info)) == NULL)
     {
-        node_info->parent->left->right = tpm_node;
-        tpm_node->parent = node_info->parent->left;
-        tpm_node->left = tpm_node->right = NULL;
-        tpm_node->balance_factor = 0;
+        log_error("Failure allocating tree node");
     }
     else
     {
-        tpm_node->left = node_info->parent->left->right;
-        tpm_node->right = NULL;
-        node_info->parent->left->right = tpm_node;
-        tpm_node->balance_factor = -1;
+        memset(result, 0, sizeof(NODE_INFO));
+        result->key = *key;
+        result->data = data;
     }
+    return result;
 }
 
-static void rotate_left(NODE_INFO* node_info)
+static void print_node(const BINARY_TREE_INFO* tree_info, const NODE_INFO* node_info, size_t indent_level)
 {
-    NODE_INFO* tpm_node = node_info;
-
-    node_info->parent->right = node_info->right;
-    // The current node gets moved down
-    node_info->height--;
-
-    node_info->parent->right->balance_factor = 0;
-    node_info->parent->right->parent = node_info->parent;
-    node_info->parent->balance_factor++;
-    tpm_node->parent = node_info->parent->right;
-    if (node_info->parent->right->left == NULL)
+    for (size_t index = 0; index < indent_level; index++)
+        printf("\t");
+    if (tree_info->compare_cb == NULL)
     {
-        node_info->parent->left = tpm_node;
-        tpm_node->right = tpm_node->left = NULL;
-        tpm_node->balance_factor = 0;
-        tpm_node->height = tpm_node->parent->height-1;
+        printf("%llu\n", (unsigned long long)node_info->key.value);
     }
     else
     {
-        tpm_node->right = node_info->parent->left->right;
-        tpm_node->left = NULL;
-        tpm_node->height = tpm_node->parent->height - 1;
-        node_info->parent->right->left = tpm_node;
-        tpm_node->balance_factor = 1;
+        printf("%p\n", node_info->key.user_key);
     }
 }
 
-static int rebalance_if_neccessary(NODE_INFO* node_info)
+static void print_tree(const BINARY_TREE_INFO* tree_info, const AVL_TREE_ENTRY* entry, size_t indent_level)
 {
-    int result;
-    if (node_info->balance_factor < -1 && node_info->right->balance_factor == -1)
-    {
-        rotate_left(node_info);
-        result = 1;
-        log_debug("rotate right");
-    }
-    else if (node_info->balance_factor > 1 && node_info->left->balance_factor == 1)
-    {
-        rotate_right(node_info);
-        result = -1;
-        log_debug("rotate left");
-    }
-    else if (node_info->balance_factor < -1 && node_info->right->balance_factor == 1)
-    {
-        // Do Left right rotation
-        // Make the left child, a child of the left's right node
-        node_info->right->left->right = node_info->right;
-        node_info->right->left->right->height--;
-        node_info->right->parent = node_info->right->left;
-        node_info->right->left->parent = node_info;
-        node_info->right = node_info->right->left;
-        node_info->right->height++;
-        node_info->right->right->left = NULL;
-        // Do the left rotation
-        rotate_left(node_info);
-        result = 1;
-    }
-    else if (node_info->balance_factor > 1 && node_info->left->balance_factor == -1)
-    {
-        // Do right left rotation
-        node_info->left->right->left = node_info->left;
-        node_info->left->right->left->height--;
-        node_info->left->parent = node_info->left->right;
-        node_info->left->right->parent = node_info;
-        node_info->left = node_info->left->right;
-        node_info->left->height++;
-        node_info->left->left->right = NULL;
-        // Now do a right rotation
-        rotate_right(node_info);
-        result = -1;
-    }
-    else
+    // Same pre order walk as construct_visual_representation
+    const AVL_TREE_ENTRY* root_parent = entry == NULL ? NULL : entry->parent;
+    const AVL_TREE_ENTRY* previous_entry = root_parent;
+    while (entry != NULL && entry != root_parent)
     {
-        result = 0;
+        const AVL_TREE_ENTRY* next_entry;
+        if (previous_entry == entry->parent)
+        {
+            print_node(tree_info, get_node(entry), indent_level);
+            next_entry = entry->left != NULL ? entry->left : (entry->right != NULL ? entry->right : entry->parent);
+        }
+        else if (previous_entry == entry->left)
+        {
+            next_entry = entry->right != NULL ? entry->right : entry->parent;
+        }
+        else
+        {
+            next_entry = entry->parent;
+        }
+
+        if (next_entry == entry->parent)
+        {
+            indent_level--;
+        }
+        else
+        {
+            indent_level++;
+        }
+        previous_entry = entry;
+        entry = next_entry;
     }
-    return result;
 }
 
-static int compare_node_values(const NODE_KEY* value_1, const NODE_KEY* value_2)
+static int compare_node_values(const BINARY_TREE_INFO* tree_info, const TREE_KEY* value_1, const TREE_KEY* value_2)
 {
-    if (*value_1 > *value_2) return 1;
-    else if (*value_1 < *value_2) return -1;
+    if (tree_info->compare_cb != NULL) return tree_info->compare_cb(value_1->user_key, value_2->user_key);
+    else if (value_1->value > value_2->value) return 1;
+    else if (value_1->value < value_2->value) return -1;
     else return 0;
 }
 
-static NODE_INFO* find_node(NODE_INFO* node_info, const NODE_KEY* value)
+#ifdef BINARY_TREE_USE_RECURSION
+static NODE_INFO* find_node(const BINARY_TREE_INFO* tree_info, const AVL_TREE_ENTRY* entry, const TREE_KEY* value)
 {
     NODE_INFO* result;
-    if (node_info == NULL)
+    if (entry == NULL)
     {
         result = NULL;
     }
     else
     {
-#ifdef USE_RECURSION
-        int compare_value = compare_node_values(&node_info->key, value);
+        NODE_INFO* node_info = get_node(entry);
+        int compare_value = compare_node_values(tree_info, &node_info->key, value);
         if (compare_value > 0)
         {
-            result = find_node(node_info->left, value);
+            result = find_node(tree_info, entry->left, value);
         }
         else if (compare_value < 0)
         {
-            result = find_node(node_info->right, value);
+            result = find_node(tree_info, entry->right, value);
         }
         else
         {
             result = node_info;
         }
-#else
-        int compare_value;
-        NODE_INFO* compare_node = node_info;
-
-        result = NULL;
-        while (compare_node != NULL)
-        {
-            compare_value = compare_node_values(&compare_node->key, value);
-            if (compare_value > 0)
-            {
-                compare_node = compare_node->left;
-            }
-            else if (compare_value < 0)
-            {
-                compare_node = compare_node->right;
-            }
-            else
-            {
-                result = compare_node;
-            }
-        }
-#endif
     }
     return result;
 }
 
-typedef enum INSERT_NODE_TYPE_TAG
+static int insert_into_tree(const BINARY_TREE_INFO* tree_info, PAVL_TREE_ENTRY* target_entry, PAVL_TREE_ENTRY parent_entry, NODE_INFO* new_node)
 {
-    INSERT_NODE_INSERTED,
-    INSERT_NODE_NO_OP,
-    INSERT_NODE_REBALANCE,
-    INSERT_NODE_FAILED
-} INSERT_NODE_TYPE;
-
-static INSERT_NODE_TYPE insert_into_tree(NODE_INFO** target_node, NODE_INFO* new_node)
-{
-    INSERT_NODE_TYPE result = INSERT_NODE_FAILED;
-#ifdef USE_RECURSION
-    if (*target_node == NULL)
+    int result;
+    if (*target_entry == NULL)
     {
-        *target_node = new_node;
-        (*target_node)->height = 1;
-        result = INSERT_NODE_INSERTED;
+        new_node->entry.parent = parent_entry;
+        new_node->entry.height = 1;
+        *target_entry = &new_node->entry;
+        result = 0;
     }
-    else if (new_node->key > (*target_node)->key)
+    else
     {
-        if ((result = insert_into_tree(&(*target_node)->right, new_node)) != INSERT_NODE_FAILED)
+        int compare_value = compare_node_values(tree_info, &new_node->key, &get_node(*target_entry)->key);
+        if (compare_value == 0)
         {
-            // Increment the height
-            if ((*target_node)->height <= (*target_node)->right->height || result == INSERT_NODE_REBALANCE)
-            {
-                // Or rebalance the height changes should reverberate up the tree
-                (*target_node)->height = (*target_node)->right->height + 1;
-            }
-            // If you inserted a direct child increment
-            // the balance factor
-            if (result == INSERT_NODE_INSERTED)
+            log_error("Key already exists in tree");
+            result = __LINE__;
+        }
+        else
+        {
+            PAVL_TREE_ENTRY* child_entry = compare_value > 0 ? &(*target_entry)->right : &(*target_entry)->left;
+            if ((result = insert_into_tree(tree_info, child_entry, *target_entry, new_node)) == 0)
             {
-                // Set parent node
-                (*target_node)->right->parent = *target_node;
-
-                // Only return inserted for
-                result = INSERT_NODE_NO_OP;
+                // Height changes ripple up the path the insert took
+                *target_entry = avl_tree_rebalance_entry(*target_entry);
             }
         }
     }
-    else if (new_node->key < (*target_node)->key)
+    return result;
+}
+
+// Unlinks the smallest entry of the subtree, rebalancing on the way back up
+static PAVL_TREE_ENTRY detach_min_entry(PAVL_TREE_ENTRY* target_entry)
+{
+    PAVL_TREE_ENTRY result;
+    if ((*target_entry)->left == NULL)
     {
-        if ((result = insert_into_tree(&(*target_node)->left, new_node)) != INSERT_NODE_FAILED)
+        result = *target_entry;
+        *target_entry = result->right;
+        if (result->right != NULL)
         {
-            // Increment the height
-            if ((*target_node)->height <= (*target_node)->left->height)
-            {
-                (*target_node)->height = (*target_node)->left->height + 1;
-            }
-
-            // If you inserted a direct child increment
-            // the balance factor
-            if (result == INSERT_NODE_INSERTED)
-            {
-                // Set parent node
-                (*target_node)->left->parent = *target_node;
-
-                // Only return inserted for
-                result = INSERT_NODE_NO_OP;
-            }
+            result->right->parent = result->parent;
         }
     }
-#else
-    int continue_run = 1;
-    result = INSERT_NODE_INSERTED;
-    if (*target_node == NULL)
+    else
     {
-        *target_node = new_node;
-        (*target_node)->height++;
+        result = detach_min_entry(&(*target_entry)->left);
+        *target_entry = avl_tree_rebalance_entry(*target_entry);
+    }
+    return result;
+}
+
+static int remove_node(BINARY_TREE_INFO* tree_info, PAVL_TREE_ENTRY* target_entry, const TREE_KEY* node_key, tree_remove_callback remove_callback)
+{
+    int result;
+    PAVL_TREE_ENTRY current_entry = *target_entry;
+    if (current_entry == NULL)
+    {
+        result = __LINE__;
     }
     else
     {
-        NODE_INFO* increment_node = NULL;
-        NODE_INFO* prev_node = NULL;
-        NODE_INFO* current_node = prev_node = *target_node;
-        do
+        NODE_INFO* current_node = get_node(current_entry);
+        int compare_value = compare_node_values(tree_info, node_key, &current_node->key);
+        if (compare_value < 0)
+        {
+            result = remove_node(tree_info, &current_entry->left, node_key, remove_callback);
+        }
+        else if (compare_value > 0)
         {
-            if (new_node->key > current_node->key)
+            result = remove_node(tree_info, &current_entry->right, node_key, remove_callback);
+        }
+        else
+        {
+            if (remove_callback != NULL)
             {
-                if (current_node->right == NULL)
-                {
-                    current_node->right = new_node;
-                    current_node->right->parent = current_node;
-                    current_node->right->height = 1;
-                    continue_run = 0;
-                    // If the current_node->left is NULL then increment height
-                    if (current_node->left == NULL)
-                    {
-                        increment_node = current_node->right;
-                    }
-                }
-                else
-                {
-                    prev_node = current_node;
-                    current_node = current_node->right;
-                }
+                remove_callback(current_node->data);
             }
-            else if (new_node->key < current_node->key)
+
+            if (current_entry->left == NULL || current_entry->right == NULL)
             {
-                if (current_node->left == NULL)
-                {
-                    current_node->left = new_node;
-                    current_node->left->parent = current_node;
-                    current_node->left->height = 1;
-                    continue_run = 0;
-                }
-                else
-                {
-                    prev_node = current_node;
-                    current_node = current_node->left;
-                }
-                // If the current_node->left is NULL then increment height
-                if (current_node->right == NULL)
+                // Zero or one child, the child moves up
+                PAVL_TREE_ENTRY child_entry = current_entry->left != NULL ? current_entry->left : current_entry->right;
+                if (child_entry != NULL)
                 {
-                    increment_node = current_node->left;
+                    child_entry->parent = current_entry->parent;
                 }
+                *target_entry = child_entry;
             }
             else
             {
-                // Failure
-                continue_run = 0;
-                result = INSERT_NODE_FAILED;
+                // Two children, the smallest entry of the right subtree takes its place
+                PAVL_TREE_ENTRY successor = detach_min_entry(&current_entry->right);
+                successor->left = current_entry->left;
+                successor->right = current_entry->right;
+                successor->parent = current_entry->parent;
+                successor->left->parent = successor;
+                if (successor->right != NULL)
+                {
+                    successor->right->parent = successor;
+                }
+                *target_entry = successor;
             }
-        } while (continue_run != 0);
-
+            release_node(tree_info, current_node);
+            result = 0;
+        }
 
-        if (increment_node != NULL)
+        if (result == 0 && *target_entry != NULL)
         {
-            NODE_INFO* parent_node = increment_node->parent;
-            // Go up the tree and increment height of parents
-            while (parent_node != NULL)
-            {
-                parent_node->height++;
-                parent_node = parent_node->parent;
-            }
+            *target_entry = avl_tree_rebalance_entry(*target_entry);
         }
     }
+    return result;
+}
 
-#endif
-    if (result != INSERT_NODE_FAILED)
+// Frees the subtree below entry, the caller frees the node holding entry
+static void clear_tree(PAVL_TREE_ENTRY entry)
+{
+    // Clear right
+    if (entry->right != NULL)
+    {
+        clear_tree(entry->right);
+        free(get_node(entry->right));
+    }
+    // Clear left
+    if (entry->left != NULL)
     {
-        // If a decendant has been added then calculate
-        // the balance factor by addition
-        (*target_node)->balance_factor = calculate_balance_factor(*target_node);
+        clear_tree(entry->left);
+        free(get_node(entry->left));
+    }
+}
+
+static int insert_node(BINARY_TREE_INFO* tree_info, NODE_INFO* new_node)
+{
+    return insert_into_tree(tree_info, &tree_info->tree_root.root_entry, NULL, new_node);
+}
 
-        if (rebalance_if_neccessary(*target_node) != 0)
+static int remove_node_key(BINARY_TREE_INFO* tree_info, const TREE_KEY* key, tree_remove_callback remove_callback)
+{
+    return remove_node(tree_info, &tree_info->tree_root.root_entry, key, remove_callback);
+}
+
+static void free_tree(PAVL_TREE_ENTRY entry)
+{
+    clear_tree(entry);
+    free(get_node(entry));
+}
+#else
+static NODE_INFO* find_node(const BINARY_TREE_INFO* tree_info, const AVL_TREE_ENTRY* entry, const TREE_KEY* value)
+{
+    NODE_INFO* result = NULL;
+    while (entry != NULL && result == NULL)
+    {
+        NODE_INFO* node_info = get_node(entry);
+        int compare_value = compare_node_values(tree_info, &node_info->key, value);
+        if (compare_value > 0)
+        {
+            entry = entry->left;
+        }
+        else if (compare_value < 0)
         {
-            result = INSERT_NODE_REBALANCE;
+            entry = entry->right;
+        }
+        else
+        {
+            result = node_info;
         }
     }
     return result;
 }
 
-static int remove_node(NODE_INFO** root_node, const NODE_KEY* node_key, tree_remove_callback remove_callback)
+// The search stays here because the keys are the tree's, linking
+// and rebalancing are left to avl_tree
+static int insert_node(BINARY_TREE_INFO* tree_info, NODE_INFO* new_node)
+{
+    int result = 0;
+    PAVL_TREE_ENTRY parent_entry = NULL;
+    PAVL_TREE_ENTRY* target_entry = &tree_info->tree_root.root_entry;
+    while (*target_entry != NULL)
+    {
+        int compare_value = compare_node_values(tree_info, &new_node->key, &get_node(*target_entry)->key);
+        if (compare_value == 0)
+        {
+            log_error("Key already exists in tree");
+            result = __LINE__;
+            break;
+        }
+        parent_entry = *target_entry;
+        target_entry = compare_value > 0 ? &parent_entry->right : &parent_entry->left;
+    }
+
+    if (result == 0)
+    {
+        avl_tree_link_entry(&tree_info->tree_root, parent_entry, target_entry, &new_node->entry);
+    }
+    return result;
+}
+
+static int remove_node_key(BINARY_TREE_INFO* tree_info, const TREE_KEY* key, tree_remove_callback remove_callback)
 {
     int result;
-    NODE_INFO* node_info = *root_node;
-    NODE_INFO* current_node = find_node(node_info, node_key);
+    NODE_INFO* current_node = find_node(tree_info, tree_info->tree_root.root_entry, key);
     if (current_node == NULL)
     {
         result = __LINE__;
     }
     else
     {
-        NODE_INFO* previous_node = current_node->parent;
-
         if (remove_callback != NULL)
         {
             remove_callback(current_node->data);
         }
-
-        // Remove the node
+        avl_tree_remove_entry(&tree_info->tree_root, &current_node->entry);
+        release_node(tree_info, current_node);
         result = 0;
-        // Does the node have a single child
-        if ((current_node->left != NULL && current_node->right == NULL) || (current_node->right != NULL && current_node->left == NULL))
+    }
+    return result;
+}
+
+// Frees children before their parents, climbing back up the parent
+// links instead of keeping a stack
+static void free_tree(PAVL_TREE_ENTRY entry)
+{
+    while (entry != NULL)
+    {
+        if (entry->left != NULL)
         {
-            // The right node is there
-            if (current_node->left == NULL && current_node->right != NULL)
-            {
-                // If previous_node's left tree equals Node n
-                if (previous_node->left == current_node)
-                {
-                    // then predecessor's left tree becomes n's right tree
-                    // and delete n
-                    previous_node->left = current_node->right;
-                    current_node->right->parent = previous_node;
-                    free(current_node);
-                    current_node = NULL;
-                    previous_node->balance_factor--;
-                }
-                // If predecessor's right tree equals Node n
-                else
-                {
-                    // then predecessor's right tree becomes n's right tree
-                    // and delete n
-                    previous_node->right = current_node->right;
-                    current_node->right->parent = previous_node;
-                    free(current_node);
-                    current_node = NULL;
-                    previous_node->balance_factor++;
-                }
-            }
-            else // Left node Present, No Right node Present
-            {
-                if (previous_node->left == current_node)
-                {
-                    previous_node->left = current_node->left;
-                    free(current_node);
-                    current_node = NULL;
-                    previous_node->balance_factor--;
-                }
-                else
-                {
-                    previous_node->right = current_node->left;
-                    current_node->left->parent = previous_node;
-                    free(current_node);
-                    current_node = NULL;
-                    previous_node->balance_factor++;
-                }
-            }
+            entry = entry->left;
         }
-        else if (current_node->left == NULL && current_node->right == NULL)
+        else if (entry->right != NULL)
         {
-            if (previous_node->left == current_node)
-            {
-                previous_node->left = NULL;
-                previous_node->balance_factor--;
-            }
-            else
-            {
-                previous_node->right = NULL;
-                previous_node->balance_factor++;
-            }
-            free(current_node);
+            entry = entry->right;
         }
-        // CASE 3: Node has two children
-        // Replace Node with smallest value in right subtree
-        else if (current_node->left != NULL && current_node->right != NULL)
+        else
         {
-            // If the node's right child has a left child
-            // Move all the way down left to locate smallest element
-            if ((current_node->right)->left != NULL)
-            {
-                NODE_INFO* left_current;
-                NODE_INFO* left_current_prev;
-                left_current_prev = current_node->right;
-                left_current = (current_node->right)->left;
-                while (left_current->left != NULL)
-                {
-                    left_current_prev = left_current;
-                    left_current = left_current->left;
-                }
-                current_node->data = left_current->data;
-                free(left_current);
-                left_current_prev->left = NULL;
-            }
-            else
+            PAVL_TREE_ENTRY parent_entry = entry->parent;
+            if (parent_entry != NULL)
             {
-                NODE_INFO* temp = current_node;
-                if (temp->parent == NULL)
+                if (parent_entry->left == entry)
                 {
-                    // deleting the root
-                    // Find the min key in the right subtree
-                    NODE_INFO* min_node;
-                    NODE_INFO* observe_node = min_node = temp->right->left;
-                    if (observe_node == NULL)
-                    {
-                        min_node = temp->right;
-                    }
-                    else
-                    {
-                        do
-                        {
-                            if (observe_node->key < min_node->key)
-                            {
-                                min_node = observe_node;
-                            }
-                            observe_node = observe_node->left;
-                        } while (observe_node != NULL);
-                    }
-                    if (min_node->right != NULL)
-                    {
-                        // Exchange the min_node->right with min_node
-                        if (min_node->parent != current_node)
-                        {
-                            min_node->parent->left = min_node->right;
-                        }
-                        min_node->right->parent = min_node->parent;
-                        min_node->right->height = min_node->height;
-                    }
-                    else if (min_node->parent != current_node && min_node->parent->left != NULL)
-                    {
-                        min_node->parent->left = NULL;
-                    }
-                    min_node->parent = NULL;
-                    min_node->height = current_node->height;
-                    if (current_node->right != NULL && min_node != current_node->right)
-                    {
-                        min_node->right = current_node->right;
-                        current_node->right->parent = min_node;
-                    }
-                    if (current_node->left != NULL && min_node != current_node->left)
-                    {
-                        min_node->left = current_node->left;
-                        current_node->left->parent = min_node;
-                    }
-                    *root_node = min_node;
-                    free(current_node);
+                    parent_entry->left = NULL;
                 }
                 else
                 {
-                    // Find the parent node that points to this
-                    // and change it
-                    if (temp->parent->right == temp)
-                    {
-                        temp->parent->right = temp->right;
-                        temp->parent->balance_factor--;
-                    }
-                    else
-                    {
-                        temp->parent->left = temp->right;
-                        temp->parent->balance_factor++;
-                    }
-                    current_node->right->parent = temp->parent;
-                    current_node->right->left = temp->left;
-                    current_node = temp->right;
-                    current_node->balance_factor--;
-                    //current_node->parent = current_node->parent;
-                    free(temp);
+                    parent_entry->right = NULL;
                 }
             }
+            free(get_node(entry));
+            entry = parent_entry;
         }
     }
+}
+#endif
+
+static int insert_tree_key(BINARY_TREE_INFO* tree_info, const TREE_KEY* key, void* data)
+{
+    int result;
+    NODE_INFO* new_node = create_new_node(tree_info, key, data);
+    if (new_node == NULL)
+    {
+        log_error("FAILURE: Creating new node on insert");
+        result = __LINE__;
+    }
+    else if (insert_node(tree_info, new_node) != 0)
+    {
+        log_error("FAILURE: Inserting new node");
+        release_node(tree_info, new_node);
+        result = __LINE__;
+    }
+    else
+    {
+        tree_info->items++;
+        result = 0;
+    }
     return result;
 }
 
-static void clear_tree(NODE_INFO* node_info)
+static int remove_tree_key(BINARY_TREE_INFO* tree_info, const TREE_KEY* key, tree_remove_callback remove_callback)
 {
-#ifdef USE_RECURSION
-    // Clear right
-    if (node_info->right != NULL)
+    int result = remove_node_key(tree_info, key, remove_callback);
+    if (result == 0)
     {
-        clear_tree(node_info->right);
-        free(node_info->right);
+        tree_info->items--;
     }
-    // Clear left
-    if (node_info->left != NULL)
+    return result;
+}
+
+static void* find_tree_key(const BINARY_TREE_INFO* tree_info, const TREE_KEY* key)
+{
+    void* result;
+    const NODE_INFO* node_info = find_node(tree_info, tree_info->tree_root.root_entry, key);
+    if (node_info == NULL)
     {
-        clear_tree(node_info->left);
-        free(node_info->left);
+        log_debug("Item Not found");
+        result = NULL;
     }
-#else
-    NODE_INFO* target_node = node_info;
-    NODE_INFO* previous_node = NULL;
+    else
+    {
+        result = node_info->data;
+    }
+    return result;
+}
 
-    while (target_node != NULL)
+// The node with the smallest key >= key, remembering the last node
+// the walk went left from
+static NODE_INFO* lower_bound_node(const BINARY_TREE_INFO* tree_info, const TREE_KEY* key)
+{
+    NODE_INFO* result = NULL;
+    const AVL_TREE_ENTRY* entry = tree_info->tree_root.root_entry;
+    while (entry != NULL)
     {
-        if (target_node->left == NULL)
+        NODE_INFO* node_info = get_node(entry);
+        if (compare_node_values(tree_info, &node_info->key, key) >= 0)
         {
-            target_node = target_node->right;
+            result = node_info;
+            entry = entry->left;
         }
         else
         {
-            // Find the inorder predecessor of current
-            previous_node = target_node->left;
-            while (previous_node->right != NULL && previous_node->right != target_node)
-            {
-                previous_node = previous_node->right;
-            }
+            entry = entry->right;
+        }
+    }
+    return result;
+}
 
-            // Make current as right child of its inorder predecessor
-            if (previous_node->right == NULL)
-            {
-                previous_node->right = target_node;
-                target_node = target_node->left;
-            }
-            // Revert the changes made in if part to restore the original
-            // tree i.e., fix the right child of predecssor
-            else
-            {
-                previous_node->right = NULL;
-                target_node = target_node->right;
-            }
+static void* iterate_next_node(BINARY_TREE_ITERATOR* iterator, TREE_KEY* key)
+{
+    void* result;
+    NODE_INFO* node_info = (NODE_INFO*)iterator->node;
+    if (node_info == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        *key = node_info->key;
+        result = node_info->data;
+        iterator->node = get_node(avl_tree_next(&node_info->entry));
+    }
+    return result;
+}
+
+static void visit_tree_range(const BINARY_TREE_INFO* tree_info, const TREE_KEY* start, const TREE_KEY* end, BINARY_TREE_VISIT visit_cb, void* user_ctx)
+{
+    NODE_INFO* node_info = lower_bound_node(tree_info, start);
+    while (node_info != NULL && compare_node_values(tree_info, &node_info->key, end) < 0)
+    {
+        if (visit_cb(user_ctx, node_info->data) != 0)
+        {
+            break;
         }
+        node_info = get_node(avl_tree_next(&node_info->entry));
     }
-#endif
 }
 
 BINARY_TREE_HANDLE binary_tree_create()
 {
-    BINARY_TREE_INFO* result = (BINARY_TREE_INFO*)malloc(sizeof(BINARY_TREE_INFO));
-    if (result == NULL)
+    return binary_tree_create_with_options(BINARY_TREE_OPTION_NONE, 0, NULL);
+}
+
+BINARY_TREE_HANDLE binary_tree_create_with_compare(BINARY_TREE_COMPARE compare_cb)
+{
+    BINARY_TREE_INFO* result;
+    if (compare_cb == NULL)
     {
-        log_error("FAILURE: unable to allocate Binary tree info");
+        log_error("FAILURE: Invalid compare callback specified on create");
         result = NULL;
     }
     else
+    {
+        result = binary_tree_create_with_options(BINARY_TREE_OPTION_NONE, 0, compare_cb);
+    }
+    return result;
+}
+
+BINARY_TREE_HANDLE binary_tree_create_with_options(uint32_t options, size_t capacity, BINARY_TREE_COMPARE compare_cb)
+{
+    BINARY_TREE_INFO* result;
+    if ((result = (BINARY_TREE_INFO*)malloc(sizeof(BINARY_TREE_INFO))) == NULL)
+    {
+        log_error("FAILURE: unable to allocate Binary tree info");
+    }
+    else
     {
         memset(result, 0, sizeof(BINARY_TREE_INFO));
+        result->options = options;
+        result->compare_cb = compare_cb;
+        avl_tree_init(&result->tree_root, NULL);
+        node_pool_init(&result->node_pool, sizeof(NODE_INFO), offsetof(NODE_INFO, entry.right));
+        if (capacity > 0 && (options & BINARY_TREE_OPTION_NODE_POOL))
+        {
+            if (node_pool_reserve(&result->node_pool, capacity) != 0)
+            {
+                log_error("FAILURE: unable to preallocate tree nodes");
+                free(result);
+                result = NULL;
+            }
+        }
     }
     return result;
 }
@@ -677,10 +647,14 @@ void binary_tree_destroy(BINARY_TREE_HANDLE handle)
 {
     if (handle != NULL)
     {
-        if (handle->root_node != NULL)
+        // Pooled nodes all go with their slabs, no need to walk the tree
+        if (handle->options & BINARY_TREE_OPTION_NODE_POOL)
+        {
+            node_pool_deinit(&handle->node_pool);
+        }
+        else if (handle->tree_root.root_entry != NULL)
         {
-            clear_tree(handle->root_node);
-            free(handle->root_node);
+            free_tree(handle->tree_root.root_entry);
         }
         free(handle);
     }
@@ -694,47 +668,82 @@ int binary_tree_insert(BINARY_TREE_HANDLE handle, NODE_KEY value, void* data)
         log_error("FAILURE: Invalid handle specified on insert");
         result = __LINE__;
     }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_insert_key");
+        result = __LINE__;
+    }
     else
     {
-        size_t current_height = 0;
-        NODE_INFO* new_node = create_new_node(value, data);
-        if (new_node == NULL)
-        {
-            log_error("FAILURE: Creating new node on insert");
-            result = __LINE__;
-        }
-        else if (insert_into_tree(&handle->root_node, new_node) == INSERT_NODE_FAILED)
-        {
-            log_error("FAILURE: Inserting new node");
-            free(new_node);
-            result = __LINE__;
-        }
-        else
-        {
-            handle->height = current_height;
-            handle->items++;
-            result = 0;
-        }
+        TREE_KEY key;
+        key.value = value;
+        result = insert_tree_key(handle, &key, data);
+    }
+    return result;
+}
+
+int binary_tree_insert_key(BINARY_TREE_HANDLE handle, const void* key, void* data)
+{
+    int result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on insert handle: %p, key: %p", handle, key);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_insert");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY tree_key;
+        tree_key.user_key = key;
+        result = insert_tree_key(handle, &tree_key, data);
     }
     return result;
 }
 
 int binary_tree_remove(BINARY_TREE_HANDLE handle, NODE_KEY value, tree_remove_callback remove_callback)
 {
-    (void)value;
     int result;
     if (handle == NULL)
     {
         log_error("FAILURE: Invalid handle specified on remove");
         result = __LINE__;
     }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_remove_key");
+        result = __LINE__;
+    }
     else
     {
-        result = remove_node(&handle->root_node, &value, remove_callback);
-        if (result == 0)
-        {
-            handle->items-- ;
-        }
+        TREE_KEY key;
+        key.value = value;
+        result = remove_tree_key(handle, &key, remove_callback);
+    }
+    return result;
+}
+
+int binary_tree_remove_key(BINARY_TREE_HANDLE handle, const void* key, tree_remove_callback remove_callback)
+{
+    int result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on remove handle: %p, key: %p", handle, key);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_remove");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY tree_key;
+        tree_key.user_key = key;
+        result = remove_tree_key(handle, &tree_key, remove_callback);
     }
     return result;
 }
@@ -747,22 +756,202 @@ void* binary_tree_find(BINARY_TREE_HANDLE handle, NODE_KEY find_value)
         log_error("FAILURE: Invalid handle specified on find");
         result = NULL;
     }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_find_key");
+        result = NULL;
+    }
     else
     {
-        const NODE_INFO* node_info = find_node(handle->root_node, &find_value);
-        if (node_info == NULL)
+        TREE_KEY key;
+        key.value = find_value;
+        result = find_tree_key(handle, &key);
+    }
+    return result;
+}
+
+void* binary_tree_find_key(BINARY_TREE_HANDLE handle, const void* key)
+{
+    void* result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on find handle: %p, key: %p", handle, key);
+        result = NULL;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_find");
+        result = NULL;
+    }
+    else
+    {
+        TREE_KEY tree_key;
+        tree_key.user_key = key;
+        result = find_tree_key(handle, &tree_key);
+    }
+    return result;
+}
+
+int binary_tree_iterator_init(BINARY_TREE_HANDLE handle, BINARY_TREE_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on iterator init handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        iterator->node = get_node(avl_tree_first(&handle->tree_root));
+        result = 0;
+    }
+    return result;
+}
+
+int binary_tree_lower_bound(BINARY_TREE_HANDLE handle, NODE_KEY value, BINARY_TREE_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on lower bound handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_lower_bound_key");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY key;
+        key.value = value;
+        iterator->node = lower_bound_node(handle, &key);
+        result = 0;
+    }
+    return result;
+}
+
+int binary_tree_lower_bound_key(BINARY_TREE_HANDLE handle, const void* key, BINARY_TREE_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || key == NULL || iterator == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on lower bound handle: %p, key: %p, iterator: %p", handle, key, iterator);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_lower_bound");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY tree_key;
+        tree_key.user_key = key;
+        iterator->node = lower_bound_node(handle, &tree_key);
+        result = 0;
+    }
+    return result;
+}
+
+void* binary_tree_iterator_next(BINARY_TREE_HANDLE handle, BINARY_TREE_ITERATOR* iterator, NODE_KEY* value)
+{
+    void* result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on iterator next handle: %p, iterator: %p", handle, iterator);
+        result = NULL;
+    }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_iterator_next_key");
+        result = NULL;
+    }
+    else
+    {
+        TREE_KEY key;
+        if ((result = iterate_next_node(iterator, &key)) != NULL && value != NULL)
         {
-            log_debug("Item Not found");
-            result = NULL;
+            *value = key.value;
         }
-        else
+    }
+    return result;
+}
+
+void* binary_tree_iterator_next_key(BINARY_TREE_HANDLE handle, BINARY_TREE_ITERATOR* iterator, const void** key)
+{
+    void* result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on iterator next handle: %p, iterator: %p", handle, iterator);
+        result = NULL;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_iterator_next");
+        result = NULL;
+    }
+    else
+    {
+        TREE_KEY tree_key;
+        if ((result = iterate_next_node(iterator, &tree_key)) != NULL && key != NULL)
         {
-            result = node_info->data;
+            *key = tree_key.user_key;
         }
     }
     return result;
 }
 
+int binary_tree_range_for_each(BINARY_TREE_HANDLE handle, NODE_KEY start, NODE_KEY end, BINARY_TREE_VISIT visit_cb, void* user_ctx)
+{
+    int result;
+    if (handle == NULL || visit_cb == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on range for each handle: %p", handle);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb != NULL)
+    {
+        log_error("FAILURE: Tree uses compare keys, use binary_tree_range_for_each_key");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY start_key;
+        TREE_KEY end_key;
+        start_key.value = start;
+        end_key.value = end;
+        visit_tree_range(handle, &start_key, &end_key, visit_cb, user_ctx);
+        result = 0;
+    }
+    return result;
+}
+
+int binary_tree_range_for_each_key(BINARY_TREE_HANDLE handle, const void* start, const void* end, BINARY_TREE_VISIT visit_cb, void* user_ctx)
+{
+    int result;
+    if (handle == NULL || start == NULL || end == NULL || visit_cb == NULL)
+    {
+        log_error("FAILURE: Invalid parameter specified on range for each handle: %p, start: %p, end: %p", handle, start, end);
+        result = __LINE__;
+    }
+    else if (handle->compare_cb == NULL)
+    {
+        log_error("FAILURE: Tree uses NODE_KEY values, use binary_tree_range_for_each");
+        result = __LINE__;
+    }
+    else
+    {
+        TREE_KEY start_key;
+        TREE_KEY end_key;
+        start_key.user_key = start;
+        end_key.user_key = end;
+        visit_tree_range(handle, &start_key, &end_key, visit_cb, user_ctx);
+        result = 0;
+    }
+    return result;
+}
+
 size_t binary_tree_item_count(BINARY_TREE_HANDLE handle)
 {
     size_t result;
@@ -788,7 +977,7 @@ size_t binary_tree_height(BINARY_TREE_HANDLE handle)
     }
     else
     {
-        result = handle->root_node->height;
+        result = avl_tree_height(&handle->tree_root);
     }
     return result;
 }
@@ -801,7 +990,7 @@ void binary_tree_print(BINARY_TREE_HANDLE handle)
     }
     else
     {
-        print_tree(handle->root_node, 0);
+        print_tree(handle, handle->tree_root.root_entry, 0);
     }
 }
 
@@ -821,7 +1010,7 @@ char* binary_tree_construct_visual(BINARY_TREE_HANDLE handle)
             size_t len = (handle->items*NUM_OF_CHARS) + (handle->items * 2);
             result = (char*)malloc(len + 1);
             memset(result, 0, len + 1);
-            construct_visual_representation(handle->root_node, result, 0);
+            construct_visual_representation(handle, handle->tree_root.root_entry, result, 0);
         }
         else
         {
@@ -0,0 +1,812 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/bplus_tree.h"
+
+// Sixteen keys fill two cache lines so a search scans them without
+// chasing pointers, nodes other than the root hold at least half
+#define NODE_KEYS               16
+#define MIN_KEYS                (NODE_KEYS/2)
+// Enough levels for 2^64 keys at the minimum fan out
+#define MAX_TREE_HEIGHT         24
+
+typedef struct LEAF_ENTRIES_TAG
+{
+    void* values[NODE_KEYS];
+    struct TREE_NODE_TAG* next;
+} LEAF_ENTRIES;
+
+// Leaves and inner nodes share one layout so the nodes reserved
+// for an insert can become either
+typedef struct TREE_NODE_TAG
+{
+    // Packed at the front so a search only touches the key lines
+    uint64_t keys[NODE_KEYS];
+    uint32_t key_count;
+    uint32_t is_leaf;
+    union
+    {
+        LEAF_ENTRIES leaf;
+        // children[i] holds keys below keys[i], children[i + 1] the rest
+        struct TREE_NODE_TAG* children[NODE_KEYS + 1];
+    } link;
+} TREE_NODE;
+
+typedef struct BPLUS_TREE_INFO_TAG
+{
+    TREE_NODE* root_node;
+    size_t items;
+    size_t height;
+    BPLUS_TREE_DESTROY_ITEM destroy_cb;
+    void* user_ctx;
+} BPLUS_TREE_INFO;
+
+// Nodes allocated up front for the splits an insert will need
+typedef struct SPARE_NODES_TAG
+{
+    TREE_NODE* nodes[MAX_TREE_HEIGHT + 1];
+    size_t count;
+} SPARE_NODES;
+
+// Reported to the parent when a child splits
+typedef struct NODE_SPLIT_TAG
+{
+    TREE_NODE* right_node;
+    uint64_t key;
+} NODE_SPLIT;
+
+static TREE_NODE* allocate_node(bool is_leaf)
+{
+    TREE_NODE* result;
+    if ((result = (TREE_NODE*)malloc(sizeof(TREE_NODE))) == NULL)
+    {
+        log_error("Failure allocating tree node");
+    }
+    else
+    {
+        result->key_count = 0;
+        result->is_leaf = is_leaf ? 1 : 0;
+        result->link.leaf.next = NULL;
+    }
+    return result;
+}
+
+static TREE_NODE* take_spare_node(SPARE_NODES* spare_nodes, bool is_leaf)
+{
+    TREE_NODE* result = spare_nodes->nodes[--spare_nodes->count];
+    result->key_count = 0;
+    result->is_leaf = is_leaf ? 1 : 0;
+    result->link.leaf.next = NULL;
+    return result;
+}
+
+static void free_spare_nodes(SPARE_NODES* spare_nodes)
+{
+    while (spare_nodes->count > 0)
+    {
+        free(spare_nodes->nodes[--spare_nodes->count]);
+    }
+}
+
+static void free_nodes(BPLUS_TREE_INFO* tree_info, TREE_NODE* node)
+{
+    if (node->is_leaf)
+    {
+        if (tree_info->destroy_cb != NULL)
+        {
+            for (uint32_t index = 0; index < node->key_count; index++)
+            {
+                tree_info->destroy_cb(tree_info->user_ctx, node->link.leaf.values[index]);
+            }
+        }
+    }
+    else
+    {
+        for (uint32_t index = 0; index <= node->key_count; index++)
+        {
+            free_nodes(tree_info, node->link.children[index]);
+        }
+    }
+    free(node);
+}
+
+// The number of keys below key, a branch free count the compiler can
+// vectorize and that is as quick as a binary search at this width
+static uint32_t count_keys_below(const TREE_NODE* node, uint64_t key)
+{
+    uint32_t result = 0;
+    for (uint32_t index = 0; index < node->key_count; index++)
+    {
+        result += node->keys[index] < key ? 1 : 0;
+    }
+    return result;
+}
+
+static uint32_t count_keys_not_above(const TREE_NODE* node, uint64_t key)
+{
+    uint32_t result = 0;
+    for (uint32_t index = 0; index < node->key_count; index++)
+    {
+        result += node->keys[index] <= key ? 1 : 0;
+    }
+    return result;
+}
+
+static TREE_NODE* find_leaf(const BPLUS_TREE_INFO* tree_info, uint64_t key)
+{
+    TREE_NODE* result = tree_info->root_node;
+    while (result != NULL && !result->is_leaf)
+    {
+        result = result->link.children[count_keys_not_above(result, key)];
+    }
+    return result;
+}
+
+// Every full node from the leaf up splits, and the root needs a new
+// parent when it splits too
+static size_t count_path_splits(const BPLUS_TREE_INFO* tree_info, uint64_t key)
+{
+    size_t result = 0;
+    const TREE_NODE* node = tree_info->root_node;
+    while (node != NULL)
+    {
+        result = node->key_count == NODE_KEYS ? result + 1 : 0;
+        node = node->is_leaf ? NULL : node->link.children[count_keys_not_above(node, key)];
+    }
+    return result == tree_info->height ? result + 1 : result;
+}
+
+static int insert_into_leaf(TREE_NODE* node, uint64_t key, void* value, SPARE_NODES* spare_nodes, NODE_SPLIT* split)
+{
+    int result;
+    uint32_t position = count_keys_below(node, key);
+    if (position < node->key_count && node->keys[position] == key)
+    {
+        log_error("Key already exists in tree");
+        result = __LINE__;
+    }
+    else if (node->key_count < NODE_KEYS)
+    {
+        memmove(&node->keys[position + 1], &node->keys[position], (node->key_count - position)*sizeof(uint64_t));
+        memmove(&node->link.leaf.values[position + 1], &node->link.leaf.values[position], (node->key_count - position)*sizeof(void*));
+        node->keys[position] = key;
+        node->link.leaf.values[position] = value;
+        node->key_count++;
+        result = 0;
+    }
+    else
+    {
+        // Lay out all NODE_KEYS + 1 entries then deal them out to the two leaves
+        uint64_t keys[NODE_KEYS + 1];
+        void* values[NODE_KEYS + 1];
+        TREE_NODE* right_node = take_spare_node(spare_nodes, true);
+        uint32_t left_count = (NODE_KEYS + 1)/2;
+
+        memcpy(keys, node->keys, position*sizeof(uint64_t));
+        memcpy(values, node->link.leaf.values, position*sizeof(void*));
+        keys[position] = key;
+        values[position] = value;
+        memcpy(&keys[position + 1], &node->keys[position], (NODE_KEYS - position)*sizeof(uint64_t));
+        memcpy(&values[position + 1], &node->link.leaf.values[position], (NODE_KEYS - position)*sizeof(void*));
+
+        memcpy(node->keys, keys, left_count*sizeof(uint64_t));
+        memcpy(node->link.leaf.values, values, left_count*sizeof(void*));
+        node->key_count = left_count;
+        memcpy(right_node->keys, &keys[left_count], (NODE_KEYS + 1 - left_count)*sizeof(uint64_t));
+        memcpy(right_node->link.leaf.values, &values[left_count], (NODE_KEYS + 1 - left_count)*sizeof(void*));
+        right_node->key_count = NODE_KEYS + 1 - left_count;
+
+        right_node->link.leaf.next = node->link.leaf.next;
+        node->link.leaf.next = right_node;
+        split->right_node = right_node;
+        split->key = right_node->keys[0];
+        result = 0;
+    }
+    return result;
+}
+
+static void insert_into_inner(TREE_NODE* node, uint32_t position, const NODE_SPLIT* child_split, SPARE_NODES* spare_nodes, NODE_SPLIT* split)
+{
+    if (node->key_count < NODE_KEYS)
+    {
+        memmove(&node->keys[position + 1], &node->keys[position], (node->key_count - position)*sizeof(uint64_t));
+        memmove(&node->link.children[position + 2], &node->link.children[position + 1], (node->key_count - position)*sizeof(TREE_NODE*));
+        node->keys[position] = child_split->key;
+        node->link.children[position + 1] = child_split->right_node;
+        node->key_count++;
+    }
+    else
+    {
+        // The middle key moves up to the parent instead of being copied
+        uint64_t keys[NODE_KEYS + 1];
+        TREE_NODE* children[NODE_KEYS + 2];
+        TREE_NODE* right_node = take_spare_node(spare_nodes, false);
+        uint32_t left_count = NODE_KEYS/2;
+
+        memcpy(keys, node->keys, position*sizeof(uint64_t));
+        keys[position] = child_split->key;
+        memcpy(&keys[position + 1], &node->keys[position], (NODE_KEYS - position)*sizeof(uint64_t));
+        memcpy(children, node->link.children, (position + 1)*sizeof(TREE_NODE*));
+        children[position + 1] = child_split->right_node;
+        memcpy(&children[position + 2], &node->link.children[position + 1], (NODE_KEYS - position)*sizeof(TREE_NODE*));
+
+        memcpy(node->keys, keys, left_count*sizeof(uint64_t));
+        memcpy(node->link.children, children, (left_count + 1)*sizeof(TREE_NODE*));
+        node->key_count = left_count;
+        memcpy(right_node->keys, &keys[left_count + 1], (NODE_KEYS - left_count)*sizeof(uint64_t));
+        memcpy(right_node->link.children, &children[left_count + 1], (NODE_KEYS - left_count + 1)*sizeof(TREE_NODE*));
+        right_node->key_count = NODE_KEYS - left_count;
+
+        split->right_node = right_node;
+        split->key = keys[left_count];
+    }
+}
+
+static int insert_into_node(TREE_NODE* node, uint64_t key, void* value, SPARE_NODES* spare_nodes, NODE_SPLIT* split)
+{
+    int result;
+    if (node->is_leaf)
+    {
+        result = insert_into_leaf(node, key, value, spare_nodes, split);
+    }
+    else
+    {
+        NODE_SPLIT child_split = { NULL, 0 };
+        uint32_t position = count_keys_not_above(node, key);
+        if ((result = insert_into_node(node->link.children[position], key, value, spare_nodes, &child_split)) == 0 &&
+            child_split.right_node != NULL)
+        {
+            insert_into_inner(node, position, &child_split, spare_nodes, split);
+        }
+    }
+    return result;
+}
+
+static void remove_key_at(TREE_NODE* node, uint32_t position)
+{
+    memmove(&node->keys[position], &node->keys[position + 1], (node->key_count - position - 1)*sizeof(uint64_t));
+    if (node->is_leaf)
+    {
+        memmove(&node->link.leaf.values[position], &node->link.leaf.values[position + 1], (node->key_count - position - 1)*sizeof(void*));
+    }
+    else
+    {
+        memmove(&node->link.children[position + 1], &node->link.children[position + 2], (node->key_count - position - 1)*sizeof(TREE_NODE*));
+    }
+    node->key_count--;
+}
+
+static void borrow_from_left(TREE_NODE* parent_node, uint32_t child_index)
+{
+    TREE_NODE* child_node = parent_node->link.children[child_index];
+    TREE_NODE* left_node = parent_node->link.children[child_index - 1];
+    memmove(&child_node->keys[1], &child_node->keys[0], child_node->key_count*sizeof(uint64_t));
+    if (child_node->is_leaf)
+    {
+        memmove(&child_node->link.leaf.values[1], &child_node->link.leaf.values[0], child_node->key_count*sizeof(void*));
+        child_node->keys[0] = left_node->keys[left_node->key_count - 1];
+        child_node->link.leaf.values[0] = left_node->link.leaf.values[left_node->key_count - 1];
+        parent_node->keys[child_index - 1] = child_node->keys[0];
+    }
+    else
+    {
+        // Rotate through the parent, its separator comes down
+        memmove(&child_node->link.children[1], &child_node->link.children[0], (child_node->key_count + 1)*sizeof(TREE_NODE*));
+        child_node->keys[0] = parent_node->keys[child_index - 1];
+        child_node->link.children[0] = left_node->link.children[left_node->key_count];
+        parent_node->keys[child_index - 1] = left_node->keys[left_node->key_count - 1];
+    }
+    child_node->key_count++;
+    left_node->key_count--;
+}
+
+static void borrow_from_right(TREE_NODE* parent_node, uint32_t child_index)
+{
+    TREE_NODE* child_node = parent_node->link.children[child_index];
+    TREE_NODE* right_node = parent_node->link.children[child_index + 1];
+    if (child_node->is_leaf)
+    {
+        child_node->keys[child_node->key_count] = right_node->keys[0];
+        child_node->link.leaf.values[child_node->key_count] = right_node->link.leaf.values[0];
+        memmove(&right_node->link.leaf.values[0], &right_node->link.leaf.values[1], (right_node->key_count - 1)*sizeof(void*));
+        memmove(&right_node->keys[0], &right_node->keys[1], (right_node->key_count - 1)*sizeof(uint64_t));
+        parent_node->keys[child_index] = right_node->keys[0];
+    }
+    else
+    {
+        child_node->keys[child_node->key_count] = parent_node->keys[child_index];
+        child_node->link.children[child_node->key_count + 1] = right_node->link.children[0];
+        parent_node->keys[child_index] = right_node->keys[0];
+        memmove(&right_node->link.children[0], &right_node->link.children[1], right_node->key_count*sizeof(TREE_NODE*));
+        memmove(&right_node->keys[0], &right_node->keys[1], (right_node->key_count - 1)*sizeof(uint64_t));
+    }
+    child_node->key_count++;
+    right_node->key_count--;
+}
+
+// Folds children[index + 1] into children[index] and drops their separator
+static void merge_children(TREE_NODE* parent_node, uint32_t index)
+{
+    TREE_NODE* left_node = parent_node->link.children[index];
+    TREE_NODE* right_node = parent_node->link.children[index + 1];
+    if (left_node->is_leaf)
+    {
+        memcpy(&left_node->keys[left_node->key_count], right_node->keys, right_node->key_count*sizeof(uint64_t));
+        memcpy(&left_node->link.leaf.values[left_node->key_count], right_node->link.leaf.values, right_node->key_count*sizeof(void*));
+        left_node->key_count += right_node->key_count;
+        left_node->link.leaf.next = right_node->link.leaf.next;
+    }
+    else
+    {
+        left_node->keys[left_node->key_count] = parent_node->keys[index];
+        memcpy(&left_node->keys[left_node->key_count + 1], right_node->keys, right_node->key_count*sizeof(uint64_t));
+        memcpy(&left_node->link.children[left_node->key_count + 1], right_node->link.children, (right_node->key_count + 1)*sizeof(TREE_NODE*));
+        left_node->key_count += right_node->key_count + 1;
+    }
+    free(right_node);
+    remove_key_at(parent_node, index);
+}
+
+static void fix_underflow(TREE_NODE* parent_node, uint32_t child_index)
+{
+    TREE_NODE* left_node = child_index > 0 ? parent_node->link.children[child_index - 1] : NULL;
+    TREE_NODE* right_node = child_index < parent_node->key_count ? parent_node->link.children[child_index + 1] : NULL;
+    if (left_node != NULL && left_node->key_count > MIN_KEYS)
+    {
+        borrow_from_left(parent_node, child_index);
+    }
+    else if (right_node != NULL && right_node->key_count > MIN_KEYS)
+    {
+        borrow_from_right(parent_node, child_index);
+    }
+    else if (left_node != NULL)
+    {
+        merge_children(parent_node, child_index - 1);
+    }
+    else
+    {
+        merge_children(parent_node, child_index);
+    }
+}
+
+static int remove_from_node(TREE_NODE* node, uint64_t key, void** value)
+{
+    int result;
+    if (node->is_leaf)
+    {
+        uint32_t position = count_keys_below(node, key);
+        if (position == node->key_count || node->keys[position] != key)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            if (value != NULL)
+            {
+                *value = node->link.leaf.values[position];
+            }
+            remove_key_at(node, position);
+            result = 0;
+        }
+    }
+    else
+    {
+        // Separators may keep the value of a removed key, they
+        // still divide the children correctly
+        uint32_t position = count_keys_not_above(node, key);
+        if ((result = remove_from_node(node->link.children[position], key, value)) == 0 &&
+            node->link.children[position]->key_count < MIN_KEYS)
+        {
+            fix_underflow(node, position);
+        }
+    }
+    return result;
+}
+
+static void position_iterator(const BPLUS_TREE_INFO* tree_info, uint64_t key, bool include_key, BPLUS_TREE_ITERATOR* iterator)
+{
+    TREE_NODE* leaf_node = find_leaf(tree_info, key);
+    iterator->leaf = leaf_node;
+    iterator->index = leaf_node == NULL ? 0 : (include_key ? count_keys_below(leaf_node, key) : count_keys_not_above(leaf_node, key));
+}
+
+// Builds one level above nodes, dealing the nodes out evenly so every
+// parent gets at least MIN_KEYS + 1 children
+static int build_parent_level(TREE_NODE** nodes, uint64_t* min_keys, size_t* node_count)
+{
+    int result = 0;
+    size_t parent_count = (*node_count + NODE_KEYS) / (NODE_KEYS + 1);
+    size_t node_index = 0;
+    for (size_t parent_index = 0; parent_index < parent_count; parent_index++)
+    {
+        size_t child_count = (*node_count / parent_count) + (parent_index < *node_count % parent_count ? 1 : 0);
+        TREE_NODE* parent_node = allocate_node(false);
+        if (parent_node == NULL)
+        {
+            // Hand back the children that haven't been attached yet,
+            // the attached ones go with the parents already built
+            result = __LINE__;
+            memmove(&nodes[parent_index], &nodes[node_index], (*node_count - node_index)*sizeof(TREE_NODE*));
+            *node_count = parent_index + (*node_count - node_index);
+            break;
+        }
+        parent_node->link.children[0] = nodes[node_index];
+        for (size_t child_index = 1; child_index < child_count; child_index++)
+        {
+            parent_node->keys[child_index - 1] = min_keys[node_index + child_index];
+            parent_node->link.children[child_index] = nodes[node_index + child_index];
+        }
+        parent_node->key_count = (uint32_t)(child_count - 1);
+        min_keys[parent_index] = min_keys[node_index];
+        nodes[parent_index] = parent_node;
+        node_index += child_count;
+    }
+    if (result == 0)
+    {
+        *node_count = parent_count;
+    }
+    return result;
+}
+
+static int build_leaf_level(const uint64_t* keys, void** values, size_t count, TREE_NODE** nodes, uint64_t* min_keys, size_t* leaf_count)
+{
+    int result = 0;
+    size_t target_count = (count + NODE_KEYS - 1) / NODE_KEYS;
+    size_t key_index = 0;
+    TREE_NODE* prev_leaf = NULL;
+    for (*leaf_count = 0; *leaf_count < target_count; (*leaf_count)++)
+    {
+        size_t entry_count = (count / target_count) + (*leaf_count < count % target_count ? 1 : 0);
+        TREE_NODE* leaf_node = allocate_node(true);
+        if (leaf_node == NULL)
+        {
+            result = __LINE__;
+            break;
+        }
+        memcpy(leaf_node->keys, &keys[key_index], entry_count*sizeof(uint64_t));
+        memcpy(leaf_node->link.leaf.values, &values[key_index], entry_count*sizeof(void*));
+        leaf_node->key_count = (uint32_t)entry_count;
+        if (prev_leaf != NULL)
+        {
+            prev_leaf->link.leaf.next = leaf_node;
+        }
+        prev_leaf = leaf_node;
+        nodes[*leaf_count] = leaf_node;
+        min_keys[*leaf_count] = keys[key_index];
+        key_index += entry_count;
+    }
+    return result;
+}
+
+BPLUS_TREE_HANDLE bplus_tree_create(BPLUS_TREE_DESTROY_ITEM destroy_cb, void* user_ctx)
+{
+    BPLUS_TREE_INFO* result;
+    if ((result = (BPLUS_TREE_INFO*)malloc(sizeof(BPLUS_TREE_INFO))) == NULL)
+    {
+        log_error("Failure allocating b+ tree");
+    }
+    else
+    {
+        memset(result, 0, sizeof(BPLUS_TREE_INFO));
+        result->destroy_cb = destroy_cb;
+        result->user_ctx = user_ctx;
+    }
+    return result;
+}
+
+void bplus_tree_destroy(BPLUS_TREE_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        if (handle->root_node != NULL)
+        {
+            free_nodes(handle, handle->root_node);
+        }
+        free(handle);
+    }
+}
+
+int bplus_tree_insert(BPLUS_TREE_HANDLE handle, uint64_t key, void* value)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        // Allocate every node the splits need before touching the tree
+        // so a failed allocation leaves it unchanged
+        SPARE_NODES spare_nodes;
+        size_t split_count = handle->root_node == NULL ? 1 : count_path_splits(handle, key);
+        for (spare_nodes.count = 0; spare_nodes.count < split_count; spare_nodes.count++)
+        {
+            if ((spare_nodes.nodes[spare_nodes.count] = (TREE_NODE*)malloc(sizeof(TREE_NODE))) == NULL)
+            {
+                break;
+            }
+        }
+
+        if (spare_nodes.count < split_count)
+        {
+            log_error("Failure allocating tree nodes");
+            result = __LINE__;
+        }
+        else if (handle->root_node == NULL)
+        {
+            handle->root_node = take_spare_node(&spare_nodes, true);
+            handle->root_node->keys[0] = key;
+            handle->root_node->link.leaf.values[0] = value;
+            handle->root_node->key_count = 1;
+            handle->height = 1;
+            handle->items++;
+            result = 0;
+        }
+        else
+        {
+            NODE_SPLIT split = { NULL, 0 };
+            if ((result = insert_into_node(handle->root_node, key, value, &spare_nodes, &split)) == 0)
+            {
+                if (split.right_node != NULL)
+                {
+                    // The root split, the tree grows a level
+                    TREE_NODE* root_node = take_spare_node(&spare_nodes, false);
+                    root_node->keys[0] = split.key;
+                    root_node->link.children[0] = handle->root_node;
+                    root_node->link.children[1] = split.right_node;
+                    root_node->key_count = 1;
+                    handle->root_node = root_node;
+                    handle->height++;
+                }
+                handle->items++;
+            }
+        }
+        free_spare_nodes(&spare_nodes);
+    }
+    return result;
+}
+
+int bplus_tree_remove(BPLUS_TREE_HANDLE handle, uint64_t key, void** value)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = __LINE__;
+    }
+    else if (handle->root_node == NULL)
+    {
+        result = __LINE__;
+    }
+    else if ((result = remove_from_node(handle->root_node, key, value)) == 0)
+    {
+        handle->items--;
+        if (handle->root_node->key_count == 0)
+        {
+            // The root is allowed to run low, once it's empty
+            // its only child takes over
+            TREE_NODE* root_node = handle->root_node;
+            handle->root_node = root_node->is_leaf ? NULL : root_node->link.children[0];
+            handle->height--;
+            free(root_node);
+        }
+    }
+    return result;
+}
+
+void* bplus_tree_find(BPLUS_TREE_HANDLE handle, uint64_t key)
+{
+    void* result = NULL;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+    }
+    else
+    {
+        const TREE_NODE* leaf_node = find_leaf(handle, key);
+        if (leaf_node != NULL)
+        {
+            uint32_t position = count_keys_below(leaf_node, key);
+            if (position < leaf_node->key_count && leaf_node->keys[position] == key)
+            {
+                result = leaf_node->link.leaf.values[position];
+            }
+        }
+    }
+    return result;
+}
+
+int bplus_tree_bulk_load(BPLUS_TREE_HANDLE handle, const uint64_t* keys, void** values, size_t count)
+{
+    int result;
+    if (handle == NULL || (count > 0 && (keys == NULL || values == NULL)))
+    {
+        log_error("Invalid parameter handle: %p, keys: %p, values: %p", handle, keys, values);
+        result = __LINE__;
+    }
+    else if (handle->root_node != NULL)
+    {
+        log_error("Failure bulk loading a tree that isn't empty");
+        result = __LINE__;
+    }
+    else if (count == 0)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t index;
+        for (index = 1; index < count && keys[index - 1] < keys[index]; index++)
+        {
+        }
+
+        if (index < count)
+        {
+            log_error("Failure bulk load keys are not ascending at %zu", index);
+            result = __LINE__;
+        }
+        else
+        {
+            // Each level is built in place over the one below it
+            size_t node_count = (count + NODE_KEYS - 1) / NODE_KEYS;
+            TREE_NODE** nodes = (TREE_NODE**)malloc(node_count*sizeof(TREE_NODE*));
+            uint64_t* min_keys = (uint64_t*)malloc(node_count*sizeof(uint64_t));
+            if (nodes == NULL || min_keys == NULL)
+            {
+                log_error("Failure allocating bulk load levels");
+                result = __LINE__;
+            }
+            else if (build_leaf_level(keys, values, count, nodes, min_keys, &node_count) != 0)
+            {
+                log_error("Failure building leaf level");
+                result = __LINE__;
+            }
+            else
+            {
+                size_t height = 1;
+                result = 0;
+                while (node_count > 1 && result == 0)
+                {
+                    if ((result = build_parent_level(nodes, min_keys, &node_count)) != 0)
+                    {
+                        log_error("Failure building tree level");
+                    }
+                    height++;
+                }
+                if (result == 0)
+                {
+                    handle->root_node = nodes[0];
+                    handle->height = height;
+                    handle->items = count;
+                    node_count = 0;
+                }
+            }
+
+            if (nodes != NULL)
+            {
+                // Clean up the partly built level on failure without
+                // handing the values to destroy_cb
+                BPLUS_TREE_DESTROY_ITEM destroy_cb = handle->destroy_cb;
+                handle->destroy_cb = NULL;
+                for (index = 0; index < node_count; index++)
+                {
+                    free_nodes(handle, nodes[index]);
+                }
+                handle->destroy_cb = destroy_cb;
+            }
+            free(min_keys);
+            free(nodes);
+        }
+    }
+    return result;
+}
+
+int bplus_tree_lower_bound(BPLUS_TREE_HANDLE handle, uint64_t key, BPLUS_TREE_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        position_iterator(handle, key, true, iterator);
+        result = 0;
+    }
+    return result;
+}
+
+int bplus_tree_upper_bound(BPLUS_TREE_HANDLE handle, uint64_t key, BPLUS_TREE_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        position_iterator(handle, key, false, iterator);
+        result = 0;
+    }
+    return result;
+}
+
+int bplus_tree_iterator_next(BPLUS_TREE_HANDLE handle, BPLUS_TREE_ITERATOR* iterator, uint64_t* key, void** value)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        const TREE_NODE* leaf_node = (const TREE_NODE*)iterator->leaf;
+        // A bound can land past the end of its leaf, step onto the next one
+        while (leaf_node != NULL && iterator->index >= leaf_node->key_count)
+        {
+            leaf_node = leaf_node->link.leaf.next;
+            iterator->index = 0;
+        }
+        iterator->leaf = (void*)leaf_node;
+
+        if (leaf_node == NULL)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            if (key != NULL)
+            {
+                *key = leaf_node->keys[iterator->index];
+            }
+            if (value != NULL)
+            {
+                *value = leaf_node->link.leaf.values[iterator->index];
+            }
+            iterator->index++;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+size_t bplus_tree_item_count(BPLUS_TREE_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->items;
+    }
+    return result;
+}
+
+size_t bplus_tree_height(BPLUS_TREE_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->height;
+    }
+    return result;
+}
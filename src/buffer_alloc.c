@@ -3,94 +3,236 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdarg.h>
+#include <stdint.h>
+#include <string.h>
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/app_logging.h"
 #include "lib-util-c/buffer_alloc.h"
 
 #define DEFAULT_BUFFER_ALLOC_SIZE       64
+#define DEFAULT_GROWTH_PERCENT          100
+
+#define INLINE_CAPACITY                 (BUFFER_INLINE_SIZE - 1)
 
 typedef struct GENERIC_BUFFER_TAG
 {
     void* payload;
     size_t alloc_size;
     size_t default_alloc;
+    size_t growth_percent;
+    size_t payload_size;
+    unsigned char inline_payload[BUFFER_INLINE_SIZE];
 } GENERIC_BUFFER;
 
+static bool is_inline(const GENERIC_BUFFER* buffer)
+{
+    return buffer->payload == buffer->inline_payload;
+}
+
 static void free_buffer(GENERIC_BUFFER* buffer)
 {
     if (buffer->alloc_size > 0)
     {
-        free(buffer->payload);
+        if (!is_inline(buffer))
+        {
+            free(buffer->payload);
+        }
+        buffer->payload = NULL;
         buffer->default_alloc = buffer->alloc_size = 0;
     }
+    buffer->payload_size = 0;
 }
 
-static int allocate_buffer(GENERIC_BUFFER* buffer, size_t buffer_len, size_t new_length, bool* reallocated)
+// Moves the buffer to at least capacity bytes plus one for a string
+// terminator, inside the struct when it fits and on the heap otherwise.
+// The new memory is left as is, every caller writes it before reading it
+static int resize_buffer(GENERIC_BUFFER* buffer, size_t capacity)
 {
     int result;
-    if (buffer->alloc_size == 0)
+    if (capacity == SIZE_MAX)
     {
-        // Are we allocating more than the default alloc
-        if (new_length > buffer->default_alloc)
+        log_error("Invalid buffer capacity %zu", capacity);
+        result = __LINE__;
+    }
+    else if (capacity <= INLINE_CAPACITY)
+    {
+        if (buffer->alloc_size == 0)
         {
-            if (buffer->default_alloc < DEFAULT_BUFFER_ALLOC_SIZE)
+            // An empty string until something is written
+            buffer->inline_payload[0] = 0;
+        }
+        else if (!is_inline(buffer))
+        {
+            // Shrinking back into the struct, the byte past the payload
+            // is always allocated so the copy can take it along
+            memcpy(buffer->inline_payload, buffer->payload, buffer->payload_size+1);
+            free(buffer->payload);
+        }
+        buffer->payload = buffer->inline_payload;
+        buffer->alloc_size = INLINE_CAPACITY;
+        result = 0;
+    }
+    else if (buffer->alloc_size == 0 || is_inline(buffer))
+    {
+        void* temp_payload;
+        if ((temp_payload = malloc(capacity+1)) == NULL)
+        {
+            log_error("Failure allocating buffer value");
+            result = __LINE__;
+        }
+        else
+        {
+            if (buffer->alloc_size == 0)
             {
-                buffer->default_alloc = DEFAULT_BUFFER_ALLOC_SIZE;
+                *(unsigned char*)temp_payload = 0;
             }
             else
             {
-                buffer->default_alloc = new_length;
+                // Spilling out of the struct
+                memcpy(temp_payload, buffer->inline_payload, buffer->payload_size+1);
             }
+            buffer->payload = temp_payload;
+            buffer->alloc_size = capacity;
+            result = 0;
         }
-        buffer->alloc_size = new_length+buffer->default_alloc;
-
-        if ((buffer->payload = malloc(buffer->alloc_size+1)) == NULL)
+    }
+    else
+    {
+        void* temp_payload;
+        if ((temp_payload = realloc(buffer->payload, capacity+1)) == NULL)
         {
-            log_error("Failure allocating buffer value");
+            log_error("Failure reallocating buffer value");
             result = __LINE__;
         }
         else
         {
-            if (reallocated != NULL)
-            {
-                *reallocated = false;
-            }
-            memset(buffer->payload, 0, buffer->alloc_size+1);
+            buffer->payload = temp_payload;
+            buffer->alloc_size = capacity;
             result = 0;
         }
     }
-    else
+    return result;
+}
+
+// Grows by growth_percent of the current size so a run of appends
+// reallocates O(log n) times, falling back to the exact size when the
+// step would not be enough or would overflow
+static size_t next_capacity(const GENERIC_BUFFER* buffer, size_t required_size)
+{
+    size_t result = required_size;
+    size_t growth_percent = buffer->growth_percent == 0 ? DEFAULT_GROWTH_PERCENT : buffer->growth_percent;
+    if (buffer->alloc_size < (SIZE_MAX - 1)/(100 + growth_percent))
+    {
+        size_t grown_size = buffer->alloc_size + (buffer->alloc_size*growth_percent)/100;
+        if (grown_size > result)
+        {
+            result = grown_size;
+        }
+    }
+    return result;
+}
+
+// Makes room for new_length more bytes past payload_size
+static int allocate_buffer(GENERIC_BUFFER* buffer, size_t new_length)
+{
+    int result;
+    if (buffer->alloc_size == 0 && new_length <= INLINE_CAPACITY)
     {
-        // Do we need to realloc
-        size_t curr_len = buffer_len;
-        if (curr_len + new_length + 1 >= buffer->alloc_size)
+        result = resize_buffer(buffer, new_length);
+    }
+    else if (buffer->alloc_size == 0)
+    {
+        // Are we allocating more than the default alloc
+        if (new_length > buffer->default_alloc)
         {
-            char* temp_payload;
-            size_t alloc_len = buffer->default_alloc + buffer->alloc_size + new_length + 1;
-            // Realloc the string
-            if ((temp_payload = realloc(buffer->payload, alloc_len)) == NULL)
+            if (buffer->default_alloc < DEFAULT_BUFFER_ALLOC_SIZE)
             {
-                log_error("Failure reallocating buffer value");
-                result = __LINE__;
+                buffer->default_alloc = DEFAULT_BUFFER_ALLOC_SIZE;
             }
             else
             {
-                buffer->payload = temp_payload;
-                if (reallocated != NULL)
-                {
-                    *reallocated = true;
-                }
-                buffer->alloc_size = alloc_len;
-                memset(((unsigned char*)buffer->payload)+curr_len, 0, alloc_len-curr_len);
-                result = 0;
+                buffer->default_alloc = new_length;
             }
         }
+        if (new_length > SIZE_MAX - 1 - buffer->default_alloc)
+        {
+            log_error("Buffer length overflow");
+            result = __LINE__;
+        }
         else
         {
-            result = 0;
+            result = resize_buffer(buffer, new_length+buffer->default_alloc);
         }
     }
+    // Do we need to realloc
+    else if (new_length > buffer->alloc_size - buffer->payload_size)
+    {
+        if (new_length > SIZE_MAX - 1 - buffer->payload_size)
+        {
+            log_error("Buffer length overflow");
+            result = __LINE__;
+        }
+        else
+        {
+            result = resize_buffer(buffer, next_capacity(buffer, buffer->payload_size + new_length));
+        }
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static int reserve_buffer(GENERIC_BUFFER* buffer, size_t capacity)
+{
+    int result;
+    if (capacity > buffer->alloc_size)
+    {
+        result = resize_buffer(buffer, capacity);
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+static int shrink_buffer(GENERIC_BUFFER* buffer)
+{
+    int result;
+    if (buffer->alloc_size == 0 || buffer->alloc_size == buffer->payload_size || (is_inline(buffer) && buffer->payload_size > 0))
+    {
+        result = 0;
+    }
+    else if (buffer->payload_size == 0)
+    {
+        // Nothing left to keep, an empty buffer holds no memory
+        free_buffer(buffer);
+        result = 0;
+    }
+    else
+    {
+        result = resize_buffer(buffer, buffer->payload_size);
+    }
+    return result;
+}
+
+static int append_string(STRING_BUFFER* buffer, const char* value, size_t length)
+{
+    int result;
+    if (allocate_buffer((GENERIC_BUFFER*)buffer, length) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(buffer->payload+buffer->payload_size, value, length);
+        buffer->payload_size += length;
+        buffer->payload[buffer->payload_size] = '\0';
+        result = 0;
+    }
     return result;
 }
 
@@ -104,26 +246,13 @@ int string_buffer_construct(STRING_BUFFER* buffer, const char* value)
     }
     else
     {
-        bool reallocated;
-        size_t new_length = strlen(value);
-        size_t buffer_len = 0;
-        if (buffer->payload != NULL)
-        {
-            buffer_len = strlen(buffer->payload);
-        }
-        if (allocate_buffer((GENERIC_BUFFER*)buffer, buffer_len, new_length, &reallocated) != 0)
+        if (append_string(buffer, value, strlen(value)) != 0)
         {
             log_error("Failure allocating string buffer value");
             result = __LINE__;
         }
         else
         {
-            size_t current_len = 0;
-            if (buffer->payload != NULL)
-            {
-                current_len = strlen(buffer->payload);
-            }
-            memcpy(buffer->payload+current_len, value, new_length);
             result = 0;
         }
     }
@@ -139,6 +268,70 @@ void string_buffer_free(STRING_BUFFER* buffer)
     }
 }
 
+int string_buffer_append(STRING_BUFFER* buffer, const char* value, size_t length)
+{
+    int result;
+    if (buffer == NULL || (value == NULL && length > 0))
+    {
+        log_error("Invalid parameter specified buffer: %p, value: %p", buffer, value);
+        result = __LINE__;
+    }
+    else if (append_string(buffer, value, length) != 0)
+    {
+        log_error("Failure appending string buffer value");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int string_buffer_insert(STRING_BUFFER* buffer, size_t position, const char* value, size_t length)
+{
+    int result;
+    if (buffer == NULL || (value == NULL && length > 0) || position > buffer->payload_size)
+    {
+        log_error("Invalid parameter specified buffer: %p, value: %p, position: %zu", buffer, value, position);
+        result = __LINE__;
+    }
+    else if (allocate_buffer((GENERIC_BUFFER*)buffer, length) != 0)
+    {
+        log_error("Failure allocating string buffer value");
+        result = __LINE__;
+    }
+    else
+    {
+        // Moves the tail and its terminator up in one go
+        memmove(buffer->payload+position+length, buffer->payload+position, buffer->payload_size-position+1);
+        memcpy(buffer->payload+position, value, length);
+        buffer->payload_size += length;
+        result = 0;
+    }
+    return result;
+}
+
+int string_buffer_truncate(STRING_BUFFER* buffer, size_t length)
+{
+    int result;
+    if (buffer == NULL || length > buffer->payload_size)
+    {
+        log_error("Invalid parameter specified buffer: %p, length: %zu", buffer, length);
+        result = __LINE__;
+    }
+    else
+    {
+        if (buffer->alloc_size > 0)
+        {
+            buffer->payload[length] = '\0';
+        }
+        buffer->payload_size = length;
+        result = 0;
+    }
+    return result;
+}
+
 int string_buffer_construct_sprintf(STRING_BUFFER* buffer, const char* format, ...)
 {
     int result;
@@ -158,36 +351,27 @@ int string_buffer_construct_sprintf(STRING_BUFFER* buffer, const char* format, .
         va_end(arg_list);
         if (length > 0)
         {
-            bool reallocated;
-            size_t buffer_len = 0;
-            if (buffer->payload != NULL)
-            {
-                buffer_len = strlen(buffer->payload);
-            }
-            if (allocate_buffer((GENERIC_BUFFER*)buffer, buffer_len, length, &reallocated) != 0)
+            if (allocate_buffer((GENERIC_BUFFER*)buffer, length) != 0)
             {
                 log_error("Failure allocating string buffer");
                 result = __LINE__;
             }
             else
             {
-                size_t current_len = 0;
-                if (buffer->payload != NULL)
-                {
-                    current_len = strlen(buffer->payload);
-                }
+                int format_result;
                 va_start(arg_list, format);
-                if (vsnprintf(buffer->payload+current_len, length+1, format, arg_list) < 0)
+                format_result = vsnprintf(buffer->payload+buffer->payload_size, length+1, format, arg_list);
+                va_end(arg_list);
+                if (format_result < 0)
                 {
-                    if (!reallocated)
-                    {
-                        free(buffer->payload);
-                    }
+                    // Drop whatever got partly written, the string is left as it was
+                    buffer->payload[buffer->payload_size] = '\0';
                     log_error("Failure formatting string value");
                     result = __LINE__;
                 }
                 else
                 {
+                    buffer->payload_size += length;
                     result = 0;
                 }
             }
@@ -205,6 +389,46 @@ int string_buffer_construct_sprintf(STRING_BUFFER* buffer, const char* format, .
     return result;
 }
 
+int string_buffer_reserve(STRING_BUFFER* buffer, size_t capacity)
+{
+    int result;
+    if (buffer == NULL)
+    {
+        log_error("Invalid parameter specified buffer: NULL");
+        result = __LINE__;
+    }
+    else if (reserve_buffer((GENERIC_BUFFER*)buffer, capacity) != 0)
+    {
+        log_error("Failure reserving string buffer");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int string_buffer_shrink_to_fit(STRING_BUFFER* buffer)
+{
+    int result;
+    if (buffer == NULL)
+    {
+        log_error("Invalid parameter specified buffer: NULL");
+        result = __LINE__;
+    }
+    else if (shrink_buffer((GENERIC_BUFFER*)buffer) != 0)
+    {
+        log_error("Failure shrinking string buffer");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
 int byte_buffer_construct(BYTE_BUFFER* buffer, const unsigned char* payload, size_t length)
 {
     int result;
@@ -215,7 +439,7 @@ int byte_buffer_construct(BYTE_BUFFER* buffer, const unsigned char* payload, siz
     }
     else
     {
-        if (allocate_buffer((GENERIC_BUFFER*)buffer, buffer->payload_size, length, NULL) != 0)
+        if (allocate_buffer((GENERIC_BUFFER*)buffer, length) != 0)
         {
             log_error("Failure allocating binary buffer");
             result = __LINE__;
@@ -240,3 +464,43 @@ void byte_buffer_free(BYTE_BUFFER* buffer)
         buffer->alloc_size = 0;
     }
 }
+
+int byte_buffer_reserve(BYTE_BUFFER* buffer, size_t capacity)
+{
+    int result;
+    if (buffer == NULL)
+    {
+        log_error("Invalid parameter specified buffer: NULL");
+        result = __LINE__;
+    }
+    else if (reserve_buffer((GENERIC_BUFFER*)buffer, capacity) != 0)
+    {
+        log_error("Failure reserving binary buffer");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
+
+int byte_buffer_shrink_to_fit(BYTE_BUFFER* buffer)
+{
+    int result;
+    if (buffer == NULL)
+    {
+        log_error("Invalid parameter specified buffer: NULL");
+        result = __LINE__;
+    }
+    else if (shrink_buffer((GENERIC_BUFFER*)buffer) != 0)
+    {
+        log_error("Failure shrinking binary buffer");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
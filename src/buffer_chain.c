@@ -0,0 +1,450 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/buffer_chain.h"
+
+typedef struct CHAIN_SEGMENT_TAG
+{
+    struct CHAIN_SEGMENT_TAG* next;
+    // The bytes not yet consumed
+    const unsigned char* data;
+    size_t length;
+    // What the segment was added with, handed back to release_cb
+    const unsigned char* release_data;
+    size_t release_length;
+    BUFFER_CHAIN_RELEASE release_cb;
+    void* release_ctx;
+    // Storage for the copy segments, allocated with the segment
+    unsigned char copy_data[];
+} CHAIN_SEGMENT;
+
+typedef struct BUFFER_CHAIN_INFO_TAG
+{
+    CHAIN_SEGMENT* head_segment;
+    CHAIN_SEGMENT* tail_segment;
+    size_t segment_count;
+    size_t total_length;
+} BUFFER_CHAIN_INFO;
+
+static void release_heap_payload(void* release_ctx, const unsigned char* data, size_t length)
+{
+    (void)release_ctx;
+    (void)length;
+    free((void*)data);
+}
+
+static CHAIN_SEGMENT* create_segment(size_t copy_length)
+{
+    CHAIN_SEGMENT* result;
+    if (copy_length > SIZE_MAX - sizeof(CHAIN_SEGMENT))
+    {
+        log_error("Failure segment size %zu too large", copy_length);
+        result = NULL;
+    }
+    else if ((result = (CHAIN_SEGMENT*)malloc(sizeof(CHAIN_SEGMENT) + copy_length)) == NULL)
+    {
+        log_error("Failure allocating chain segment");
+    }
+    return result;
+}
+
+static void destroy_segment(CHAIN_SEGMENT* segment)
+{
+    if (segment->release_cb != NULL)
+    {
+        segment->release_cb(segment->release_ctx, segment->release_data, segment->release_length);
+    }
+    free(segment);
+}
+
+static void link_segment(BUFFER_CHAIN_INFO* chain_info, CHAIN_SEGMENT* segment, bool at_head)
+{
+    if (chain_info->head_segment == NULL)
+    {
+        segment->next = NULL;
+        chain_info->head_segment = chain_info->tail_segment = segment;
+    }
+    else if (at_head)
+    {
+        segment->next = chain_info->head_segment;
+        chain_info->head_segment = segment;
+    }
+    else
+    {
+        segment->next = NULL;
+        chain_info->tail_segment->next = segment;
+        chain_info->tail_segment = segment;
+    }
+    chain_info->segment_count++;
+    chain_info->total_length += segment->length;
+}
+
+static CHAIN_SEGMENT* unlink_head_segment(BUFFER_CHAIN_INFO* chain_info)
+{
+    CHAIN_SEGMENT* result = chain_info->head_segment;
+    if ((chain_info->head_segment = result->next) == NULL)
+    {
+        chain_info->tail_segment = NULL;
+    }
+    chain_info->segment_count--;
+    chain_info->total_length -= result->length;
+    return result;
+}
+
+static int add_segment(BUFFER_CHAIN_INFO* chain_info, const unsigned char* data, size_t length, BUFFER_CHAIN_RELEASE release_cb, void* release_ctx, bool at_head)
+{
+    int result;
+    CHAIN_SEGMENT* segment;
+    if (length > SIZE_MAX - chain_info->total_length)
+    {
+        log_error("Failure chain length would overflow");
+        result = __LINE__;
+    }
+    else if ((segment = create_segment(0)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        segment->data = segment->release_data = data;
+        segment->length = segment->release_length = length;
+        segment->release_cb = release_cb;
+        segment->release_ctx = release_ctx;
+        link_segment(chain_info, segment, at_head);
+        result = 0;
+    }
+    return result;
+}
+
+static int add_copy_segment(BUFFER_CHAIN_INFO* chain_info, const unsigned char* data, size_t length, bool at_head)
+{
+    int result;
+    CHAIN_SEGMENT* segment;
+    if (length > SIZE_MAX - chain_info->total_length)
+    {
+        log_error("Failure chain length would overflow");
+        result = __LINE__;
+    }
+    else if ((segment = create_segment(length)) == NULL)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        memcpy(segment->copy_data, data, length);
+        segment->data = segment->release_data = segment->copy_data;
+        segment->length = segment->release_length = length;
+        segment->release_cb = NULL;
+        segment->release_ctx = NULL;
+        link_segment(chain_info, segment, at_head);
+        result = 0;
+    }
+    return result;
+}
+
+static int add_byte_buffer(BUFFER_CHAIN_INFO* chain_info, BYTE_BUFFER* buffer, bool at_head)
+{
+    int result;
+    if (buffer->payload == buffer->inline_payload)
+    {
+        // The inline bytes go away with the struct, they have to be copied
+        if (add_copy_segment(chain_info, buffer->payload, buffer->payload_size, at_head) != 0)
+        {
+            result = __LINE__;
+        }
+        else
+        {
+            byte_buffer_free(buffer);
+            result = 0;
+        }
+    }
+    else if (add_segment(chain_info, buffer->payload, buffer->payload_size, release_heap_payload, NULL, at_head) != 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        // The chain frees the payload now, detach it without freeing
+        buffer->payload = NULL;
+        buffer->payload_size = buffer->alloc_size = buffer->default_alloc = 0;
+        result = 0;
+    }
+    return result;
+}
+
+BUFFER_CHAIN_HANDLE buffer_chain_create(void)
+{
+    BUFFER_CHAIN_INFO* result;
+    if ((result = (BUFFER_CHAIN_INFO*)malloc(sizeof(BUFFER_CHAIN_INFO))) == NULL)
+    {
+        log_error("Failure allocating buffer chain");
+    }
+    else
+    {
+        memset(result, 0, sizeof(BUFFER_CHAIN_INFO));
+    }
+    return result;
+}
+
+void buffer_chain_destroy(BUFFER_CHAIN_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        while (handle->head_segment != NULL)
+        {
+            destroy_segment(unlink_head_segment(handle));
+        }
+        free(handle);
+    }
+}
+
+int buffer_chain_append(BUFFER_CHAIN_HANDLE handle, const unsigned char* data, size_t length, BUFFER_CHAIN_RELEASE release_cb, void* release_ctx)
+{
+    int result;
+    if (handle == NULL || data == NULL || length == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, data: %p, length: %zu", handle, data, length);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_segment(handle, data, length, release_cb, release_ctx, false);
+    }
+    return result;
+}
+
+int buffer_chain_prepend(BUFFER_CHAIN_HANDLE handle, const unsigned char* data, size_t length, BUFFER_CHAIN_RELEASE release_cb, void* release_ctx)
+{
+    int result;
+    if (handle == NULL || data == NULL || length == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, data: %p, length: %zu", handle, data, length);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_segment(handle, data, length, release_cb, release_ctx, true);
+    }
+    return result;
+}
+
+int buffer_chain_append_copy(BUFFER_CHAIN_HANDLE handle, const unsigned char* data, size_t length)
+{
+    int result;
+    if (handle == NULL || data == NULL || length == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, data: %p, length: %zu", handle, data, length);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_copy_segment(handle, data, length, false);
+    }
+    return result;
+}
+
+int buffer_chain_prepend_copy(BUFFER_CHAIN_HANDLE handle, const unsigned char* data, size_t length)
+{
+    int result;
+    if (handle == NULL || data == NULL || length == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, data: %p, length: %zu", handle, data, length);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_copy_segment(handle, data, length, true);
+    }
+    return result;
+}
+
+int buffer_chain_append_byte_buffer(BUFFER_CHAIN_HANDLE handle, BYTE_BUFFER* buffer)
+{
+    int result;
+    if (handle == NULL || buffer == NULL || buffer->payload == NULL || buffer->payload_size == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, buffer: %p", handle, buffer);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_byte_buffer(handle, buffer, false);
+    }
+    return result;
+}
+
+int buffer_chain_prepend_byte_buffer(BUFFER_CHAIN_HANDLE handle, BYTE_BUFFER* buffer)
+{
+    int result;
+    if (handle == NULL || buffer == NULL || buffer->payload == NULL || buffer->payload_size == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, buffer: %p", handle, buffer);
+        result = __LINE__;
+    }
+    else
+    {
+        result = add_byte_buffer(handle, buffer, true);
+    }
+    return result;
+}
+
+int buffer_chain_append_chain(BUFFER_CHAIN_HANDLE handle, BUFFER_CHAIN_HANDLE source)
+{
+    int result;
+    if (handle == NULL || source == NULL || handle == source)
+    {
+        log_error("Invalid parameter specified handle: %p, source: %p", handle, source);
+        result = __LINE__;
+    }
+    else if (source->total_length > SIZE_MAX - handle->total_length)
+    {
+        log_error("Failure chain length would overflow");
+        result = __LINE__;
+    }
+    else
+    {
+        if (source->head_segment != NULL)
+        {
+            if (handle->head_segment == NULL)
+            {
+                handle->head_segment = source->head_segment;
+            }
+            else
+            {
+                handle->tail_segment->next = source->head_segment;
+            }
+            handle->tail_segment = source->tail_segment;
+            handle->segment_count += source->segment_count;
+            handle->total_length += source->total_length;
+            memset(source, 0, sizeof(BUFFER_CHAIN_INFO));
+        }
+        result = 0;
+    }
+    return result;
+}
+
+size_t buffer_chain_get_length(BUFFER_CHAIN_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->total_length;
+    }
+    return result;
+}
+
+size_t buffer_chain_get_segment_count(BUFFER_CHAIN_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->segment_count;
+    }
+    return result;
+}
+
+size_t buffer_chain_get_iovec(BUFFER_CHAIN_HANDLE handle, BUFFER_CHAIN_IOVEC* iov_array, size_t iov_count)
+{
+    size_t result = 0;
+    if (handle == NULL || iov_array == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, iov_array: %p", handle, iov_array);
+    }
+    else
+    {
+        for (CHAIN_SEGMENT* segment = handle->head_segment; segment != NULL && result < iov_count; segment = segment->next, result++)
+        {
+            iov_array[result].iov_base = (void*)segment->data;
+            iov_array[result].iov_len = segment->length;
+        }
+    }
+    return result;
+}
+
+int buffer_chain_consume(BUFFER_CHAIN_HANDLE handle, size_t length)
+{
+    int result;
+    if (handle == NULL || length > handle->total_length)
+    {
+        log_error("Invalid parameter specified handle: %p, length: %zu", handle, length);
+        result = __LINE__;
+    }
+    else
+    {
+        while (length > 0)
+        {
+            CHAIN_SEGMENT* segment = handle->head_segment;
+            if (length >= segment->length)
+            {
+                length -= segment->length;
+                destroy_segment(unlink_head_segment(handle));
+            }
+            else
+            {
+                // A partial write, the rest of the segment stays at the front
+                segment->data += length;
+                segment->length -= length;
+                handle->total_length -= length;
+                length = 0;
+            }
+        }
+        result = 0;
+    }
+    return result;
+}
+
+int buffer_chain_flatten(BUFFER_CHAIN_HANDLE handle, BYTE_BUFFER* buffer)
+{
+    int result;
+    if (handle == NULL || buffer == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, buffer: %p", handle, buffer);
+        result = __LINE__;
+    }
+    else if (handle->total_length > SIZE_MAX - 1 - buffer->payload_size)
+    {
+        log_error("Failure flattened length would overflow");
+        result = __LINE__;
+    }
+    else if (handle->total_length == 0)
+    {
+        result = 0;
+    }
+    else if (byte_buffer_reserve(buffer, buffer->payload_size + handle->total_length) != 0)
+    {
+        log_error("Failure reserving flattened buffer");
+        result = __LINE__;
+    }
+    else
+    {
+        // Everything fits after the reserve, the appends only copy
+        result = 0;
+        for (CHAIN_SEGMENT* segment = handle->head_segment; segment != NULL; segment = segment->next)
+        {
+            if (byte_buffer_construct(buffer, segment->data, segment->length) != 0)
+            {
+                log_error("Failure copying chain segment");
+                result = __LINE__;
+                break;
+            }
+        }
+    }
+    return result;
+}
@@ -0,0 +1,270 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/item_map.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/atomic_operations.h"
+#include "lib-util-c/concurrent_map.h"
+
+#define SHARD_SELECT_MULTIPLIER 0x9E3779B1U
+#define SHARD_MAP_OPTIONS       (ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE)
+
+typedef struct MAP_SHARD_TAG
+{
+    MUTEX_HANDLE lock;
+    ITEM_MAP_HANDLE map;
+} MAP_SHARD;
+
+typedef struct CONCURRENT_MAP_INFO_TAG
+{
+    MAP_SHARD* shards;
+    size_t shard_count;
+    long item_count;
+} CONCURRENT_MAP_INFO;
+
+static void destroy_shards(CONCURRENT_MAP_INFO* map_info, size_t shard_count)
+{
+    for (size_t index = 0; index < shard_count; index++)
+    {
+        item_map_destroy(map_info->shards[index].map);
+        mutex_mgr_destroy(map_info->shards[index].lock);
+    }
+    free(map_info->shards);
+}
+
+static uint32_t hash_map_key(const CONCURRENT_MAP_INFO* map_info, const char* key)
+{
+    // Every shard shares the same hash function
+    return item_map_hash_key(map_info->shards[0].map, key);
+}
+
+// The multiply spreads the hash and the shift reduces it to [0, shard_count)
+// using the high bits, so the shards don't have to be a power of two
+static MAP_SHARD* select_shard(CONCURRENT_MAP_INFO* map_info, uint32_t hash)
+{
+    uint32_t spread = hash * SHARD_SELECT_MULTIPLIER;
+    return &map_info->shards[(size_t)(((uint64_t)spread * map_info->shard_count) >> 32)];
+}
+
+CONCURRENT_MAP_HANDLE concurrent_map_create(size_t shard_count, size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, void* user_ctx, ITEM_MAP_HASH_FUNCTION hash_function)
+{
+    CONCURRENT_MAP_INFO* result;
+    if (shard_count == 0)
+    {
+        shard_count = CONCURRENT_MAP_DEFAULT_SHARDS;
+    }
+
+    if ((result = (CONCURRENT_MAP_INFO*)malloc(sizeof(CONCURRENT_MAP_INFO))) == NULL)
+    {
+        log_error("Failure allocating concurrent map");
+    }
+    else if ((result->shards = (MAP_SHARD*)malloc(sizeof(MAP_SHARD)*shard_count)) == NULL)
+    {
+        log_error("Failure allocating map shards");
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        size_t shard_size = size/shard_count;
+        size_t created = 0;
+
+        result->shard_count = shard_count;
+        result->item_count = 0;
+        for (; created < shard_count; created++)
+        {
+            MAP_SHARD* shard = &result->shards[created];
+            if (mutex_mgr_create(&shard->lock) != 0)
+            {
+                log_error("Failure creating shard lock");
+                break;
+            }
+            else if ((shard->map = item_map_create_with_options(shard_size, SHARD_MAP_OPTIONS, destroy_cb, user_ctx, hash_function)) == NULL)
+            {
+                log_error("Failure creating shard map");
+                mutex_mgr_destroy(shard->lock);
+                break;
+            }
+        }
+
+        if (created != shard_count)
+        {
+            destroy_shards(result, created);
+            free(result);
+            result = NULL;
+        }
+    }
+    return result;
+}
+
+void concurrent_map_destroy(CONCURRENT_MAP_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        destroy_shards(handle, handle->shard_count);
+        free(handle);
+    }
+}
+
+int concurrent_map_add_item(CONCURRENT_MAP_HANDLE handle, const char* key, const void* value, size_t len)
+{
+    int result;
+    if (handle == NULL || key == NULL || value == NULL || len == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p, value: %p", handle, key, value);
+        result = __LINE__;
+    }
+    else
+    {
+        MAP_SHARD* shard = select_shard(handle, hash_map_key(handle, key));
+        if (mutex_mgr_lock(shard->lock) != 0)
+        {
+            log_error("Failure locking map shard");
+            result = __LINE__;
+        }
+        else
+        {
+            if (item_map_add_item(shard->map, key, value, len) != 0)
+            {
+                log_error("Failure adding item to shard");
+                result = __LINE__;
+            }
+            else
+            {
+                (void)atomic_add(&handle->item_count, 1);
+                result = 0;
+            }
+            (void)mutex_mgr_unlock(shard->lock);
+        }
+    }
+    return result;
+}
+
+int concurrent_map_get_item(CONCURRENT_MAP_HANDLE handle, const char* key, void* value, size_t len, size_t* value_len)
+{
+    int result;
+    if (handle == NULL || key == NULL || value == NULL || len == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p, value: %p", handle, key, value);
+        result = __LINE__;
+    }
+    else
+    {
+        uint32_t hash = hash_map_key(handle, key);
+        MAP_SHARD* shard = select_shard(handle, hash);
+        if (mutex_mgr_lock(shard->lock) != 0)
+        {
+            log_error("Failure locking map shard");
+            result = __LINE__;
+        }
+        else
+        {
+            size_t stored_len = 0;
+            const void* item = item_map_get_item_prehashed(shard->map, key, strlen(key), hash, &stored_len);
+            if (item == NULL)
+            {
+                result = __LINE__;
+            }
+            else
+            {
+                memcpy(value, item, len < stored_len ? len : stored_len);
+                if (value_len != NULL)
+                {
+                    *value_len = stored_len;
+                }
+                result = 0;
+            }
+            (void)mutex_mgr_unlock(shard->lock);
+        }
+    }
+    return result;
+}
+
+int concurrent_map_remove_item(CONCURRENT_MAP_HANDLE handle, const char* key)
+{
+    int result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
+        result = __LINE__;
+    }
+    else
+    {
+        MAP_SHARD* shard = select_shard(handle, hash_map_key(handle, key));
+        if (mutex_mgr_lock(shard->lock) != 0)
+        {
+            log_error("Failure locking map shard");
+            result = __LINE__;
+        }
+        else
+        {
+            size_t prev_size = item_map_size(shard->map);
+            if (item_map_remove_item(shard->map, key) != 0)
+            {
+                log_error("Failure removing item from shard");
+                result = __LINE__;
+            }
+            else
+            {
+                (void)atomic_subtract(&handle->item_count, (long)(prev_size - item_map_size(shard->map)));
+                result = 0;
+            }
+            (void)mutex_mgr_unlock(shard->lock);
+        }
+    }
+    return result;
+}
+
+int concurrent_map_clear_all(CONCURRENT_MAP_HANDLE handle)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle: NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+        // Shards are cleared one at a time, items added to an already
+        // cleared shard while this runs are kept
+        for (size_t index = 0; index < handle->shard_count; index++)
+        {
+            MAP_SHARD* shard = &handle->shards[index];
+            if (mutex_mgr_lock(shard->lock) != 0)
+            {
+                log_error("Failure locking map shard");
+                result = __LINE__;
+            }
+            else
+            {
+                size_t prev_size = item_map_size(shard->map);
+                (void)item_map_clear_all(shard->map);
+                (void)atomic_subtract(&handle->item_count, (long)prev_size);
+                (void)mutex_mgr_unlock(shard->lock);
+            }
+        }
+    }
+    return result;
+}
+
+size_t concurrent_map_size(CONCURRENT_MAP_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter specified handle: NULL");
+        result = 0;
+    }
+    else
+    {
+        result = (size_t)atomic_add(&handle->item_count, 0);
+    }
+    return result;
+}
@@ -0,0 +1,466 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/condition_mgr.h"
+#include "lib-util-c/atomic_operations.h"
+#include "lib-util-c/concurrent_queue.h"
+
+#define CACHE_LINE_SIZE         64
+#define MIN_QUEUE_CAPACITY      2
+#define POP_SPIN_COUNT          64
+
+// Sleeping consumers park on the condition.  Producers only touch the lock
+// when waiters is non zero, so the fast path stays lock free
+typedef struct QUEUE_SIGNAL_TAG
+{
+    MUTEX_HANDLE lock;
+    SIGNAL_HANDLE signal;
+    int64_t waiters;
+} QUEUE_SIGNAL;
+
+typedef struct QUEUE_CELL_TAG
+{
+    int64_t sequence;
+    void* item;
+} QUEUE_CELL;
+
+// The positions sit on their own cache lines so producers and
+// consumers don't pull the same line back and forth
+typedef struct MPMC_QUEUE_INFO_TAG
+{
+    QUEUE_CELL* cells;
+    size_t mask;
+    QUEUE_SIGNAL queue_signal;
+    unsigned char enqueue_padding[CACHE_LINE_SIZE];
+    int64_t enqueue_pos;
+    unsigned char dequeue_padding[CACHE_LINE_SIZE - sizeof(int64_t)];
+    int64_t dequeue_pos;
+    unsigned char tail_padding[CACHE_LINE_SIZE - sizeof(int64_t)];
+} MPMC_QUEUE_INFO;
+
+// head is exchanged by the producers, tail is only touched by the consumer.
+// The stub entry keeps the list from ever being empty so a push never has
+// to touch tail
+typedef struct MPSC_QUEUE_INFO_TAG
+{
+    PDLLIST_ENTRY head;
+    unsigned char head_padding[CACHE_LINE_SIZE - sizeof(PDLLIST_ENTRY)];
+    PDLLIST_ENTRY tail;
+    DLLIST_ENTRY stub;
+    QUEUE_SIGNAL queue_signal;
+} MPSC_QUEUE_INFO;
+
+static int init_queue_signal(QUEUE_SIGNAL* queue_signal)
+{
+    int result;
+    if (mutex_mgr_create(&queue_signal->lock) != 0)
+    {
+        log_error("Failure creating queue lock");
+        result = __LINE__;
+    }
+    else if (condition_mgr_init(&queue_signal->signal) != 0)
+    {
+        log_error("Failure creating queue signal");
+        mutex_mgr_destroy(queue_signal->lock);
+        result = __LINE__;
+    }
+    else
+    {
+        queue_signal->waiters = 0;
+        result = 0;
+    }
+    return result;
+}
+
+static void deinit_queue_signal(QUEUE_SIGNAL* queue_signal)
+{
+    condition_mgr_deinit(queue_signal->signal);
+    mutex_mgr_destroy(queue_signal->lock);
+}
+
+// Called after an item is published.  The waiter count is registered under
+// the lock before the consumer's last check of the queue, so either that
+// check sees the item or this sees the waiter and signals once it sleeps
+static void notify_queue_signal(QUEUE_SIGNAL* queue_signal)
+{
+    if (atomic_load64(&queue_signal->waiters) > 0)
+    {
+        (void)mutex_mgr_lock(queue_signal->lock);
+        (void)condition_mgr_signal(queue_signal->signal);
+        (void)mutex_mgr_unlock(queue_signal->lock);
+    }
+}
+
+static int try_pop_mpmc_item(MPMC_QUEUE_INFO* queue_info, void** item)
+{
+    int result;
+    QUEUE_CELL* cell;
+    int64_t pos = atomic_load64(&queue_info->dequeue_pos);
+    do
+    {
+        cell = &queue_info->cells[(size_t)pos & queue_info->mask];
+        int64_t diff = atomic_load64(&cell->sequence) - (pos + 1);
+        if (diff == 0)
+        {
+            // The cell holds the item for this position, claim it
+            if (atomic_compare_exchange64(&queue_info->dequeue_pos, pos, pos + 1))
+            {
+                result = 0;
+                break;
+            }
+            pos = atomic_load64(&queue_info->dequeue_pos);
+        }
+        else if (diff < 0)
+        {
+            // The producer for this position hasn't written it yet
+            result = __LINE__;
+            break;
+        }
+        else
+        {
+            // Another consumer took the position first
+            pos = atomic_load64(&queue_info->dequeue_pos);
+        }
+    } while (true);
+
+    if (result == 0)
+    {
+        *item = cell->item;
+        // Hand the cell back to the producer one lap ahead
+        atomic_store64(&cell->sequence, pos + (int64_t)queue_info->mask + 1);
+    }
+    return result;
+}
+
+static void push_mpsc_entry(MPSC_QUEUE_INFO* queue_info, PDLLIST_ENTRY entry)
+{
+    atomic_store_ptr((void**)&entry->fwd_link, NULL);
+    PDLLIST_ENTRY prev = (PDLLIST_ENTRY)atomic_exchange_ptr((void**)&queue_info->head, entry);
+    // Until this store the consumer sees the queue end at prev
+    atomic_store_ptr((void**)&prev->fwd_link, entry);
+}
+
+static PDLLIST_ENTRY try_pop_mpsc_entry(MPSC_QUEUE_INFO* queue_info)
+{
+    PDLLIST_ENTRY result = NULL;
+    PDLLIST_ENTRY tail = queue_info->tail;
+    PDLLIST_ENTRY next = (PDLLIST_ENTRY)atomic_load_ptr((void**)&tail->fwd_link);
+    if (tail == &queue_info->stub)
+    {
+        // Step over the stub to the first record
+        if (next != NULL)
+        {
+            queue_info->tail = tail = next;
+            next = (PDLLIST_ENTRY)atomic_load_ptr((void**)&tail->fwd_link);
+        }
+        else
+        {
+            tail = NULL;
+        }
+    }
+
+    if (tail == NULL)
+    {
+        // Empty
+    }
+    else if (next != NULL)
+    {
+        queue_info->tail = next;
+        result = tail;
+    }
+    else if (tail == (PDLLIST_ENTRY)atomic_load_ptr((void**)&queue_info->head))
+    {
+        // tail is the last record, put the stub behind it so it can be handed out
+        push_mpsc_entry(queue_info, &queue_info->stub);
+        if ((next = (PDLLIST_ENTRY)atomic_load_ptr((void**)&tail->fwd_link)) != NULL)
+        {
+            queue_info->tail = next;
+            result = tail;
+        }
+    }
+    // Otherwise a producer has exchanged head but not linked tail to it yet
+    return result;
+}
+
+MPMC_QUEUE_HANDLE mpmc_queue_create(size_t capacity)
+{
+    MPMC_QUEUE_INFO* result;
+    size_t cell_count = MIN_QUEUE_CAPACITY;
+    while (cell_count < capacity && cell_count <= SIZE_MAX/2)
+    {
+        cell_count <<= 1;
+    }
+
+    if (capacity == 0 || cell_count < capacity || cell_count > SIZE_MAX/sizeof(QUEUE_CELL))
+    {
+        log_error("Invalid queue capacity %zu", capacity);
+        result = NULL;
+    }
+    else if ((result = (MPMC_QUEUE_INFO*)malloc(sizeof(MPMC_QUEUE_INFO))) == NULL)
+    {
+        log_error("Failure allocating queue");
+    }
+    else if ((result->cells = (QUEUE_CELL*)malloc(sizeof(QUEUE_CELL)*cell_count)) == NULL)
+    {
+        log_error("Failure allocating queue cells");
+        free(result);
+        result = NULL;
+    }
+    else if (init_queue_signal(&result->queue_signal) != 0)
+    {
+        log_error("Failure initializing queue signal");
+        free(result->cells);
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        // Each cell's sequence is the enqueue position it's free for
+        for (size_t index = 0; index < cell_count; index++)
+        {
+            result->cells[index].sequence = (int64_t)index;
+            result->cells[index].item = NULL;
+        }
+        result->mask = cell_count - 1;
+        result->enqueue_pos = 0;
+        result->dequeue_pos = 0;
+    }
+    return result;
+}
+
+void mpmc_queue_destroy(MPMC_QUEUE_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        deinit_queue_signal(&handle->queue_signal);
+        free(handle->cells);
+        free(handle);
+    }
+}
+
+int mpmc_queue_push(MPMC_QUEUE_HANDLE handle, void* item)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = __LINE__;
+    }
+    else
+    {
+        QUEUE_CELL* cell;
+        int64_t pos = atomic_load64(&handle->enqueue_pos);
+        do
+        {
+            cell = &handle->cells[(size_t)pos & handle->mask];
+            int64_t diff = atomic_load64(&cell->sequence) - pos;
+            if (diff == 0)
+            {
+                // The cell is free for this position, claim it
+                if (atomic_compare_exchange64(&handle->enqueue_pos, pos, pos + 1))
+                {
+                    result = 0;
+                    break;
+                }
+                pos = atomic_load64(&handle->enqueue_pos);
+            }
+            else if (diff < 0)
+            {
+                // The consumer a lap behind hasn't emptied the cell, the queue is full
+                result = __LINE__;
+                break;
+            }
+            else
+            {
+                // Another producer took the position first
+                pos = atomic_load64(&handle->enqueue_pos);
+            }
+        } while (true);
+
+        if (result == 0)
+        {
+            cell->item = item;
+            // Publishes the item to the consumer of this position
+            atomic_store64(&cell->sequence, pos + 1);
+            notify_queue_signal(&handle->queue_signal);
+        }
+    }
+    return result;
+}
+
+int mpmc_queue_try_pop(MPMC_QUEUE_HANDLE handle, void** item)
+{
+    int result;
+    if (handle == NULL || item == NULL)
+    {
+        log_error("Invalid parameter handle: %p, item: %p", handle, item);
+        result = __LINE__;
+    }
+    else
+    {
+        result = try_pop_mpmc_item(handle, item);
+    }
+    return result;
+}
+
+int mpmc_queue_pop(MPMC_QUEUE_HANDLE handle, void** item)
+{
+    int result;
+    if (handle == NULL || item == NULL)
+    {
+        log_error("Invalid parameter handle: %p, item: %p", handle, item);
+        result = __LINE__;
+    }
+    else
+    {
+        // Spin briefly before paying for a sleep
+        for (size_t index = 0; index < POP_SPIN_COUNT; index++)
+        {
+            if ((result = try_pop_mpmc_item(handle, item)) == 0)
+            {
+                break;
+            }
+        }
+
+        while (result != 0)
+        {
+            QUEUE_SIGNAL* queue_signal = &handle->queue_signal;
+            bool wait_failed = false;
+            // waiters only changes under the lock, the atomics publish it to producers
+            (void)mutex_mgr_lock(queue_signal->lock);
+            atomic_store64(&queue_signal->waiters, atomic_load64(&queue_signal->waiters) + 1);
+            if ((result = try_pop_mpmc_item(handle, item)) != 0 &&
+                condition_mgr_wait(queue_signal->signal, queue_signal->lock) != 0)
+            {
+                log_error("Failure waiting for queue item");
+                wait_failed = true;
+            }
+            atomic_store64(&queue_signal->waiters, atomic_load64(&queue_signal->waiters) - 1);
+            (void)mutex_mgr_unlock(queue_signal->lock);
+            if (wait_failed)
+            {
+                break;
+            }
+            else if (result != 0)
+            {
+                result = try_pop_mpmc_item(handle, item);
+            }
+        }
+    }
+    return result;
+}
+
+MPSC_QUEUE_HANDLE mpsc_queue_create(void)
+{
+    MPSC_QUEUE_INFO* result;
+    if ((result = (MPSC_QUEUE_INFO*)malloc(sizeof(MPSC_QUEUE_INFO))) == NULL)
+    {
+        log_error("Failure allocating queue");
+    }
+    else if (init_queue_signal(&result->queue_signal) != 0)
+    {
+        log_error("Failure initializing queue signal");
+        free(result);
+        result = NULL;
+    }
+    else
+    {
+        result->stub.fwd_link = NULL;
+        result->stub.bk_link = NULL;
+        result->head = &result->stub;
+        result->tail = &result->stub;
+    }
+    return result;
+}
+
+void mpsc_queue_destroy(MPSC_QUEUE_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        deinit_queue_signal(&handle->queue_signal);
+        free(handle);
+    }
+}
+
+int mpsc_queue_push(MPSC_QUEUE_HANDLE handle, PDLLIST_ENTRY entry)
+{
+    int result;
+    if (handle == NULL || entry == NULL)
+    {
+        log_error("Invalid parameter handle: %p, entry: %p", handle, entry);
+        result = __LINE__;
+    }
+    else
+    {
+        entry->bk_link = NULL;
+        push_mpsc_entry(handle, entry);
+        notify_queue_signal(&handle->queue_signal);
+        result = 0;
+    }
+    return result;
+}
+
+PDLLIST_ENTRY mpsc_queue_try_pop(MPSC_QUEUE_HANDLE handle)
+{
+    PDLLIST_ENTRY result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = NULL;
+    }
+    else
+    {
+        result = try_pop_mpsc_entry(handle);
+    }
+    return result;
+}
+
+PDLLIST_ENTRY mpsc_queue_pop(MPSC_QUEUE_HANDLE handle)
+{
+    PDLLIST_ENTRY result = NULL;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+    }
+    else
+    {
+        // Spin briefly before paying for a sleep
+        for (size_t index = 0; index < POP_SPIN_COUNT && result == NULL; index++)
+        {
+            result = try_pop_mpsc_entry(handle);
+        }
+
+        while (result == NULL)
+        {
+            QUEUE_SIGNAL* queue_signal = &handle->queue_signal;
+            bool wait_failed = false;
+            (void)mutex_mgr_lock(queue_signal->lock);
+            atomic_store64(&queue_signal->waiters, 1);
+            if ((result = try_pop_mpsc_entry(handle)) == NULL &&
+                condition_mgr_wait(queue_signal->signal, queue_signal->lock) != 0)
+            {
+                log_error("Failure waiting for queue entry");
+                wait_failed = true;
+            }
+            atomic_store64(&queue_signal->waiters, 0);
+            (void)mutex_mgr_unlock(queue_signal->lock);
+            if (wait_failed)
+            {
+                break;
+            }
+            else if (result == NULL)
+            {
+                result = try_pop_mpsc_entry(handle);
+            }
+        }
+    }
+    return result;
+}
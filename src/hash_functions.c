@@ -0,0 +1,595 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/hash_functions.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/atomic_operations.h"
+#include "lib-util-c/random_mgr.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define USE_SSE2_STRIPES
+#endif
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+#include <intrin.h>
+#endif
+
+#define WYHASH_SECRET_0             0x2d358dccaa6c78a5ull
+#define WYHASH_SECRET_1             0x8bb84b93962eacc9ull
+#define WYHASH_SECRET_2             0x4b33a62ed433d4a3ull
+#define WYHASH_SECRET_3             0x4d5a2da51de1aa47ull
+
+#define XXH_PRIME32_1               0x9E3779B1U
+#define XXH_PRIME32_2               0x85EBCA77U
+#define XXH_PRIME32_3               0xC2B2AE3DU
+#define XXH_PRIME64_1               0x9E3779B185EBCA87ULL
+#define XXH_PRIME64_2               0xC2B2AE3D27D4EB4FULL
+#define XXH_PRIME64_3               0x165667B19E3779F9ULL
+#define XXH_PRIME64_4               0x85EBCA77C2B2AE63ULL
+#define XXH_PRIME64_5               0x27D4EB2F165667C5ULL
+#define XXH_PRIME_MX1               0x165667919E3779F9ULL
+#define XXH_PRIME_MX2               0x9FB21C651E98DF25ULL
+
+#define XXH3_SECRET_SIZE            192
+#define XXH3_STRIPE_LEN             64
+#define XXH3_SECRET_CONSUME_RATE    8
+#define XXH3_ACC_NB                 8
+#define XXH3_MIDSIZE_MAX            240
+#define XXH3_MIDSIZE_STARTOFFSET    3
+#define XXH3_MIDSIZE_LASTOFFSET     17
+#define XXH3_SECRET_SIZE_MIN        136
+#define XXH3_SECRET_LASTACC_START   7
+#define XXH3_SECRET_MERGEACCS_START 11
+
+#define SIPHASH_INIT_0              0x736f6d6570736575ULL
+#define SIPHASH_INIT_1              0x646f72616e646f6dULL
+#define SIPHASH_INIT_2              0x6c7967656e657261ULL
+#define SIPHASH_INIT_3              0x7465646279746573ULL
+
+#define SIPHASH_KEY_UNSEEDED        0
+#define SIPHASH_KEY_SEEDING         1
+#define SIPHASH_KEY_SEEDED          2
+
+// Default secret used by XXH3, taken from the reference implementation
+static const unsigned char XXH3_DEFAULT_SECRET[XXH3_SECRET_SIZE] =
+{
+    0xb8, 0xfe, 0x6c, 0x39, 0x23, 0xa4, 0x4b, 0xbe, 0x7c, 0x01, 0x81, 0x2c, 0xf7, 0x21, 0xad, 0x1c,
+    0xde, 0xd4, 0x6d, 0xe9, 0x83, 0x90, 0x97, 0xdb, 0x72, 0x40, 0xa4, 0xa4, 0xb7, 0xb3, 0x67, 0x1f,
+    0xcb, 0x79, 0xe6, 0x4e, 0xcc, 0xc0, 0xe5, 0x78, 0x82, 0x5a, 0xd0, 0x7d, 0xcc, 0xff, 0x72, 0x21,
+    0xb8, 0x08, 0x46, 0x74, 0xf7, 0x43, 0x24, 0x8e, 0xe0, 0x35, 0x90, 0xe6, 0x81, 0x3a, 0x26, 0x4c,
+    0x3c, 0x28, 0x52, 0xbb, 0x91, 0xc3, 0x00, 0xcb, 0x88, 0xd0, 0x65, 0x8b, 0x1b, 0x53, 0x2e, 0xa3,
+    0x71, 0x64, 0x48, 0x97, 0xa2, 0x0d, 0xf9, 0x4e, 0x38, 0x19, 0xef, 0x46, 0xa9, 0xde, 0xac, 0xd8,
+    0xa8, 0xfa, 0x76, 0x3f, 0xe3, 0x9c, 0x34, 0x3f, 0xf9, 0xdc, 0xbb, 0xc7, 0xc7, 0x0b, 0x4f, 0x1d,
+    0x8a, 0x51, 0xe0, 0x4b, 0xcd, 0xb4, 0x59, 0x31, 0xc8, 0x9f, 0x7e, 0xc9, 0xd9, 0x78, 0x73, 0x64,
+    0xea, 0xc5, 0xac, 0x83, 0x34, 0xd3, 0xeb, 0xc3, 0xc5, 0x81, 0xa0, 0xff, 0xfa, 0x13, 0x63, 0xeb,
+    0x17, 0x0d, 0xdd, 0x51, 0xb7, 0xf0, 0xda, 0x49, 0xd3, 0x16, 0x55, 0x26, 0x29, 0xd4, 0x68, 0x9e,
+    0x2b, 0x16, 0xbe, 0x58, 0x7d, 0x47, 0xa1, 0xfc, 0x8f, 0xf8, 0xb8, 0xd1, 0x7a, 0xd0, 0x31, 0xce,
+    0x45, 0xcb, 0x3a, 0x8f, 0x95, 0x16, 0x04, 0x28, 0xaf, 0xd7, 0xfb, 0xca, 0xbb, 0x4b, 0x40, 0x7e,
+};
+
+// Key used by hash_siphash_string, filled from the OS random source the
+// first time it is needed so each process hashes differently
+static unsigned char g_siphash_key[HASH_SIPHASH_KEY_SIZE];
+static int64_t g_siphash_key_state = SIPHASH_KEY_UNSEEDED;
+
+// Unaligned little endian reads, memcpy compiles down to a single load
+static uint64_t read_le64(const unsigned char* ptr)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return (uint64_t)ptr[0] | ((uint64_t)ptr[1] << 8) | ((uint64_t)ptr[2] << 16) | ((uint64_t)ptr[3] << 24) |
+        ((uint64_t)ptr[4] << 32) | ((uint64_t)ptr[5] << 40) | ((uint64_t)ptr[6] << 48) | ((uint64_t)ptr[7] << 56);
+#else
+    uint64_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+#endif
+}
+
+static uint32_t read_le32(const unsigned char* ptr)
+{
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    return (uint32_t)ptr[0] | ((uint32_t)ptr[1] << 8) | ((uint32_t)ptr[2] << 16) | ((uint32_t)ptr[3] << 24);
+#else
+    uint32_t result;
+    memcpy(&result, ptr, sizeof(result));
+    return result;
+#endif
+}
+
+static void write_le64(unsigned char* ptr, uint64_t value)
+{
+    for (size_t index = 0; index < sizeof(value); index++)
+    {
+        ptr[index] = (unsigned char)(value >> (index * 8));
+    }
+}
+
+static uint64_t rotate_left64(uint64_t value, unsigned int bits)
+{
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static uint32_t swap_bytes32(uint32_t value)
+{
+    return ((value << 24) & 0xff000000) | ((value << 8) & 0x00ff0000) |
+        ((value >> 8) & 0x0000ff00) | ((value >> 24) & 0x000000ff);
+}
+
+static uint64_t swap_bytes64(uint64_t value)
+{
+    return ((uint64_t)swap_bytes32((uint32_t)value) << 32) | (uint64_t)swap_bytes32((uint32_t)(value >> 32));
+}
+
+// Full 64x64 -> 128 bit multiply, the low and high halves are returned
+// through the parameters
+static void multiply_128(uint64_t* low, uint64_t* high)
+{
+#if defined(__SIZEOF_INT128__)
+    __uint128_t product = (__uint128_t)(*low) * (*high);
+    *low = (uint64_t)product;
+    *high = (uint64_t)(product >> 64);
+#elif defined(_MSC_VER) && defined(_M_X64)
+    *low = _umul128(*low, *high, high);
+#elif defined(_MSC_VER) && defined(_M_ARM64)
+    uint64_t lhs = *low;
+    *low = lhs * (*high);
+    *high = __umulh(lhs, *high);
+#else
+    uint64_t lhs = *low;
+    uint64_t rhs = *high;
+    uint64_t lo_lo = (lhs & 0xFFFFFFFF) * (rhs & 0xFFFFFFFF);
+    uint64_t hi_lo = (lhs >> 32) * (rhs & 0xFFFFFFFF);
+    uint64_t lo_hi = (lhs & 0xFFFFFFFF) * (rhs >> 32);
+    uint64_t hi_hi = (lhs >> 32) * (rhs >> 32);
+    uint64_t cross = (lo_lo >> 32) + (hi_lo & 0xFFFFFFFF) + lo_hi;
+    *high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+    *low = (cross << 32) | (lo_lo & 0xFFFFFFFF);
+#endif
+}
+
+static uint64_t multiply_fold64(uint64_t lhs, uint64_t rhs)
+{
+    multiply_128(&lhs, &rhs);
+    return lhs ^ rhs;
+}
+
+// Reduce a 64 bit hash to the 32 bits item_map expects, keeping entropy
+// from both halves
+static uint32_t fold_hash32(uint64_t hash)
+{
+    return (uint32_t)(hash ^ (hash >> 32));
+}
+
+static uint64_t wyhash_read_small(const unsigned char* ptr, size_t len)
+{
+    return ((uint64_t)ptr[0] << 16) | ((uint64_t)ptr[len >> 1] << 8) | ptr[len - 1];
+}
+
+static uint64_t xxh64_avalanche(uint64_t hash)
+{
+    hash ^= hash >> 33;
+    hash *= XXH_PRIME64_2;
+    hash ^= hash >> 29;
+    hash *= XXH_PRIME64_3;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static uint64_t xxh3_avalanche(uint64_t hash)
+{
+    hash ^= hash >> 37;
+    hash *= XXH_PRIME_MX1;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+static uint64_t xxh3_rrmxmx(uint64_t hash, uint64_t len)
+{
+    hash ^= rotate_left64(hash, 49) ^ rotate_left64(hash, 24);
+    hash *= XXH_PRIME_MX2;
+    hash ^= (hash >> 35) + len;
+    hash *= XXH_PRIME_MX2;
+    return hash ^ (hash >> 28);
+}
+
+static uint64_t xxh3_mix16(const unsigned char* input, const unsigned char* secret, uint64_t seed)
+{
+    uint64_t input_lo = read_le64(input);
+    uint64_t input_hi = read_le64(input + 8);
+    return multiply_fold64(input_lo ^ (read_le64(secret) + seed), input_hi ^ (read_le64(secret + 8) - seed));
+}
+
+static uint64_t xxh3_len_1to3(const unsigned char* input, size_t len, const unsigned char* secret, uint64_t seed)
+{
+    uint32_t combined = ((uint32_t)input[0] << 16) | ((uint32_t)input[len >> 1] << 24) | (uint32_t)input[len - 1] | ((uint32_t)len << 8);
+    uint64_t bitflip = (uint64_t)(read_le32(secret) ^ read_le32(secret + 4)) + seed;
+    return xxh64_avalanche((uint64_t)combined ^ bitflip);
+}
+
+static uint64_t xxh3_len_4to8(const unsigned char* input, size_t len, const unsigned char* secret, uint64_t seed)
+{
+    seed ^= (uint64_t)swap_bytes32((uint32_t)seed) << 32;
+    uint64_t bitflip = (read_le64(secret + 8) ^ read_le64(secret + 16)) - seed;
+    uint64_t combined = (uint64_t)read_le32(input + len - 4) + ((uint64_t)read_le32(input) << 32);
+    return xxh3_rrmxmx(combined ^ bitflip, len);
+}
+
+static uint64_t xxh3_len_9to16(const unsigned char* input, size_t len, const unsigned char* secret, uint64_t seed)
+{
+    uint64_t bitflip_lo = (read_le64(secret + 24) ^ read_le64(secret + 32)) + seed;
+    uint64_t bitflip_hi = (read_le64(secret + 40) ^ read_le64(secret + 48)) - seed;
+    uint64_t input_lo = read_le64(input) ^ bitflip_lo;
+    uint64_t input_hi = read_le64(input + len - 8) ^ bitflip_hi;
+    uint64_t acc = len + swap_bytes64(input_lo) + input_hi + multiply_fold64(input_lo, input_hi);
+    return xxh3_avalanche(acc);
+}
+
+static uint64_t xxh3_len_17to128(const unsigned char* input, size_t len, const unsigned char* secret, uint64_t seed)
+{
+    uint64_t acc = len * XXH_PRIME64_1;
+    if (len > 32)
+    {
+        if (len > 64)
+        {
+            if (len > 96)
+            {
+                acc += xxh3_mix16(input + 48, secret + 96, seed);
+                acc += xxh3_mix16(input + len - 64, secret + 112, seed);
+            }
+            acc += xxh3_mix16(input + 32, secret + 64, seed);
+            acc += xxh3_mix16(input + len - 48, secret + 80, seed);
+        }
+        acc += xxh3_mix16(input + 16, secret + 32, seed);
+        acc += xxh3_mix16(input + len - 32, secret + 48, seed);
+    }
+    acc += xxh3_mix16(input, secret, seed);
+    acc += xxh3_mix16(input + len - 16, secret + 16, seed);
+    return xxh3_avalanche(acc);
+}
+
+static uint64_t xxh3_len_129to240(const unsigned char* input, size_t len, const unsigned char* secret, uint64_t seed)
+{
+    uint64_t acc = len * XXH_PRIME64_1;
+    size_t round_count = len / 16;
+    for (size_t index = 0; index < 8; index++)
+    {
+        acc += xxh3_mix16(input + (16 * index), secret + (16 * index), seed);
+    }
+    acc = xxh3_avalanche(acc);
+    for (size_t index = 8; index < round_count; index++)
+    {
+        acc += xxh3_mix16(input + (16 * index), secret + (16 * (index - 8)) + XXH3_MIDSIZE_STARTOFFSET, seed);
+    }
+    acc += xxh3_mix16(input + len - 16, secret + XXH3_SECRET_SIZE_MIN - XXH3_MIDSIZE_LASTOFFSET, seed);
+    return xxh3_avalanche(acc);
+}
+
+static void xxh3_accumulate_stripe(uint64_t* acc, const unsigned char* input, const unsigned char* secret)
+{
+#if defined(USE_SSE2_STRIPES)
+    // Two lanes per register, same arithmetic as the scalar loop below
+    for (size_t index = 0; index < XXH3_ACC_NB / 2; index++)
+    {
+        __m128i acc_vec = _mm_loadu_si128((const __m128i*)(acc + (2 * index)));
+        __m128i data_vec = _mm_loadu_si128((const __m128i*)(input + (16 * index)));
+        __m128i key_vec = _mm_loadu_si128((const __m128i*)(secret + (16 * index)));
+        __m128i data_key = _mm_xor_si128(data_vec, key_vec);
+        __m128i product = _mm_mul_epu32(data_key, _mm_shuffle_epi32(data_key, _MM_SHUFFLE(0, 3, 0, 1)));
+        __m128i data_swap = _mm_shuffle_epi32(data_vec, _MM_SHUFFLE(1, 0, 3, 2));
+        acc_vec = _mm_add_epi64(acc_vec, _mm_add_epi64(product, data_swap));
+        _mm_storeu_si128((__m128i*)(acc + (2 * index)), acc_vec);
+    }
+#else
+    for (size_t index = 0; index < XXH3_ACC_NB; index++)
+    {
+        uint64_t data_value = read_le64(input + (8 * index));
+        uint64_t data_key = data_value ^ read_le64(secret + (8 * index));
+        acc[index ^ 1] += data_value;
+        acc[index] += (uint64_t)(uint32_t)data_key * (data_key >> 32);
+    }
+#endif
+}
+
+static void xxh3_scramble(uint64_t* acc, const unsigned char* secret)
+{
+    for (size_t index = 0; index < XXH3_ACC_NB; index++)
+    {
+        uint64_t value = acc[index];
+        value ^= value >> 47;
+        value ^= read_le64(secret + (8 * index));
+        value *= XXH_PRIME32_1;
+        acc[index] = value;
+    }
+}
+
+static uint64_t xxh3_hash_long(const unsigned char* input, size_t len, uint64_t seed)
+{
+    unsigned char custom_secret[XXH3_SECRET_SIZE];
+    const unsigned char* secret = XXH3_DEFAULT_SECRET;
+    if (seed != 0)
+    {
+        for (size_t index = 0; index < XXH3_SECRET_SIZE; index += 16)
+        {
+            write_le64(custom_secret + index, read_le64(XXH3_DEFAULT_SECRET + index) + seed);
+            write_le64(custom_secret + index + 8, read_le64(XXH3_DEFAULT_SECRET + index + 8) - seed);
+        }
+        secret = custom_secret;
+    }
+
+    uint64_t acc[XXH3_ACC_NB] = { XXH_PRIME32_3, XXH_PRIME64_1, XXH_PRIME64_2, XXH_PRIME64_3,
+        XXH_PRIME64_4, XXH_PRIME32_2, XXH_PRIME64_5, XXH_PRIME32_1 };
+    size_t stripes_per_block = (XXH3_SECRET_SIZE - XXH3_STRIPE_LEN) / XXH3_SECRET_CONSUME_RATE;
+    size_t block_len = XXH3_STRIPE_LEN * stripes_per_block;
+    size_t block_count = (len - 1) / block_len;
+
+    for (size_t block = 0; block < block_count; block++)
+    {
+        const unsigned char* block_input = input + (block * block_len);
+        for (size_t stripe = 0; stripe < stripes_per_block; stripe++)
+        {
+            xxh3_accumulate_stripe(acc, block_input + (stripe * XXH3_STRIPE_LEN), secret + (stripe * XXH3_SECRET_CONSUME_RATE));
+        }
+        xxh3_scramble(acc, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN);
+    }
+
+    // Partial last block followed by the final stripe which may overlap it
+    size_t stripe_count = ((len - 1) - (block_len * block_count)) / XXH3_STRIPE_LEN;
+    const unsigned char* last_block = input + (block_count * block_len);
+    for (size_t stripe = 0; stripe < stripe_count; stripe++)
+    {
+        xxh3_accumulate_stripe(acc, last_block + (stripe * XXH3_STRIPE_LEN), secret + (stripe * XXH3_SECRET_CONSUME_RATE));
+    }
+    xxh3_accumulate_stripe(acc, input + len - XXH3_STRIPE_LEN, secret + XXH3_SECRET_SIZE - XXH3_STRIPE_LEN - XXH3_SECRET_LASTACC_START);
+
+    uint64_t result = len * XXH_PRIME64_1;
+    for (size_t index = 0; index < XXH3_ACC_NB / 2; index++)
+    {
+        const unsigned char* merge_secret = secret + XXH3_SECRET_MERGEACCS_START + (16 * index);
+        result += multiply_fold64(acc[2 * index] ^ read_le64(merge_secret), acc[(2 * index) + 1] ^ read_le64(merge_secret + 8));
+    }
+    return xxh3_avalanche(result);
+}
+
+#define SIPHASH_ROUND(v0, v1, v2, v3)   \
+    do {                                \
+        v0 += v1;                       \
+        v1 = rotate_left64(v1, 13);     \
+        v1 ^= v0;                       \
+        v0 = rotate_left64(v0, 32);     \
+        v2 += v3;                       \
+        v3 = rotate_left64(v3, 16);     \
+        v3 ^= v2;                       \
+        v0 += v3;                       \
+        v3 = rotate_left64(v3, 21);     \
+        v3 ^= v0;                       \
+        v2 += v1;                       \
+        v1 = rotate_left64(v1, 17);     \
+        v1 ^= v2;                       \
+        v2 = rotate_left64(v2, 32);     \
+    } while (0)
+
+static uint64_t calculate_siphash(const unsigned char* input, size_t len, const unsigned char* key)
+{
+    uint64_t key_0 = read_le64(key);
+    uint64_t key_1 = read_le64(key + 8);
+    uint64_t v0 = SIPHASH_INIT_0 ^ key_0;
+    uint64_t v1 = SIPHASH_INIT_1 ^ key_1;
+    uint64_t v2 = SIPHASH_INIT_2 ^ key_0;
+    uint64_t v3 = SIPHASH_INIT_3 ^ key_1;
+
+    const unsigned char* end = input + (len - (len % 8));
+    for (; input != end; input += 8)
+    {
+        uint64_t message = read_le64(input);
+        v3 ^= message;
+        SIPHASH_ROUND(v0, v1, v2, v3);
+        SIPHASH_ROUND(v0, v1, v2, v3);
+        v0 ^= message;
+    }
+
+    uint64_t last_word = ((uint64_t)len) << 56;
+    for (size_t index = 0; index < len % 8; index++)
+    {
+        last_word |= ((uint64_t)input[index]) << (8 * index);
+    }
+    v3 ^= last_word;
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    v0 ^= last_word;
+
+    v2 ^= 0xff;
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    SIPHASH_ROUND(v0, v1, v2, v3);
+    return v0 ^ v1 ^ v2 ^ v3;
+}
+
+uint64_t hash_wyhash(const void* data, size_t len, uint64_t seed)
+{
+    const unsigned char* input = (const unsigned char*)data;
+    uint64_t value_a;
+    uint64_t value_b;
+
+    seed ^= multiply_fold64(seed ^ WYHASH_SECRET_0, WYHASH_SECRET_1);
+    if (input == NULL || len == 0)
+    {
+        value_a = value_b = 0;
+    }
+    else if (len <= 16)
+    {
+        if (len >= 4)
+        {
+            value_a = ((uint64_t)read_le32(input) << 32) | read_le32(input + ((len >> 3) << 2));
+            value_b = ((uint64_t)read_le32(input + len - 4) << 32) | read_le32(input + len - 4 - ((len >> 3) << 2));
+        }
+        else
+        {
+            value_a = wyhash_read_small(input, len);
+            value_b = 0;
+        }
+    }
+    else
+    {
+        size_t remaining = len;
+        if (remaining > 48)
+        {
+            uint64_t seed_1 = seed;
+            uint64_t seed_2 = seed;
+            do
+            {
+                seed = multiply_fold64(read_le64(input) ^ WYHASH_SECRET_1, read_le64(input + 8) ^ seed);
+                seed_1 = multiply_fold64(read_le64(input + 16) ^ WYHASH_SECRET_2, read_le64(input + 24) ^ seed_1);
+                seed_2 = multiply_fold64(read_le64(input + 32) ^ WYHASH_SECRET_3, read_le64(input + 40) ^ seed_2);
+                input += 48;
+                remaining -= 48;
+            } while (remaining > 48);
+            seed ^= seed_1 ^ seed_2;
+        }
+        while (remaining > 16)
+        {
+            seed = multiply_fold64(read_le64(input) ^ WYHASH_SECRET_1, read_le64(input + 8) ^ seed);
+            input += 16;
+            remaining -= 16;
+        }
+        // The tail always reads the final 16 bytes of the buffer
+        value_a = read_le64(input + remaining - 16);
+        value_b = read_le64(input + remaining - 8);
+    }
+    value_a ^= WYHASH_SECRET_1;
+    value_b ^= seed;
+    multiply_128(&value_a, &value_b);
+    return multiply_fold64(value_a ^ WYHASH_SECRET_0 ^ len, value_b ^ WYHASH_SECRET_1);
+}
+
+uint64_t hash_xxh3(const void* data, size_t len, uint64_t seed)
+{
+    uint64_t result;
+    const unsigned char* input = (const unsigned char*)data;
+    const unsigned char* secret = XXH3_DEFAULT_SECRET;
+    if (input == NULL || len == 0)
+    {
+        result = xxh64_avalanche(seed ^ read_le64(secret + 56) ^ read_le64(secret + 64));
+    }
+    else if (len <= 3)
+    {
+        result = xxh3_len_1to3(input, len, secret, seed);
+    }
+    else if (len <= 8)
+    {
+        result = xxh3_len_4to8(input, len, secret, seed);
+    }
+    else if (len <= 16)
+    {
+        result = xxh3_len_9to16(input, len, secret, seed);
+    }
+    else if (len <= 128)
+    {
+        result = xxh3_len_17to128(input, len, secret, seed);
+    }
+    else if (len <= XXH3_MIDSIZE_MAX)
+    {
+        result = xxh3_len_129to240(input, len, secret, seed);
+    }
+    else
+    {
+        result = xxh3_hash_long(input, len, seed);
+    }
+    return result;
+}
+
+uint64_t hash_siphash(const void* data, size_t len, const unsigned char* key)
+{
+    uint64_t result;
+    if (key == NULL)
+    {
+        log_error("Invalid parameter key NULL");
+        result = 0;
+    }
+    else if (data == NULL && len != 0)
+    {
+        log_error("Invalid parameter data NULL with length %zu", len);
+        result = 0;
+    }
+    else
+    {
+        result = calculate_siphash((const unsigned char*)data, len, key);
+    }
+    return result;
+}
+
+static const unsigned char* get_siphash_key(void)
+{
+    if (atomic_load64(&g_siphash_key_state) != SIPHASH_KEY_SEEDED)
+    {
+        if (atomic_compare_exchange64(&g_siphash_key_state, SIPHASH_KEY_UNSEEDED, SIPHASH_KEY_SEEDING))
+        {
+            if (random_mgr_get_bytes(g_siphash_key, HASH_SIPHASH_KEY_SIZE) != 0)
+            {
+                // Weaker than the OS source but still differs between
+                // processes, addresses move under ASLR
+                uint64_t fallback_seed = (uint64_t)(uintptr_t)&fallback_seed ^ ((uint64_t)(uintptr_t)g_siphash_key << 16) ^ (uint64_t)time(NULL);
+                log_error("Failure seeding the SipHash key, falling back to address and time");
+                write_le64(g_siphash_key, hash_wyhash(&fallback_seed, sizeof(fallback_seed), 0));
+                write_le64(g_siphash_key + sizeof(uint64_t), hash_wyhash(&fallback_seed, sizeof(fallback_seed), 1));
+            }
+            atomic_store64(&g_siphash_key_state, SIPHASH_KEY_SEEDED);
+        }
+        else
+        {
+            // Another thread is seeding, that is a single read of the OS source
+            while (atomic_load64(&g_siphash_key_state) != SIPHASH_KEY_SEEDED)
+            {
+            }
+        }
+    }
+    return g_siphash_key;
+}
+
+uint32_t hash_wyhash_string(const char* key)
+{
+    uint32_t result;
+    if (key == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        result = fold_hash32(hash_wyhash(key, strlen(key), 0));
+    }
+    return result;
+}
+
+uint32_t hash_xxh3_string(const char* key)
+{
+    uint32_t result;
+    if (key == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        result = fold_hash32(hash_xxh3(key, strlen(key), 0));
+    }
+    return result;
+}
+
+uint32_t hash_siphash_string(const char* key)
+{
+    uint32_t result;
+    if (key == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        result = fold_hash32(calculate_siphash((const unsigned char*)key, strlen(key), get_siphash_key()));
+    }
+    return result;
+}
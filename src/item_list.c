@@ -3,11 +3,14 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
 #include <time.h>
 
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/item_list.h"
 #include "lib-util-c/app_logging.h"
+#include "lib-util-c/node_pool.h"
 
 typedef struct ITEM_NODE_TAG
 {
@@ -16,11 +19,25 @@ typedef struct ITEM_NODE_TAG
     bool locally_allocated;
 } ITEM_NODE;
 
+#define DEFAULT_ARRAY_CAPACITY      8
+
 typedef struct ITEM_LIST_INFO_TAG
 {
     size_t item_count;
+    uint32_t options;
     ITEM_NODE* head_node;
     ITEM_NODE* tail_node;
+    // Contiguous storage used by ITEM_LIST_OPTION_ARRAY, the next
+    // field of the nodes is unused
+    ITEM_NODE* item_array;
+    size_t array_capacity;
+    // Slots freed by item_list_iterator_remove_current, the hole starts
+    // at logical index gap_index and slides forward with the walk so a
+    // sweep never shifts the whole tail
+    size_t gap_index;
+    size_t gap_count;
+    // Recycled nodes used by ITEM_LIST_OPTION_NODE_POOL
+    NODE_POOL node_pool;
     ITEM_LIST_DESTROY_ITEM destroy_cb;
     void* user_ctx;
     ITEM_NODE* iterator;
@@ -31,10 +48,119 @@ typedef struct ITEM_ITERATOR_TAG
     struct ITEM_NODE_TAG* item;
 } ITEM_ITERATOR;
 
+static void destroy_node_item(ITEM_LIST_INFO* list_info, ITEM_NODE* node)
+{
+    if (node->locally_allocated)
+    {
+        free(node->node_item);
+    }
+    else
+    {
+        if (list_info->destroy_cb != NULL)
+        {
+            list_info->destroy_cb(list_info->user_ctx, node->node_item);
+        }
+    }
+}
+
+static ITEM_NODE* allocate_node(ITEM_LIST_INFO* list_info)
+{
+    ITEM_NODE* result;
+    if (!(list_info->options & ITEM_LIST_OPTION_NODE_POOL))
+    {
+        result = (ITEM_NODE*)malloc(sizeof(ITEM_NODE));
+    }
+    else
+    {
+        result = (ITEM_NODE*)node_pool_allocate(&list_info->node_pool);
+    }
+    return result;
+}
+
+static void release_node(ITEM_LIST_INFO* list_info, ITEM_NODE* node)
+{
+    if (list_info->options & ITEM_LIST_OPTION_NODE_POOL)
+    {
+        node_pool_release(&list_info->node_pool, node);
+    }
+    else
+    {
+        free(node);
+    }
+}
+
+static ITEM_NODE* get_array_node(ITEM_LIST_INFO* list_info, size_t index)
+{
+    return &list_info->item_array[index < list_info->gap_index ? index : index + list_info->gap_count];
+}
+
+static void close_array_gap(ITEM_LIST_INFO* list_info)
+{
+    if (list_info->gap_count > 0)
+    {
+        memmove(&list_info->item_array[list_info->gap_index], &list_info->item_array[list_info->gap_index + list_info->gap_count],
+            (list_info->item_count - list_info->gap_index)*sizeof(ITEM_NODE));
+        list_info->gap_count = 0;
+    }
+}
+
+static int reserve_array_items(ITEM_LIST_INFO* list_info, size_t capacity)
+{
+    int result;
+    if (capacity <= list_info->array_capacity)
+    {
+        result = 0;
+    }
+    else if (capacity > SIZE_MAX / sizeof(ITEM_NODE))
+    {
+        log_error("Failure item array capacity %zu too large", capacity);
+        result = __LINE__;
+    }
+    else
+    {
+        ITEM_NODE* temp_array = (ITEM_NODE*)realloc(list_info->item_array, capacity*sizeof(ITEM_NODE));
+        if (temp_array == NULL)
+        {
+            log_error("Failure reallocating item array");
+            result = __LINE__;
+        }
+        else
+        {
+            list_info->item_array = temp_array;
+            list_info->array_capacity = capacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static int add_array_item(ITEM_LIST_INFO* list_info, void* item, bool local_alloc)
+{
+    int result;
+    close_array_gap(list_info);
+    // Double the array so appends are amortized O(1)
+    if (list_info->item_count == list_info->array_capacity &&
+        reserve_array_items(list_info, list_info->array_capacity == 0 ? DEFAULT_ARRAY_CAPACITY : list_info->array_capacity*2) != 0)
+    {
+        log_error("Failure growing item array");
+        result = __LINE__;
+    }
+    else
+    {
+        ITEM_NODE* target = &list_info->item_array[list_info->item_count];
+        target->node_item = item;
+        target->locally_allocated = local_alloc;
+        target->next = NULL;
+        list_info->item_count++;
+        result = 0;
+    }
+    return result;
+}
+
 static int add_new_item(ITEM_LIST_INFO* list_info, void* item, bool local_alloc)
 {
     int result;
-    ITEM_NODE* target = (ITEM_NODE*)malloc(sizeof(ITEM_NODE));
+    ITEM_NODE* target = allocate_node(list_info);
     if (target == NULL)
     {
         log_error("Failure allocating item node");
@@ -65,30 +191,101 @@ static int add_new_item(ITEM_LIST_INFO* list_info, void* item, bool local_alloc)
     return result;
 }
 
+static int insert_item(ITEM_LIST_INFO* list_info, void* item, bool local_alloc)
+{
+    int result;
+    if (list_info->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        result = add_array_item(list_info, item, local_alloc);
+    }
+    else
+    {
+        result = add_new_item(list_info, item, local_alloc);
+    }
+    return result;
+}
+
+static void remove_array_item(ITEM_LIST_INFO* list_info, size_t remove_index)
+{
+    close_array_gap(list_info);
+    destroy_node_item(list_info, &list_info->item_array[remove_index]);
+    // Shift the tail down to keep the items in insert order
+    memmove(&list_info->item_array[remove_index], &list_info->item_array[remove_index + 1],
+        (list_info->item_count - remove_index - 1)*sizeof(ITEM_NODE));
+    list_info->item_count--;
+}
+
+static void unlink_list_node(ITEM_LIST_INFO* list_info, ITEM_NODE* prev_item, ITEM_NODE* rm_pos)
+{
+    // If the iterator points to this item
+    // then move it
+    if (list_info->iterator == rm_pos)
+    {
+        list_info->iterator = rm_pos->next;
+    }
+
+    destroy_node_item(list_info, rm_pos);
+
+    // If prev item is NULL then we're moving the head node
+    if (prev_item == NULL)
+    {
+        list_info->head_node = rm_pos->next;
+    }
+    else
+    {
+        prev_item->next = rm_pos->next;
+    }
+    if (list_info->tail_node == rm_pos)
+    {
+        list_info->tail_node = prev_item;
+    }
+    list_info->item_count--;
+    release_node(list_info, rm_pos);
+}
+
+static void remove_list_item(ITEM_LIST_INFO* list_info, size_t remove_index)
+{
+    ITEM_NODE* rm_pos = list_info->head_node;
+    ITEM_NODE* prev_item = NULL;
+    for (size_t index = 0; index < remove_index; index++)
+    {
+        prev_item = rm_pos;
+        rm_pos = rm_pos->next;
+    }
+    unlink_list_node(list_info, prev_item, rm_pos);
+}
+
 static void clear_all_items(ITEM_LIST_INFO* list_info)
 {
-    for (size_t index = 0; index < list_info->item_count; index++)
+    if (list_info->options & ITEM_LIST_OPTION_ARRAY)
     {
-        ITEM_NODE* temp = list_info->head_node->next;
-        if (list_info->head_node->locally_allocated)
+        for (size_t index = 0; index < list_info->item_count; index++)
         {
-            free(list_info->head_node->node_item);
+            destroy_node_item(list_info, get_array_node(list_info, index));
         }
-        else
+        list_info->gap_count = 0;
+    }
+    else
+    {
+        for (size_t index = 0; index < list_info->item_count; index++)
         {
-            if (list_info->destroy_cb != NULL)
-            {
-                list_info->destroy_cb(list_info->user_ctx, list_info->head_node->node_item);
-            }
+            ITEM_NODE* temp = list_info->head_node->next;
+            destroy_node_item(list_info, list_info->head_node);
+            release_node(list_info, list_info->head_node);
+            list_info->head_node = temp;
         }
-        free(list_info->head_node);
-        list_info->head_node = temp;
+        list_info->tail_node = NULL;
     }
     list_info->item_count = 0;
     list_info->iterator = NULL;
 }
 
 ITEM_LIST_HANDLE item_list_create(ITEM_LIST_DESTROY_ITEM destroy_cb, void* user_ctx)
+{
+    return item_list_create_with_options(ITEM_LIST_OPTION_NONE, 0, destroy_cb, user_ctx);
+}
+
+ITEM_LIST_HANDLE item_list_create_with_options(uint32_t options, size_t capacity, ITEM_LIST_DESTROY_ITEM destroy_cb, void* user_ctx)
 {
     ITEM_LIST_INFO* result;
     if ((result = (ITEM_LIST_INFO*)malloc(sizeof(ITEM_LIST_INFO))) == NULL)
@@ -98,8 +295,31 @@ ITEM_LIST_HANDLE item_list_create(ITEM_LIST_DESTROY_ITEM destroy_cb, void* user_
     else
     {
         memset(result, 0, sizeof(ITEM_LIST_INFO));
+        result->options = options;
         result->destroy_cb = destroy_cb;
         result->user_ctx = user_ctx;
+        node_pool_init(&result->node_pool, sizeof(ITEM_NODE), offsetof(ITEM_NODE, next));
+        if (capacity > 0)
+        {
+            if (options & ITEM_LIST_OPTION_ARRAY)
+            {
+                if (reserve_array_items(result, capacity) != 0)
+                {
+                    log_error("Failure allocating item array");
+                    free(result);
+                    result = NULL;
+                }
+            }
+            else if (options & ITEM_LIST_OPTION_NODE_POOL)
+            {
+                if (node_pool_reserve(&result->node_pool, capacity) != 0)
+                {
+                    log_error("Failure preallocating item nodes");
+                    free(result);
+                    result = NULL;
+                }
+            }
+        }
     }
     return result;
 }
@@ -109,6 +329,8 @@ void item_list_destroy(ITEM_LIST_HANDLE handle)
     if (handle != NULL)
     {
         clear_all_items(handle);
+        node_pool_deinit(&handle->node_pool);
+        free(handle->item_array);
         free(handle);
     }
 }
@@ -123,7 +345,7 @@ int item_list_add_item(ITEM_LIST_HANDLE handle, const void* item)
     }
     else
     {
-        result = add_new_item(handle, (void*)item, false);
+        result = insert_item(handle, (void*)item, false);
     }
     return result;
 }
@@ -147,7 +369,7 @@ int item_list_add_copy(ITEM_LIST_HANDLE handle, const void* item, size_t item_si
         else
         {
             memcpy(new_item, item, item_size);
-            if (add_new_item(handle, new_item, true) != 0)
+            if (insert_item(handle, new_item, true) != 0)
             {
                 log_error("Failure adding new item");
                 free(new_item);
@@ -177,43 +399,14 @@ int item_list_remove_item(ITEM_LIST_HANDLE handle, size_t remove_index)
     }
     else
     {
-        ITEM_NODE* rm_pos = handle->head_node;
-        ITEM_NODE* prev_item = NULL;
-        for (size_t index = 0; index < remove_index; index++)
-        {
-            prev_item = rm_pos;
-            rm_pos = rm_pos->next;
-        }
-        // If the iterator points to this item
-        // then move it
-        if (handle->iterator == rm_pos)
+        if (handle->options & ITEM_LIST_OPTION_ARRAY)
         {
-            handle->iterator = rm_pos->next;
-        }
-
-        if (handle->head_node->locally_allocated)
-        {
-            free(rm_pos->node_item);
+            remove_array_item(handle, remove_index);
         }
         else
         {
-            if (handle->destroy_cb != NULL)
-            {
-                handle->destroy_cb(handle->user_ctx, rm_pos->node_item);
-            }
-        }
-
-        // If prev item is NULL then we're moving the head node
-        if (prev_item == NULL)
-        {
-            handle->head_node = rm_pos->next;
-        }
-        else
-        {
-            prev_item->next = rm_pos->next;
+            remove_list_item(handle, remove_index);
         }
-        handle->item_count--;
-        free(rm_pos);
         result = 0;
     }
     return result;
@@ -245,6 +438,10 @@ const void* item_list_get_item(ITEM_LIST_HANDLE handle, size_t item_index)
     {
         log_error("Invalid index size item_count: %zu item_index: %zu", handle->item_count, item_index);
     }
+    else if (handle->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        result = get_array_node(handle, item_index)->node_item;
+    }
     else
     {
         ITEM_NODE* pos = handle->head_node;
@@ -273,6 +470,10 @@ const void* item_list_get_front(ITEM_LIST_HANDLE handle)
     {
         result = NULL;
     }
+    else if (handle->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        result = get_array_node(handle, 0)->node_item;
+    }
     else
     {
         result = handle->head_node->node_item;
@@ -292,6 +493,11 @@ ITERATOR_HANDLE item_list_iterator(ITEM_LIST_HANDLE handle)
     {
         result = NULL;
     }
+    else if (handle->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        close_array_gap(handle);
+        result = handle->iterator = handle->item_array;
+    }
     else
     {
         result = handle->iterator = handle->head_node;
@@ -309,19 +515,157 @@ const void* item_list_get_next(ITEM_LIST_HANDLE handle, ITERATOR_HANDLE* iterato
     }
     else
     {
+        if (handle->options & ITEM_LIST_OPTION_ARRAY)
+        {
+            // Pointer walks need the items contiguous
+            close_array_gap(handle);
+        }
         if ((*iterator) == NULL)
         {
             result = NULL;
         }
+        else if ((handle->options & ITEM_LIST_OPTION_ARRAY) && (*iterator) >= handle->item_array + handle->item_count)
+        {
+            // Items were removed behind the walk, the position is past the live items
+            *iterator = NULL;
+            result = NULL;
+        }
         else
         {
             result = (*iterator)->node_item;
-            *iterator = (*iterator)->next;
+            if (handle->options & ITEM_LIST_OPTION_ARRAY)
+            {
+                // Array iterators walk the storage directly
+                if (++(*iterator) >= handle->item_array + handle->item_count)
+                {
+                    *iterator = NULL;
+                }
+            }
+            else
+            {
+                *iterator = (*iterator)->next;
+            }
+        }
+    }
+    return result;
+}
+
+int item_list_iterator_init(ITEM_LIST_HANDLE handle, ITEM_LIST_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        iterator->index = 0;
+        iterator->prev_node = NULL;
+        iterator->current_node = NULL;
+        iterator->next_node = handle->head_node;
+        result = 0;
+    }
+    return result;
+}
+
+const void* item_list_iterator_next(ITEM_LIST_HANDLE handle, ITEM_LIST_ITERATOR* iterator)
+{
+    const void* result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = NULL;
+    }
+    else if (handle->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        if (iterator->index >= handle->item_count)
+        {
+            // The hole has slid past the last item so the array is compact
+            if (handle->gap_index >= handle->item_count)
+            {
+                handle->gap_count = 0;
+            }
+            iterator->current_node = NULL;
+            result = NULL;
+        }
+        else
+        {
+            if (handle->gap_count > 0 && handle->gap_index == iterator->index)
+            {
+                // Move the next item in front of the hole
+                handle->item_array[iterator->index] = handle->item_array[iterator->index + handle->gap_count];
+                handle->gap_index++;
+            }
+            ITEM_NODE* current = get_array_node(handle, iterator->index++);
+            iterator->current_node = current;
+            result = current->node_item;
+        }
+    }
+    else
+    {
+        ITEM_NODE* current = (ITEM_NODE*)iterator->next_node;
+        // The previous node only moves forward when the current
+        // node is still in the list
+        if (iterator->current_node != NULL)
+        {
+            iterator->prev_node = iterator->current_node;
+        }
+        iterator->current_node = current;
+        if (current == NULL)
+        {
+            result = NULL;
+        }
+        else
+        {
+            iterator->next_node = current->next;
+            iterator->index++;
+            result = current->node_item;
         }
     }
     return result;
 }
 
+int item_list_iterator_remove_current(ITEM_LIST_HANDLE handle, ITEM_LIST_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else if (iterator->current_node == NULL)
+    {
+        log_error("Failure iterator is not on an item");
+        result = __LINE__;
+    }
+    else if (handle->options & ITEM_LIST_OPTION_ARRAY)
+    {
+        size_t remove_index = --iterator->index;
+        // Grow the hole behind the walk instead of shifting the tail, a
+        // hole left elsewhere by an earlier walk is closed first
+        if (handle->gap_count > 0 && handle->gap_index != remove_index + 1)
+        {
+            close_array_gap(handle);
+        }
+        destroy_node_item(handle, &handle->item_array[remove_index]);
+        handle->gap_index = remove_index;
+        handle->gap_count++;
+        handle->item_count--;
+        iterator->current_node = NULL;
+        result = 0;
+    }
+    else
+    {
+        // The iterator already holds the previous node so no walk is needed
+        unlink_list_node(handle, (ITEM_NODE*)iterator->prev_node, (ITEM_NODE*)iterator->current_node);
+        iterator->index--;
+        iterator->current_node = NULL;
+        result = 0;
+    }
+    return result;
+}
+
 int item_list_clear(ITEM_LIST_HANDLE handle)
 {
     int result;
@@ -4,21 +4,75 @@
 #include <stdlib.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 
 #include "lib-util-c/item_map.h"
 #include "lib-util-c/app_logging.h"
 #include "lib-util-c/sys_debug_shim.h"
 #include "lib-util-c/crt_extensions.h"
+#include "lib-util-c/node_pool.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define USE_SSE2_GROUPS
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define USE_NEON_GROUPS
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+#define PREFETCH_ADDRESS(address)   __builtin_prefetch(address)
+#elif defined(USE_SSE2_GROUPS)
+#define PREFETCH_ADDRESS(address)   _mm_prefetch((const char*)(address), _MM_HINT_T0)
+#else
+#define PREFETCH_ADDRESS(address)   ((void)(address))
+#endif
 
 typedef struct KEY_VALUE_MAPPING_TAG
 {
     char* key;
     void* value;
     size_t len;
+    // Cached so a lookup can reject an entry without touching the key
+    size_t key_len;
+    uint32_t hash;
     bool locally_alloc;
+    uint8_t storage_flags;
     struct KEY_VALUE_MAPPING_TAG* next;
 } KEY_VALUE_MAPPING;
 
+#define STORAGE_SLAB_NODE       0x01
+#define STORAGE_INLINE_KEY      0x02
+#define STORAGE_INLINE_VALUE    0x04
+// Key points at caller memory added through item_map_add_borrowed_item
+#define STORAGE_BORROWED_KEY    0x08
+
+// Node handed out from a slab when ITEM_MAP_OPTION_INLINE_STORAGE
+// is set, short keys and small values are copied into storage
+#define INLINE_STORAGE_SIZE     48
+#define INLINE_ALIGNMENT        8
+
+typedef struct INLINE_MAPPING_TAG
+{
+    KEY_VALUE_MAPPING mapping;
+    unsigned char storage[INLINE_STORAGE_SIZE];
+} INLINE_MAPPING;
+
+// Open addressing table, the control byte for each slot
+// is either empty, deleted or the low 7 bits of the hash
+typedef struct FLAT_TABLE_TAG
+{
+    KEY_VALUE_MAPPING** slots;
+    uint8_t* ctrl_bytes;
+    size_t capacity;
+    // Number of slots that are not empty (items + deleted)
+    size_t used_slots;
+} FLAT_TABLE;
+
 typedef struct ITEM_MAP_INFO_TAG
 {
     KEY_VALUE_MAPPING** value_array;
@@ -27,11 +81,36 @@ typedef struct ITEM_MAP_INFO_TAG
     void* user_ctx;
     ITEM_MAP_HASH_FUNCTION hash_function;
     size_t item_len;
+    uint32_t options;
+    FLAT_TABLE flat_table;
+    // Previous table that is drained into flat_table a few
+    // slots at a time while an incremental rehash is running
+    FLAT_TABLE rehash_table;
+    size_t rehash_pos;
+    // Slabs and recycled nodes for inline storage
+    NODE_POOL node_pool;
 } ITEM_MAP_INFO;
 
 #define MIN_SLOT_SIZE       10
 #define START_HASH_VALUE    5381
 
+// Control bytes are probed a group at a time
+#define GROUP_WIDTH         16
+#define FLAT_MIN_CAPACITY   GROUP_WIDTH
+#define FLAT_MAX_LOAD_NUM   7
+#define FLAT_MAX_LOAD_DEN   8
+// Keys resolved together by the batch calls, enough to keep the memory
+// system busy without the prefetched lines getting evicted again
+#define BATCH_CHUNK_SIZE    16
+#define FLAT_REHASH_STEP    32
+
+#define CTRL_EMPTY          0x80
+#define CTRL_DELETED        0xFE
+#define CTRL_IS_FULL(ctrl)  (((ctrl) & 0x80) == 0)
+
+#define HASH_POSITION(hash) ((size_t)((hash) >> 7))
+#define HASH_FRAGMENT(hash) ((uint8_t)((hash) & 0x7F))
+
 // Using djb2 Algorithm reported by dan bernstein many years ago in comp.lang.c
 static uint32_t default_hash_function(const char* key)
 {
@@ -45,10 +124,124 @@ static uint32_t default_hash_function(const char* key)
     return result;
 }
 
-static KEY_VALUE_MAPPING* store_key_value_item(const char* key, const void* value, size_t len)
+// A NULL value comes from item_map_get_or_insert which hands
+// back a zeroed slot for the caller to fill in
+static void copy_item_value(void* target, const void* value, size_t len)
+{
+    if (value == NULL)
+    {
+        memset(target, 0, len);
+    }
+    else
+    {
+        memcpy(target, value, len);
+    }
+}
+
+static KEY_VALUE_MAPPING* store_inline_key_value_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, const void* value, size_t len)
+{
+    KEY_VALUE_MAPPING* result;
+    if ((result = (KEY_VALUE_MAPPING*)node_pool_allocate(&map_info->node_pool)) == NULL)
+    {
+        log_error("Failure allocating key value mapping");
+    }
+    else
+    {
+        unsigned char* storage = ((INLINE_MAPPING*)result)->storage;
+        size_t storage_used = 0;
+
+        memset(result, 0, sizeof(KEY_VALUE_MAPPING));
+        result->storage_flags = STORAGE_SLAB_NODE;
+        if (key_len + 1 <= INLINE_STORAGE_SIZE)
+        {
+            memcpy(storage, key, key_len + 1);
+            result->key = (char*)storage;
+            result->storage_flags |= STORAGE_INLINE_KEY;
+            // Keep the value aligned for callers that cast it
+            storage_used = (key_len + INLINE_ALIGNMENT) & ~(size_t)(INLINE_ALIGNMENT - 1);
+        }
+        else if (clone_string(&result->key, key) != 0)
+        {
+            log_error("Failure cloning key info");
+            node_pool_release(&map_info->node_pool, result);
+            result = NULL;
+        }
+
+        if (result != NULL)
+        {
+            if (storage_used + len <= INLINE_STORAGE_SIZE)
+            {
+                result->value = storage + storage_used;
+                result->storage_flags |= STORAGE_INLINE_VALUE;
+            }
+            else if ((result->value = malloc(len)) == NULL)
+            {
+                log_error("Failure allocating value");
+                if ((result->storage_flags & STORAGE_INLINE_KEY) == 0)
+                {
+                    free(result->key);
+                }
+                node_pool_release(&map_info->node_pool, result);
+                result = NULL;
+            }
+
+            if (result != NULL)
+            {
+                copy_item_value(result->value, value, len);
+                result->locally_alloc = true;
+                result->len = len;
+            }
+        }
+    }
+    return result;
+}
+
+// Borrowed items only record the caller's pointers, ownership comes
+// back to the caller through destroy_cb when the item is removed
+static KEY_VALUE_MAPPING* store_borrowed_key_value_item(ITEM_MAP_INFO* map_info, const char* key, const void* value, size_t len)
+{
+    KEY_VALUE_MAPPING* result;
+    if (map_info->options & ITEM_MAP_OPTION_INLINE_STORAGE)
+    {
+        result = (KEY_VALUE_MAPPING*)node_pool_allocate(&map_info->node_pool);
+    }
+    else
+    {
+        result = (KEY_VALUE_MAPPING*)malloc(sizeof(KEY_VALUE_MAPPING));
+    }
+
+    if (result == NULL)
+    {
+        log_error("Failure allocating key value mapping");
+    }
+    else
+    {
+        memset(result, 0, sizeof(KEY_VALUE_MAPPING));
+        result->key = (char*)key;
+        result->value = (void*)value;
+        result->len = len;
+        result->locally_alloc = false;
+        result->storage_flags = STORAGE_BORROWED_KEY;
+        if (map_info->options & ITEM_MAP_OPTION_INLINE_STORAGE)
+        {
+            result->storage_flags |= STORAGE_SLAB_NODE;
+        }
+    }
+    return result;
+}
+
+static KEY_VALUE_MAPPING* store_key_value_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash, const void* value, size_t len, bool borrow_item)
 {
     KEY_VALUE_MAPPING* result;
-    if ((result = (KEY_VALUE_MAPPING*)malloc(sizeof(KEY_VALUE_MAPPING))) == NULL)
+    if (borrow_item)
+    {
+        result = store_borrowed_key_value_item(map_info, key, value, len);
+    }
+    else if (map_info->options & ITEM_MAP_OPTION_INLINE_STORAGE)
+    {
+        result = store_inline_key_value_item(map_info, key, key_len, value, len);
+    }
+    else if ((result = (KEY_VALUE_MAPPING*)malloc(sizeof(KEY_VALUE_MAPPING))) == NULL)
     {
         log_error("Failure allocating key value mapping");
     }
@@ -70,52 +263,600 @@ static KEY_VALUE_MAPPING* store_key_value_item(const char* key, const void* valu
         }
         else
         {
-            memcpy(result->value, value, len);
+            copy_item_value(result->value, value, len);
             result->locally_alloc = true;
             result->len = len;
         }
     }
+
+    if (result != NULL)
+    {
+        result->key_len = key_len;
+        result->hash = hash;
+    }
+    return result;
+}
+
+static bool is_matching_item(const KEY_VALUE_MAPPING* kv_item, const char* key, size_t key_len, uint32_t hash)
+{
+    return kv_item->hash == hash && kv_item->key_len == key_len && memcmp(kv_item->key, key, key_len) == 0;
+}
+
+static void free_map_value(ITEM_MAP_INFO* map_item, KEY_VALUE_MAPPING* key_value_item)
+{
+    if (!key_value_item->locally_alloc)
+    {
+        // The caller owns the value, never free it here
+        if (map_item->destroy_cb != NULL)
+        {
+            map_item->destroy_cb(map_item->user_ctx, key_value_item->key, key_value_item->value);
+        }
+    }
+    else if ((key_value_item->storage_flags & STORAGE_INLINE_VALUE) == 0)
+    {
+        free(key_value_item->value);
+    }
+}
+
+static void destroy_key_value_item(ITEM_MAP_INFO* map_item, KEY_VALUE_MAPPING* key_value_item)
+{
+    free_map_value(map_item, key_value_item);
+    if ((key_value_item->storage_flags & (STORAGE_INLINE_KEY | STORAGE_BORROWED_KEY)) == 0)
+    {
+        free(key_value_item->key);
+    }
+    if (key_value_item->storage_flags & STORAGE_SLAB_NODE)
+    {
+        node_pool_release(&map_item->node_pool, key_value_item);
+    }
+    else
+    {
+        free(key_value_item);
+    }
+}
+
+// Finalizer from murmur3 so weak hash functions still spread
+// across both the slot position and the control byte fragment
+static uint32_t mix_hash(uint32_t hash)
+{
+    hash ^= hash >> 16;
+    hash *= 0x85ebca6b;
+    hash ^= hash >> 13;
+    hash *= 0xc2b2ae35;
+    hash ^= hash >> 16;
+    return hash;
+}
+
+// Power of two tables mask the mixed hash instead of paying for a
+// division, the mix keeps weak hashes from clustering in the low bits
+static size_t chained_slot_index(const ITEM_MAP_INFO* map_info, uint32_t hash)
+{
+    size_t result;
+    if (map_info->options & ITEM_MAP_OPTION_POWER_OF_TWO)
+    {
+        result = mix_hash(hash) & (map_info->max_slots - 1);
+    }
+    else
+    {
+        result = hash % map_info->max_slots;
+    }
+    return result;
+}
+
+// Each group function returns a bitmask with bit N set
+// when control byte N of the group matches
+#if defined(USE_SSE2_GROUPS)
+static uint32_t group_match(const uint8_t* group_ctrl, uint8_t fragment)
+{
+    __m128i group = _mm_loadu_si128((const __m128i*)group_ctrl);
+    return (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8((char)fragment), group));
+}
+
+static uint32_t group_match_empty(const uint8_t* group_ctrl)
+{
+    return group_match(group_ctrl, CTRL_EMPTY);
+}
+
+// Empty and deleted are the only control bytes with the high bit set
+static uint32_t group_match_available(const uint8_t* group_ctrl)
+{
+    return (uint32_t)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group_ctrl));
+}
+#elif defined(USE_NEON_GROUPS)
+static uint32_t neon_movemask(uint8x16_t input)
+{
+    static const uint8_t BIT_WEIGHTS[GROUP_WIDTH] = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+    uint8x16_t masked = vandq_u8(input, vld1q_u8(BIT_WEIGHTS));
+    return (uint32_t)vaddv_u8(vget_low_u8(masked)) | ((uint32_t)vaddv_u8(vget_high_u8(masked)) << 8);
+}
+
+static uint32_t group_match(const uint8_t* group_ctrl, uint8_t fragment)
+{
+    return neon_movemask(vceqq_u8(vld1q_u8(group_ctrl), vdupq_n_u8(fragment)));
+}
+
+static uint32_t group_match_empty(const uint8_t* group_ctrl)
+{
+    return group_match(group_ctrl, CTRL_EMPTY);
+}
+
+static uint32_t group_match_available(const uint8_t* group_ctrl)
+{
+    return neon_movemask(vcltzq_s8(vreinterpretq_s8_u8(vld1q_u8(group_ctrl))));
+}
+#else
+static uint32_t group_match(const uint8_t* group_ctrl, uint8_t fragment)
+{
+    uint32_t result = 0;
+    for (size_t index = 0; index < GROUP_WIDTH; index++)
+    {
+        result |= (uint32_t)(group_ctrl[index] == fragment) << index;
+    }
+    return result;
+}
+
+static uint32_t group_match_empty(const uint8_t* group_ctrl)
+{
+    return group_match(group_ctrl, CTRL_EMPTY);
+}
+
+static uint32_t group_match_available(const uint8_t* group_ctrl)
+{
+    uint32_t result = 0;
+    for (size_t index = 0; index < GROUP_WIDTH; index++)
+    {
+        result |= (uint32_t)(!CTRL_IS_FULL(group_ctrl[index])) << index;
+    }
+    return result;
+}
+#endif
+
+// Index of the lowest set bit, mask must not be zero
+static size_t lowest_bit_index(uint32_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return (size_t)__builtin_ctz(mask);
+#elif defined(_MSC_VER)
+    unsigned long result;
+    (void)_BitScanForward(&result, mask);
+    return (size_t)result;
+#else
+    size_t result = 0;
+    while ((mask & 1) == 0)
+    {
+        mask >>= 1;
+        result++;
+    }
+    return result;
+#endif
+}
+
+static size_t calculate_flat_capacity(size_t size)
+{
+    size_t result = FLAT_MIN_CAPACITY;
+    // Make sure the requested size fits under the max load
+    while (result*FLAT_MAX_LOAD_NUM < size*FLAT_MAX_LOAD_DEN)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+static int flat_table_init(FLAT_TABLE* table, size_t capacity)
+{
+    int result;
+    // The slots and control bytes share a single allocation
+    if ((table->slots = (KEY_VALUE_MAPPING**)malloc((sizeof(KEY_VALUE_MAPPING*) + 1)*capacity)) == NULL)
+    {
+        log_error("Failure allocating flat table");
+        result = __LINE__;
+    }
+    else
+    {
+        table->ctrl_bytes = (uint8_t*)(table->slots + capacity);
+        memset(table->ctrl_bytes, CTRL_EMPTY, capacity);
+        table->capacity = capacity;
+        table->used_slots = 0;
+        result = 0;
+    }
+    return result;
+}
+
+static void flat_table_deinit(FLAT_TABLE* table)
+{
+    free(table->slots);
+    memset(table, 0, sizeof(FLAT_TABLE));
+}
+
+// Groups are visited in triangular order (+1, +2, +3...) which
+// reaches every group since the group count is a power of two
+static void flat_table_insert(FLAT_TABLE* table, KEY_VALUE_MAPPING* kv_item)
+{
+    uint32_t hash = mix_hash(kv_item->hash);
+    size_t group_mask = (table->capacity / GROUP_WIDTH) - 1;
+    size_t group = HASH_POSITION(hash) & group_mask;
+    uint32_t available;
+    for (size_t probe = 1; (available = group_match_available(table->ctrl_bytes + (group*GROUP_WIDTH))) == 0; probe++)
+    {
+        group = (group + probe) & group_mask;
+    }
+
+    size_t index = (group*GROUP_WIDTH) + lowest_bit_index(available);
+    if (table->ctrl_bytes[index] == CTRL_EMPTY)
+    {
+        table->used_slots++;
+    }
+    table->ctrl_bytes[index] = HASH_FRAGMENT(hash);
+    table->slots[index] = kv_item;
+}
+
+// Returns the slot index of the key or the table capacity if not found
+static size_t flat_table_find(const FLAT_TABLE* table, const char* key, size_t key_len, uint32_t key_hash)
+{
+    uint32_t hash = mix_hash(key_hash);
+    size_t result = table->capacity;
+    size_t group_count = table->capacity / GROUP_WIDTH;
+    size_t group = HASH_POSITION(hash) & (group_count - 1);
+    uint8_t fragment = HASH_FRAGMENT(hash);
+    for (size_t probe = 1; probe <= group_count && result == table->capacity; probe++)
+    {
+        const uint8_t* group_ctrl = table->ctrl_bytes + (group*GROUP_WIDTH);
+        uint32_t match = group_match(group_ctrl, fragment);
+        while (match != 0)
+        {
+            size_t index = (group*GROUP_WIDTH) + lowest_bit_index(match);
+            if (is_matching_item(table->slots[index], key, key_len, key_hash))
+            {
+                result = index;
+                break;
+            }
+            match &= match - 1;
+        }
+        // A group with an empty slot ends the probe sequence
+        if (result == table->capacity && group_match_empty(group_ctrl) != 0)
+        {
+            break;
+        }
+        group = (group + probe) & (group_count - 1);
+    }
+    return result;
+}
+
+static void flat_table_erase(FLAT_TABLE* table, size_t index)
+{
+    // Empty slots are only ever added back by a rebuild, so a group that
+    // still has one has never been full and no probe has gone past it
+    if (group_match_empty(table->ctrl_bytes + (index - (index % GROUP_WIDTH))) != 0)
+    {
+        table->ctrl_bytes[index] = CTRL_EMPTY;
+        table->used_slots--;
+    }
+    else
+    {
+        table->ctrl_bytes[index] = CTRL_DELETED;
+    }
+}
+
+// Searches the current table and then the table being drained
+static FLAT_TABLE* flat_locate_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash, size_t* index)
+{
+    FLAT_TABLE* result = NULL;
+    if ((*index = flat_table_find(&map_info->flat_table, key, key_len, hash)) < map_info->flat_table.capacity)
+    {
+        result = &map_info->flat_table;
+    }
+    else if (map_info->rehash_table.capacity > 0 &&
+        (*index = flat_table_find(&map_info->rehash_table, key, key_len, hash)) < map_info->rehash_table.capacity)
+    {
+        result = &map_info->rehash_table;
+    }
+    return result;
+}
+
+// Moves up to slot_count slots from the table being drained into the current table
+static void flat_rehash_step(ITEM_MAP_INFO* map_info, size_t slot_count)
+{
+    FLAT_TABLE* old_table = &map_info->rehash_table;
+    if (old_table->capacity > 0)
+    {
+        size_t end_pos = map_info->rehash_pos + slot_count;
+        if (end_pos > old_table->capacity)
+        {
+            end_pos = old_table->capacity;
+        }
+        for (size_t index = map_info->rehash_pos; index < end_pos; index++)
+        {
+            if (CTRL_IS_FULL(old_table->ctrl_bytes[index]))
+            {
+                flat_table_insert(&map_info->flat_table, old_table->slots[index]);
+                // Mark as deleted so probe chains still running through the slot stay intact
+                old_table->ctrl_bytes[index] = CTRL_DELETED;
+            }
+        }
+        map_info->rehash_pos = end_pos;
+        if (end_pos == old_table->capacity)
+        {
+            flat_table_deinit(old_table);
+            map_info->rehash_pos = 0;
+        }
+    }
+}
+
+// Makes sure another item fits under the max load, starting a rehash when it does not
+static int flat_reserve_slot(ITEM_MAP_INFO* map_info)
+{
+    int result;
+    FLAT_TABLE* table = &map_info->flat_table;
+    if ((table->used_slots + 1)*FLAT_MAX_LOAD_DEN <= table->capacity*FLAT_MAX_LOAD_NUM)
+    {
+        result = 0;
+    }
+    else
+    {
+        FLAT_TABLE new_table;
+        size_t new_capacity = table->capacity;
+
+        // Finish a rehash that is still running before starting the next one
+        flat_rehash_step(map_info, map_info->rehash_table.capacity);
+
+        // Grow when the items fill more than half the max load, otherwise
+        // rebuild at the same size to get rid of the deleted slots
+        if (map_info->item_len*2*FLAT_MAX_LOAD_DEN > table->capacity*FLAT_MAX_LOAD_NUM)
+        {
+            new_capacity <<= 1;
+        }
+
+        if (flat_table_init(&new_table, new_capacity) != 0)
+        {
+            log_error("Failure allocating rehash table");
+            result = __LINE__;
+        }
+        else
+        {
+            map_info->rehash_table = *table;
+            map_info->flat_table = new_table;
+            map_info->rehash_pos = 0;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static KEY_VALUE_MAPPING* flat_add_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash, const void* value, size_t len, bool borrow_item)
+{
+    KEY_VALUE_MAPPING* result;
+
+    flat_rehash_step(map_info, FLAT_REHASH_STEP);
+    if (flat_reserve_slot(map_info) != 0)
+    {
+        log_error("Failure reserving map slot");
+        result = NULL;
+    }
+    else if ((result = store_key_value_item(map_info, key, key_len, hash, value, len, borrow_item)) == NULL)
+    {
+        log_error("Failure cloning key info");
+    }
+    else
+    {
+        flat_table_insert(&map_info->flat_table, result);
+        map_info->item_len++;
+    }
+    return result;
+}
+
+static void flat_remove_item(ITEM_MAP_INFO* map_info, const char* key)
+{
+    size_t index;
+    FLAT_TABLE* table;
+
+    flat_rehash_step(map_info, FLAT_REHASH_STEP);
+    if ((table = flat_locate_item(map_info, key, strlen(key), map_info->hash_function(key), &index)) != NULL)
+    {
+        destroy_key_value_item(map_info, table->slots[index]);
+        flat_table_erase(table, index);
+        map_info->item_len--;
+    }
+}
+
+static void clear_flat_table(ITEM_MAP_INFO* map_info, FLAT_TABLE* table)
+{
+    for (size_t index = 0; index < table->capacity; index++)
+    {
+        if (CTRL_IS_FULL(table->ctrl_bytes[index]))
+        {
+            destroy_key_value_item(map_info, table->slots[index]);
+        }
+        table->ctrl_bytes[index] = CTRL_EMPTY;
+    }
+    table->used_slots = 0;
+}
+
+static void clear_flat_map(ITEM_MAP_INFO* map_info)
+{
+    clear_flat_table(map_info, &map_info->flat_table);
+    if (map_info->rehash_table.capacity > 0)
+    {
+        clear_flat_table(map_info, &map_info->rehash_table);
+        flat_table_deinit(&map_info->rehash_table);
+        map_info->rehash_pos = 0;
+    }
+}
+
+static void clear_map(ITEM_MAP_INFO* map_item)
+{
+    for (size_t index = 0; index < map_item->max_slots; index++)
+    {
+        KEY_VALUE_MAPPING* iterator = map_item->value_array[index];
+        while (iterator != NULL)
+        {
+            KEY_VALUE_MAPPING* delete_item = iterator;
+            iterator = iterator->next;
+            destroy_key_value_item(map_item, delete_item);
+        }
+        // Set the value array at this index to NULL
+        map_item->value_array[index] = NULL;
+    }
+}
+
+static KEY_VALUE_MAPPING* find_key_value_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash)
+{
+    KEY_VALUE_MAPPING* result;
+    if (map_info->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+    {
+        size_t index;
+        FLAT_TABLE* table = flat_locate_item(map_info, key, key_len, hash, &index);
+        result = (table == NULL) ? NULL : table->slots[index];
+    }
+    else
+    {
+        result = map_info->value_array[chained_slot_index(map_info, hash)];
+        while (result != NULL && !is_matching_item(result, key, key_len, hash))
+        {
+            result = result->next;
+        }
+    }
+    return result;
+}
+
+// Overwrites the value of an existing item, reusing its storage when the
+// new value fits.  Borrowed items are handed back through destroy_cb and
+// become copied items
+static int replace_item_value(ITEM_MAP_INFO* map_info, KEY_VALUE_MAPPING* kv_item, const void* value, size_t len)
+{
+    int result;
+    if (kv_item->locally_alloc && len <= kv_item->len)
+    {
+        memcpy(kv_item->value, value, len);
+        kv_item->len = len;
+        result = 0;
+    }
+    else
+    {
+        char* new_key = kv_item->key;
+        void* new_value;
+        if ((new_value = malloc(len)) == NULL)
+        {
+            log_error("Failure allocating value");
+            result = __LINE__;
+        }
+        else if ((kv_item->storage_flags & STORAGE_BORROWED_KEY) && clone_string(&new_key, kv_item->key) != 0)
+        {
+            log_error("Failure cloning key info");
+            free(new_value);
+            result = __LINE__;
+        }
+        else
+        {
+            memcpy(new_value, value, len);
+            free_map_value(map_info, kv_item);
+            kv_item->key = new_key;
+            kv_item->value = new_value;
+            kv_item->len = len;
+            kv_item->locally_alloc = true;
+            kv_item->storage_flags &= ~(STORAGE_INLINE_VALUE | STORAGE_BORROWED_KEY);
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static KEY_VALUE_MAPPING* chained_add_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash, const void* value, size_t len, bool borrow_item)
+{
+    KEY_VALUE_MAPPING* result;
+    size_t index = chained_slot_index(map_info, hash);
+
+    KEY_VALUE_MAPPING* kv_item = map_info->value_array[index];
+    if (kv_item == NULL)
+    {
+        if ((result = store_key_value_item(map_info, key, key_len, hash, value, len, borrow_item)) == NULL)
+        {
+            log_error("Failure cloning key info");
+        }
+        else
+        {
+            map_info->value_array[index] = result;
+            map_info->item_len++;
+        }
+    }
+    else
+    {
+        // Add to the end of the list
+        if ((result = store_key_value_item(map_info, key, key_len, hash, value, len, borrow_item) ) == NULL)
+        {
+            log_error("Failure cloning key info");
+        }
+        else
+        {
+            // Add to the end of the link list
+            KEY_VALUE_MAPPING** iterator = &(kv_item->next);
+            while (*iterator != NULL)
+            {
+                iterator = &(*iterator)->next;
+            }
+            *iterator = result;
+            map_info->item_len++;
+        }
+    }
+    return result;
+}
+
+static KEY_VALUE_MAPPING* add_key_value_item(ITEM_MAP_INFO* map_info, const char* key, size_t key_len, uint32_t hash, const void* value, size_t len, bool borrow_item)
+{
+    KEY_VALUE_MAPPING* result;
+    if (map_info->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+    {
+        result = flat_add_item(map_info, key, key_len, hash, value, len, borrow_item);
+    }
+    else
+    {
+        result = chained_add_item(map_info, key, key_len, hash, value, len, borrow_item);
+    }
     return result;
 }
 
-static void free_map_value(ITEM_MAP_INFO* map_item, KEY_VALUE_MAPPING* key_value_item)
+// First batch stage: pull in the control group and slot pointers (or the
+// chain head) the key hashes to
+static void prefetch_item_bucket(const ITEM_MAP_INFO* map_info, uint32_t hash)
 {
-    if (!key_value_item->locally_alloc && map_item->destroy_cb != NULL)
+    if (map_info->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
     {
-        map_item->destroy_cb(map_item->user_ctx, key_value_item->key, key_value_item->value);
+        const FLAT_TABLE* table = &map_info->flat_table;
+        size_t group = HASH_POSITION(mix_hash(hash)) & ((table->capacity / GROUP_WIDTH) - 1);
+        PREFETCH_ADDRESS(table->ctrl_bytes + (group*GROUP_WIDTH));
+        PREFETCH_ADDRESS(table->slots + (group*GROUP_WIDTH));
     }
     else
     {
-        free(key_value_item->value);
+        PREFETCH_ADDRESS(map_info->value_array + chained_slot_index(map_info, hash));
     }
 }
 
-static void clear_map(ITEM_MAP_INFO* map_item)
+// Second batch stage: the bucket is cached by now so the entry it
+// most likely points at can be requested as well
+static void prefetch_item_entry(const ITEM_MAP_INFO* map_info, uint32_t hash)
 {
-    for (size_t index = 0; index < map_item->max_slots; index++)
+    if (map_info->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+    {
+        const FLAT_TABLE* table = &map_info->flat_table;
+        uint32_t mixed_hash = mix_hash(hash);
+        size_t group = HASH_POSITION(mixed_hash) & ((table->capacity / GROUP_WIDTH) - 1);
+        uint32_t match = group_match(table->ctrl_bytes + (group*GROUP_WIDTH), HASH_FRAGMENT(mixed_hash));
+        if (match != 0)
+        {
+            PREFETCH_ADDRESS(table->slots[(group*GROUP_WIDTH) + lowest_bit_index(match)]);
+        }
+    }
+    else
     {
-        KEY_VALUE_MAPPING* kv_item = map_item->value_array[index];
+        const KEY_VALUE_MAPPING* kv_item = map_info->value_array[chained_slot_index(map_info, hash)];
         if (kv_item != NULL)
         {
-            free_map_value(map_item, kv_item);
-            free(kv_item->key);
-            KEY_VALUE_MAPPING* iterator = kv_item->next;
-            while (iterator != NULL)
-            {
-                KEY_VALUE_MAPPING* delete_item = iterator;
-                iterator = iterator->next;
-                free_map_value(map_item, delete_item);
-                free(delete_item->key);
-                free(delete_item);
-            }
-            free(kv_item);
-            // Set the value array at this index to NULL
-            map_item->value_array[index] = NULL;
+            PREFETCH_ADDRESS(kv_item);
         }
     }
 }
 
-ITEM_MAP_HANDLE item_map_create(size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, void* user_ctx, ITEM_MAP_HASH_FUNCTION hash_function)
+static ITEM_MAP_INFO* create_item_map(size_t size, uint32_t options, ITEM_MAP_DESTROY_ITEM destroy_cb, void* user_ctx, ITEM_MAP_HASH_FUNCTION hash_function)
 {
     ITEM_MAP_INFO* result = (ITEM_MAP_INFO*)malloc(sizeof(ITEM_MAP_INFO));
     if (result == NULL)
@@ -128,10 +869,21 @@ ITEM_MAP_HANDLE item_map_create(size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, v
         result->max_slots = size;
         result->destroy_cb = destroy_cb;
         result->user_ctx = user_ctx;
+        result->options = options;
+        node_pool_init(&result->node_pool, sizeof(INLINE_MAPPING), offsetof(INLINE_MAPPING, mapping.next));
         if (result->max_slots < MIN_SLOT_SIZE)
         {
             result->max_slots = MIN_SLOT_SIZE;
         }
+        if (options & ITEM_MAP_OPTION_POWER_OF_TWO)
+        {
+            size_t slot_count = 1;
+            while (slot_count < result->max_slots)
+            {
+                slot_count <<= 1;
+            }
+            result->max_slots = slot_count;
+        }
         if (hash_function == NULL)
         {
             result->hash_function = default_hash_function;
@@ -141,7 +893,16 @@ ITEM_MAP_HANDLE item_map_create(size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, v
             result->hash_function = hash_function;
         }
 
-        if ((result->value_array = (KEY_VALUE_MAPPING**)malloc(sizeof(KEY_VALUE_MAPPING)*result->max_slots)) == NULL)
+        if (options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+        {
+            if (flat_table_init(&result->flat_table, calculate_flat_capacity(size)) != 0)
+            {
+                log_error("Failure allocating flat table");
+                free(result);
+                result = NULL;
+            }
+        }
+        else if ((result->value_array = (KEY_VALUE_MAPPING**)malloc(sizeof(KEY_VALUE_MAPPING)*result->max_slots)) == NULL)
         {
             log_error("Failure allocating key value mapping");
             free(result);
@@ -155,13 +916,32 @@ ITEM_MAP_HANDLE item_map_create(size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, v
     return result;
 }
 
+ITEM_MAP_HANDLE item_map_create(size_t size, ITEM_MAP_DESTROY_ITEM destroy_cb, void* user_ctx, ITEM_MAP_HASH_FUNCTION hash_function)
+{
+    return create_item_map(size, ITEM_MAP_OPTION_NONE, destroy_cb, user_ctx, hash_function);
+}
+
+ITEM_MAP_HANDLE item_map_create_with_options(size_t size, uint32_t options, ITEM_MAP_DESTROY_ITEM destroy_cb, void* user_ctx, ITEM_MAP_HASH_FUNCTION hash_function)
+{
+    return create_item_map(size, options, destroy_cb, user_ctx, hash_function);
+}
+
 void item_map_destroy(ITEM_MAP_HANDLE handle)
 {
     if (handle != NULL)
     {
         // Free all items in the array
-        clear_map(handle);
-        free(handle->value_array);
+        if (handle->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+        {
+            clear_flat_map(handle);
+            flat_table_deinit(&handle->flat_table);
+        }
+        else
+        {
+            clear_map(handle);
+            free(handle->value_array);
+        }
+        node_pool_deinit(&handle->node_pool);
         free(handle);
     }
 }
@@ -176,87 +956,268 @@ int item_map_add_item(ITEM_MAP_HANDLE handle, const char* key, const void* value
     }
     else
     {
-        uint32_t hash_index = handle->hash_function(key);
-        uint32_t index = hash_index % handle->max_slots;
+        if (add_key_value_item(handle, key, strlen(key), handle->hash_function(key), value, len, false) == NULL)
+        {
+            log_error("Failure adding item to map");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
 
-        KEY_VALUE_MAPPING* kv_item = handle->value_array[index];
+int item_map_add_borrowed_item(ITEM_MAP_HANDLE handle, const char* key, void* value, size_t len)
+{
+    int result;
+    if (handle == NULL || key == NULL || value == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p, value: %p", handle, key, value);
+        result = __LINE__;
+    }
+    else
+    {
+        if (add_key_value_item(handle, key, strlen(key), handle->hash_function(key), value, len, true) == NULL)
+        {
+            log_error("Failure adding borrowed item to map");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+const void* item_map_get_item(ITEM_MAP_HANDLE handle, const char* key)
+{
+    const void* result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
+        result = NULL;
+    }
+    else
+    {
+        KEY_VALUE_MAPPING* kv_item = find_key_value_item(handle, key, strlen(key), handle->hash_function(key));
+        result = (kv_item == NULL) ? NULL : kv_item->value;
+    }
+    return result;
+}
+
+const void* item_map_get_item_prehashed(ITEM_MAP_HANDLE handle, const char* key, size_t key_len, uint32_t hash, size_t* len)
+{
+    const void* result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
+        result = NULL;
+    }
+    else
+    {
+        KEY_VALUE_MAPPING* kv_item = find_key_value_item(handle, key, key_len, hash);
         if (kv_item == NULL)
         {
-            if ((kv_item = store_key_value_item(key, value, len)) == NULL)
+            result = NULL;
+        }
+        else
+        {
+            result = kv_item->value;
+            if (len != NULL)
             {
-                log_error("Failure cloning key info");
-                result = __LINE__;
+                *len = kv_item->len;
+            }
+        }
+    }
+    return result;
+}
+
+int item_map_upsert(ITEM_MAP_HANDLE handle, const char* key, const void* value, size_t len)
+{
+    int result;
+    if (handle == NULL || key == NULL || value == NULL || len == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p, value: %p", handle, key, value);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t key_len = strlen(key);
+        uint32_t hash = handle->hash_function(key);
+        KEY_VALUE_MAPPING* kv_item = find_key_value_item(handle, key, key_len, hash);
+        if (kv_item != NULL)
+        {
+            result = replace_item_value(handle, kv_item, value, len);
+        }
+        else if (add_key_value_item(handle, key, key_len, hash, value, len, false) == NULL)
+        {
+            log_error("Failure adding item to map");
+            result = __LINE__;
+        }
+        else
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+void* item_map_get_or_insert(ITEM_MAP_HANDLE handle, const char* key, size_t len, bool* inserted)
+{
+    void* result;
+    if (handle == NULL || key == NULL || len == 0)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p, len: %zu", handle, key, len);
+        result = NULL;
+    }
+    else
+    {
+        size_t key_len = strlen(key);
+        uint32_t hash = handle->hash_function(key);
+        bool is_new = false;
+        KEY_VALUE_MAPPING* kv_item = find_key_value_item(handle, key, key_len, hash);
+        if (kv_item == NULL)
+        {
+            if ((kv_item = add_key_value_item(handle, key, key_len, hash, NULL, len, false)) == NULL)
+            {
+                log_error("Failure adding item to map");
             }
             else
             {
-                handle->value_array[index] = kv_item;
-                handle->item_len++;
-                result = 0;
+                is_new = true;
             }
         }
-        else
+        else if (kv_item->len < len)
+        {
+            log_error("Existing item is smaller than requested length %zu", len);
+            kv_item = NULL;
+        }
+
+        result = (kv_item == NULL) ? NULL : kv_item->value;
+        if (inserted != NULL)
+        {
+            *inserted = is_new;
+        }
+    }
+    return result;
+}
+
+int item_map_add_batch(ITEM_MAP_HANDLE handle, const char** keys, const void** values, const size_t* lens, size_t count)
+{
+    int result;
+    if (handle == NULL || keys == NULL || values == NULL || lens == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, keys: %p, values: %p, lens: %p", handle, keys, values, lens);
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+        for (size_t index = 0; index < count; index++)
         {
-            // Add to the end of the list
-            KEY_VALUE_MAPPING* new_item;
-            if ((new_item = store_key_value_item(key, value, len) ) == NULL)
+            if (keys[index] == NULL || values[index] == NULL || lens[index] == 0)
             {
-                log_error("Failure cloning key info");
+                log_error("Invalid item specified at batch index %zu", index);
                 result = __LINE__;
+                break;
             }
-            else
+        }
+
+        for (size_t chunk = 0; chunk < count && result == 0; chunk += BATCH_CHUNK_SIZE)
+        {
+            size_t key_lens[BATCH_CHUNK_SIZE];
+            uint32_t hashes[BATCH_CHUNK_SIZE];
+            size_t chunk_len = (count - chunk < BATCH_CHUNK_SIZE) ? count - chunk : BATCH_CHUNK_SIZE;
+
+            for (size_t index = 0; index < chunk_len; index++)
+            {
+                key_lens[index] = strlen(keys[chunk + index]);
+                hashes[index] = handle->hash_function(keys[chunk + index]);
+                prefetch_item_bucket(handle, hashes[index]);
+            }
+            for (size_t index = 0; index < chunk_len; index++)
             {
-                // Add to the end of the link list
-                KEY_VALUE_MAPPING** iterator = &(kv_item->next);
-                while (*iterator != NULL)
+                if (add_key_value_item(handle, keys[chunk + index], key_lens[index], hashes[index], values[chunk + index], lens[chunk + index], false) == NULL)
                 {
-                    iterator = &(*iterator)->next;
+                    log_error("Failure adding batch item %zu", chunk + index);
+                    result = __LINE__;
+                    break;
                 }
-                *iterator = new_item;
-                handle->item_len++;
-                result = 0;
             }
         }
     }
     return result;
 }
 
-const void* item_map_get_item(ITEM_MAP_HANDLE handle, const char* key)
+size_t item_map_get_batch(ITEM_MAP_HANDLE handle, const char** keys, size_t count, const void** values)
 {
-    const void* result;
-    if (handle == NULL || key == NULL)
+    size_t result = 0;
+    if (handle == NULL || keys == NULL || values == NULL)
     {
-        log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
-        result = NULL;
+        log_error("Invalid parameter specified handle: %p, keys: %p, values: %p", handle, keys, values);
     }
     else
     {
-        uint32_t hash_index = handle->hash_function(key);
-        uint32_t index = hash_index % handle->max_slots;
-
-        KEY_VALUE_MAPPING* kv_item = handle->value_array[index];
-        KEY_VALUE_MAPPING* iterator = kv_item;
-        if (iterator != NULL)
+        for (size_t chunk = 0; chunk < count; chunk += BATCH_CHUNK_SIZE)
         {
-            result = kv_item->value;
-            while (strcmp(iterator->key, key) != 0)
+            size_t key_lens[BATCH_CHUNK_SIZE];
+            uint32_t hashes[BATCH_CHUNK_SIZE];
+            size_t chunk_len = (count - chunk < BATCH_CHUNK_SIZE) ? count - chunk : BATCH_CHUNK_SIZE;
+
+            // Hash everything and issue the loads before any of them are
+            // needed so the cache misses overlap instead of running in series
+            for (size_t index = 0; index < chunk_len; index++)
             {
-                result = NULL;
-                if (iterator->next == NULL)
+                if (keys[chunk + index] != NULL)
                 {
-                    // Didn't find an item
-                    break;
+                    key_lens[index] = strlen(keys[chunk + index]);
+                    hashes[index] = handle->hash_function(keys[chunk + index]);
+                    prefetch_item_bucket(handle, hashes[index]);
+                }
+            }
+            for (size_t index = 0; index < chunk_len; index++)
+            {
+                if (keys[chunk + index] != NULL)
+                {
+                    prefetch_item_entry(handle, hashes[index]);
+                }
+            }
+            for (size_t index = 0; index < chunk_len; index++)
+            {
+                KEY_VALUE_MAPPING* kv_item = NULL;
+                if (keys[chunk + index] != NULL)
+                {
+                    kv_item = find_key_value_item(handle, keys[chunk + index], key_lens[index], hashes[index]);
+                }
+                if (kv_item == NULL)
+                {
+                    values[chunk + index] = NULL;
                 }
                 else
                 {
-                    iterator = iterator->next;
-                    result = iterator->value;
+                    values[chunk + index] = kv_item->value;
+                    result++;
                 }
             }
         }
-        else
-        {
-            result = NULL;
-        }
+    }
+    return result;
+}
+
+uint32_t item_map_hash_key(ITEM_MAP_HANDLE handle, const char* key)
+{
+    uint32_t result;
+    if (handle == NULL || key == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
+        result = 0;
+    }
+    else
+    {
+        result = handle->hash_function(key);
     }
     return result;
 }
@@ -269,28 +1230,25 @@ int item_map_remove_item(ITEM_MAP_HANDLE handle, const char* key)
         log_error("Invalid parameter specified handle: %p, key: %p", handle, key);
         result = __LINE__;
     }
+    else if (handle->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+    {
+        flat_remove_item(handle, key);
+        result = 0;
+    }
     else
     {
         uint32_t hash_index = handle->hash_function(key);
-        uint32_t index = hash_index % handle->max_slots;
+        size_t index = chained_slot_index(handle, hash_index);
+        size_t key_len = strlen(key);
 
         KEY_VALUE_MAPPING* kv_item = handle->value_array[index];
         if (kv_item != NULL)
         {
-            if (strcmp(kv_item->key, key) == 0)
+            if (is_matching_item(kv_item, key, key_len, hash_index))
             {
                 result = 0;
-                free_map_value(handle, kv_item);
-                free(kv_item->key);
-                if (kv_item->next != NULL)
-                {
-                    handle->value_array[index] = kv_item->next;
-                }
-                else
-                {
-                    handle->value_array[index] = NULL;
-                }
-                free(kv_item);
+                handle->value_array[index] = kv_item->next;
+                destroy_key_value_item(handle, kv_item);
                 handle->item_len--;
             }
             else
@@ -299,23 +1257,16 @@ int item_map_remove_item(ITEM_MAP_HANDLE handle, const char* key)
                 KEY_VALUE_MAPPING* iterator = kv_item;
                 while (iterator->next != NULL)
                 {
-                    if (strcmp(iterator->next->key, key) == 0)
+                    if (is_matching_item(iterator->next, key, key_len, hash_index))
                     {
                         KEY_VALUE_MAPPING* delete_item = iterator->next;
                         // The item is in the array
-                        free_map_value(handle, delete_item);
-                        free(delete_item->key);
-                        if (delete_item->next != NULL)
-                        {
-                            iterator->next = delete_item->next;
-                        }
-                        else
-                        {
-                            iterator->next = NULL;
-                        }
-                        free(delete_item);
+                        iterator->next = delete_item->next;
+                        destroy_key_value_item(handle, delete_item);
                         handle->item_len--;
+                        break;
                     }
+                    iterator = iterator->next;
                 }
             }
         }
@@ -328,6 +1279,80 @@ int item_map_remove_item(ITEM_MAP_HANDLE handle, const char* key)
     return result;
 }
 
+int item_map_iterator(ITEM_MAP_HANDLE handle, ITEM_MAP_ITERATOR* iterator)
+{
+    int result;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, iterator: %p", handle, iterator);
+        result = __LINE__;
+    }
+    else
+    {
+        iterator->index = 0;
+        iterator->node = NULL;
+        result = 0;
+    }
+    return result;
+}
+
+const void* item_map_get_next(ITEM_MAP_HANDLE handle, ITEM_MAP_ITERATOR* iterator, const char** key, size_t* len)
+{
+    KEY_VALUE_MAPPING* kv_item = NULL;
+    if (handle == NULL || iterator == NULL)
+    {
+        log_error("Invalid parameter specified handle: %p, iterator: %p", handle, iterator);
+    }
+    else if (handle->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+    {
+        // Walk the control bytes of the current table and then the one
+        // being drained by a rehash, both in memory order
+        const FLAT_TABLE* tables[] = { &handle->flat_table, &handle->rehash_table };
+        size_t table_start = 0;
+        for (size_t table_index = 0; table_index < sizeof(tables)/sizeof(tables[0]) && kv_item == NULL; table_index++)
+        {
+            const FLAT_TABLE* table = tables[table_index];
+            while (iterator->index < table_start + table->capacity)
+            {
+                size_t slot = iterator->index++ - table_start;
+                if (CTRL_IS_FULL(table->ctrl_bytes[slot]))
+                {
+                    kv_item = table->slots[slot];
+                    break;
+                }
+            }
+            table_start += table->capacity;
+        }
+    }
+    else
+    {
+        kv_item = (KEY_VALUE_MAPPING*)iterator->node;
+        while (kv_item == NULL && iterator->index < handle->max_slots)
+        {
+            kv_item = handle->value_array[iterator->index++];
+        }
+        if (kv_item != NULL)
+        {
+            iterator->node = kv_item->next;
+        }
+    }
+
+    const void* result = NULL;
+    if (kv_item != NULL)
+    {
+        if (key != NULL)
+        {
+            *key = kv_item->key;
+        }
+        if (len != NULL)
+        {
+            *len = kv_item->len;
+        }
+        result = kv_item->value;
+    }
+    return result;
+}
+
 int item_map_clear_all(ITEM_MAP_HANDLE handle)
 {
     int result;
@@ -338,7 +1363,14 @@ int item_map_clear_all(ITEM_MAP_HANDLE handle)
     }
     else
     {
-        clear_map(handle);
+        if (handle->options & ITEM_MAP_OPTION_OPEN_ADDRESSING)
+        {
+            clear_flat_map(handle);
+        }
+        else
+        {
+            clear_map(handle);
+        }
         handle->item_len = 0;
         result = 0;
     }
@@ -0,0 +1,126 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/node_pool.h"
+
+#define SLAB_MIN_NODES          16
+#define SLAB_MAX_NODES          1024
+
+typedef struct NODE_SLAB_TAG
+{
+    struct NODE_SLAB_TAG* next;
+    size_t node_count;
+    // uint64_t keeps the nodes aligned for the keys and pointers they hold
+    uint64_t nodes[];
+} NODE_SLAB;
+
+static void** get_node_link(const NODE_POOL* pool, void* node)
+{
+    return (void**)((unsigned char*)node + pool->link_offset);
+}
+
+void node_pool_init(NODE_POOL* pool, size_t node_size, size_t link_offset)
+{
+    if (pool != NULL)
+    {
+        pool->slab_list = NULL;
+        pool->free_nodes = NULL;
+        pool->node_size = node_size;
+        pool->link_offset = link_offset;
+    }
+}
+
+void node_pool_deinit(NODE_POOL* pool)
+{
+    if (pool != NULL)
+    {
+        while (pool->slab_list != NULL)
+        {
+            NODE_SLAB* slab = pool->slab_list;
+            pool->slab_list = slab->next;
+            free(slab);
+        }
+        pool->free_nodes = NULL;
+    }
+}
+
+int node_pool_reserve(NODE_POOL* pool, size_t node_count)
+{
+    int result;
+    NODE_SLAB* slab;
+    if (pool == NULL || pool->node_size == 0)
+    {
+        log_error("Invalid parameter pool: %p", pool);
+        result = __LINE__;
+    }
+    else if (node_count > (SIZE_MAX - sizeof(NODE_SLAB)) / pool->node_size)
+    {
+        log_error("Failure node slab size %zu too large", node_count);
+        result = __LINE__;
+    }
+    else if ((slab = (NODE_SLAB*)malloc(sizeof(NODE_SLAB) + (pool->node_size*node_count))) == NULL)
+    {
+        log_error("Failure allocating node slab");
+        result = __LINE__;
+    }
+    else
+    {
+        unsigned char* nodes = (unsigned char*)slab->nodes;
+        slab->node_count = node_count;
+        slab->next = pool->slab_list;
+        pool->slab_list = slab;
+        // Handed out in address order so nodes allocated together sit together
+        for (size_t index = node_count; index > 0; index--)
+        {
+            void* node = nodes + ((index - 1)*pool->node_size);
+            *get_node_link(pool, node) = pool->free_nodes;
+            pool->free_nodes = node;
+        }
+        result = 0;
+    }
+    return result;
+}
+
+void* node_pool_allocate(NODE_POOL* pool)
+{
+    void* result;
+    if (pool == NULL)
+    {
+        log_error("Invalid parameter pool NULL");
+        result = NULL;
+    }
+    else
+    {
+        if (pool->free_nodes == NULL)
+        {
+            // Each slab doubles the previous one up to the max
+            size_t node_count = pool->slab_list == NULL ? SLAB_MIN_NODES : pool->slab_list->node_count*2;
+            if (node_count > SLAB_MAX_NODES)
+            {
+                node_count = SLAB_MAX_NODES;
+            }
+            (void)node_pool_reserve(pool, node_count);
+        }
+
+        if ((result = pool->free_nodes) != NULL)
+        {
+            pool->free_nodes = *get_node_link(pool, result);
+        }
+    }
+    return result;
+}
+
+void node_pool_release(NODE_POOL* pool, void* node)
+{
+    if (pool != NULL && node != NULL)
+    {
+        *get_node_link(pool, node) = pool->free_nodes;
+        pool->free_nodes = node;
+    }
+}
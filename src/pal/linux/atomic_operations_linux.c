@@ -16,8 +16,7 @@ long atomic_increment(long* value)
     }
     else
     {
-        atomic_fetch_add_explicit(value, 1, memory_order_relaxed);
-        result = *value;
+        result = atomic_fetch_add_explicit(value, 1, memory_order_relaxed) + 1;
     }
     return result;
 }
@@ -31,8 +30,7 @@ int64_t atomic_increment64(int64_t* value)
     }
     else
     {
-        atomic_fetch_add_explicit(value, 1, memory_order_relaxed);
-        result = *value;
+        result = atomic_fetch_add_explicit(value, 1, memory_order_relaxed) + 1;
     }
     return result;
 }
@@ -46,8 +44,7 @@ long atomic_decrement(long* value)
     }
     else
     {
-        atomic_fetch_sub_explicit(value, 1, memory_order_relaxed);
-        result = *value;
+        result = atomic_fetch_sub_explicit(value, 1, memory_order_relaxed) - 1;
     }
     return result;
 }
@@ -61,8 +58,7 @@ long atomic_decrement64(int64_t* value)
     }
     else
     {
-        atomic_fetch_sub_explicit(value, 1, memory_order_relaxed);
-        result = *value;
+        result = atomic_fetch_sub_explicit(value, 1, memory_order_relaxed) - 1;
     }
     return result;
 }
@@ -75,8 +71,7 @@ long atomic_add(long* operand, long value)
     }
     else
     {
-        atomic_fetch_add_explicit(operand, value, memory_order_relaxed);
-        return *operand;
+        return atomic_fetch_add_explicit(operand, value, memory_order_relaxed) + value;
     }
 }
 
@@ -88,8 +83,78 @@ long atomic_subtract(long* operand, long value)
     }
     else
     {
-        atomic_fetch_sub_explicit(operand, value, memory_order_relaxed);
-        return *operand;
+        return atomic_fetch_sub_explicit(operand, value, memory_order_relaxed) - value;
     }
 }
 
+int64_t atomic_load64(int64_t* value)
+{
+    int64_t result;
+    if (value == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        result = atomic_load_explicit(value, memory_order_seq_cst);
+    }
+    return result;
+}
+
+void atomic_store64(int64_t* value, int64_t new_value)
+{
+    if (value != NULL)
+    {
+        atomic_store_explicit(value, new_value, memory_order_seq_cst);
+    }
+}
+
+bool atomic_compare_exchange64(int64_t* value, int64_t expected, int64_t desired)
+{
+    bool result;
+    if (value == NULL)
+    {
+        result = false;
+    }
+    else
+    {
+        result = atomic_compare_exchange_strong_explicit(value, &expected, desired, memory_order_seq_cst, memory_order_seq_cst);
+    }
+    return result;
+}
+
+void* atomic_load_ptr(void** value)
+{
+    void* result;
+    if (value == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = atomic_load_explicit(value, memory_order_seq_cst);
+    }
+    return result;
+}
+
+void atomic_store_ptr(void** value, void* new_value)
+{
+    if (value != NULL)
+    {
+        atomic_store_explicit(value, new_value, memory_order_seq_cst);
+    }
+}
+
+void* atomic_exchange_ptr(void** value, void* new_value)
+{
+    void* result;
+    if (value == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = atomic_exchange_explicit(value, new_value, memory_order_seq_cst);
+    }
+    return result;
+}
@@ -6,22 +6,33 @@
 #include "lib-util-c/app_logging.h"
 #include "lib-util-c/condition_mgr.h"
 #include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/sys_debug_shim.h"
 
 int condition_mgr_init(SIGNAL_HANDLE* handle)
 {
     int result;
+    pthread_cond_t* condition;
     if (handle == NULL)
     {
         log_error("Invalid Parameter specified");
         result = __LINE__;
     }
-    else if (pthread_cond_init(handle, NULL) != 0)
+    else if ((condition = (pthread_cond_t*)malloc(sizeof(pthread_cond_t))) == NULL)
     {
-        log_error("Failure create mutex object");
+        log_error("Failure allocating condition object");
+        *handle = NULL;
+        result = __LINE__;
+    }
+    else if (pthread_cond_init(condition, NULL) != 0)
+    {
+        log_error("Failure create condition object");
+        free(condition);
+        *handle = NULL;
         result = __LINE__;
     }
     else
     {
+        *handle = condition;
         result = 0;
     }
     return result;
@@ -29,13 +40,17 @@ int condition_mgr_init(SIGNAL_HANDLE* handle)
 
 void condition_mgr_deinit(SIGNAL_HANDLE handle)
 {
-    (void)pthread_cond_destroy(&handle);
+    if (handle != NULL)
+    {
+        (void)pthread_cond_destroy(handle);
+        free(handle);
+    }
 }
 
 int condition_mgr_signal(SIGNAL_HANDLE handle)
 {
     int result;
-    if (pthread_cond_signal(&handle) == 0)
+    if (pthread_cond_signal(handle) == 0)
     {
         result = 0;
     }
@@ -50,7 +65,7 @@ int condition_mgr_signal(SIGNAL_HANDLE handle)
 int condition_mgr_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex)
 {
     int result;
-    if (pthread_cond_wait(&handle, &mutex) == 0)
+    if (pthread_cond_wait(handle, mutex) == 0)
     {
         result = 0;
     }
@@ -65,7 +80,7 @@ int condition_mgr_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex)
 int condition_mgr_timed_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex, const struct timespec* abstime)
 {
     int result;
-    if (pthread_cond_timedwait(&handle, &mutex, abstime) == 0)
+    if (pthread_cond_timedwait(handle, mutex, abstime) == 0)
     {
         result = 0;
     }
@@ -80,7 +95,7 @@ int condition_mgr_timed_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex, const str
 int condition_mgr_broadcast(SIGNAL_HANDLE handle)
 {
     int result;
-    if (pthread_cond_broadcast(&handle) == 0)
+    if (pthread_cond_broadcast(handle) == 0)
     {
         result = 0;
     }
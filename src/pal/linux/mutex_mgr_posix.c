@@ -5,22 +5,33 @@
 
 #include "lib-util-c/app_logging.h"
 #include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/sys_debug_shim.h"
 
 int mutex_mgr_create(MUTEX_HANDLE* handle)
 {
     int result;
+    pthread_mutex_t* mutex;
     if (handle == NULL)
     {
         log_error("Invalid Parameter specified");
         result = __LINE__;
     }
-    else if (pthread_mutex_init(handle, NULL) != 0)
+    else if ((mutex = (pthread_mutex_t*)malloc(sizeof(pthread_mutex_t))) == NULL)
+    {
+        log_error("Failure allocating mutex object");
+        *handle = NULL;
+        result = __LINE__;
+    }
+    else if (pthread_mutex_init(mutex, NULL) != 0)
     {
         log_error("Failure create mutex object");
+        free(mutex);
+        *handle = NULL;
         result = __LINE__;
     }
     else
     {
+        *handle = mutex;
         result = 0;
     }
     return result;
@@ -28,13 +39,17 @@ int mutex_mgr_create(MUTEX_HANDLE* handle)
 
 void mutex_mgr_destroy(MUTEX_HANDLE handle)
 {
-    (void)pthread_mutex_destroy(&handle);
+    if (handle != NULL)
+    {
+        (void)pthread_mutex_destroy(handle);
+        free(handle);
+    }
 }
 
 int mutex_mgr_lock(MUTEX_HANDLE handle)
 {
     int result;
-    if (pthread_mutex_lock(&handle) == 0)
+    if (pthread_mutex_lock(handle) == 0)
     {
         result = 0;
     }
@@ -48,7 +63,7 @@ int mutex_mgr_lock(MUTEX_HANDLE handle)
 int mutex_mgr_trylock(MUTEX_HANDLE handle)
 {
     int result;
-    if (pthread_mutex_trylock(&handle) == 0)
+    if (pthread_mutex_trylock(handle) == 0)
     {
         result = 0;
     }
@@ -62,7 +77,7 @@ int mutex_mgr_trylock(MUTEX_HANDLE handle)
 int mutex_mgr_unlock(MUTEX_HANDLE handle)
 {
     int result;
-    if (pthread_mutex_unlock(&handle) == 0)
+    if (pthread_mutex_unlock(handle) == 0)
     {
         result = 0;
     }
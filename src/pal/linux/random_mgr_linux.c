@@ -0,0 +1,39 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <errno.h>
+#include <sys/types.h>
+#include <sys/random.h>
+
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/random_mgr.h"
+
+int random_mgr_get_bytes(unsigned char* buffer, size_t len)
+{
+    int result;
+    if (buffer == NULL || len == 0)
+    {
+        log_error("Invalid parameter specified buffer: %p, len: %zu", buffer, len);
+        result = __LINE__;
+    }
+    else
+    {
+        size_t filled = 0;
+        result = 0;
+        while (filled < len && result == 0)
+        {
+            // Large requests and signals can return fewer bytes than asked for
+            ssize_t read_len = getrandom(buffer + filled, len - filled, 0);
+            if (read_len > 0)
+            {
+                filled += (size_t)read_len;
+            }
+            else if (read_len < 0 && errno != EINTR)
+            {
+                log_error("Failure reading random bytes errno: %d", errno);
+                result = __LINE__;
+            }
+        }
+    }
+    return result;
+}
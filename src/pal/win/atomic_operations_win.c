@@ -91,3 +91,75 @@ long atomic_subtract(long* operand, long value)
     return result;
 }
 
+int64_t atomic_load64(int64_t* value)
+{
+    int64_t result;
+    if (value == NULL)
+    {
+        result = 0;
+    }
+    else
+    {
+        // A compare with matching operands is a full barrier read
+        result = InterlockedCompareExchange64(value, 0, 0);
+    }
+    return result;
+}
+
+void atomic_store64(int64_t* value, int64_t new_value)
+{
+    if (value != NULL)
+    {
+        (void)InterlockedExchange64(value, new_value);
+    }
+}
+
+bool atomic_compare_exchange64(int64_t* value, int64_t expected, int64_t desired)
+{
+    bool result;
+    if (value == NULL)
+    {
+        result = false;
+    }
+    else
+    {
+        result = InterlockedCompareExchange64(value, desired, expected) == expected;
+    }
+    return result;
+}
+
+void* atomic_load_ptr(void** value)
+{
+    void* result;
+    if (value == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = InterlockedCompareExchangePointer(value, NULL, NULL);
+    }
+    return result;
+}
+
+void atomic_store_ptr(void** value, void* new_value)
+{
+    if (value != NULL)
+    {
+        (void)InterlockedExchangePointer(value, new_value);
+    }
+}
+
+void* atomic_exchange_ptr(void** value, void* new_value)
+{
+    void* result;
+    if (value == NULL)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = InterlockedExchangePointer(value, new_value);
+    }
+    return result;
+}
@@ -7,6 +7,7 @@
 #include "lib-util-c/app_logging.h"
 #include "lib-util-c/condition_mgr.h"
 #include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/sys_debug_shim.h"
 
 static DWORD timespec_to_ms(const struct timespec* abstime)
 {
@@ -29,7 +30,7 @@ static DWORD timespec_to_ms(const struct timespec* abstime)
 static int start_timed_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex, const struct timespec* abstime)
 {
     int result;
-    if (SleepConditionVariableCS(&handle, mutex, timespec_to_ms(abstime)))
+    if (SleepConditionVariableCS(handle, mutex, timespec_to_ms(abstime)))
     {
         result = 0;
     }
@@ -48,9 +49,14 @@ int condition_mgr_init(SIGNAL_HANDLE* handle)
         log_error("Invalid Parameter specified");
         result = __LINE__;
     }
+    else if ((*handle = (CONDITION_VARIABLE*)malloc(sizeof(CONDITION_VARIABLE))) == NULL)
+    {
+        log_error("Failure allocating condition object");
+        result = __LINE__;
+    }
     else
     {
-        InitializeConditionVariable(handle);
+        InitializeConditionVariable(*handle);
         result = 0;
     }
     return result;
@@ -58,13 +64,13 @@ int condition_mgr_init(SIGNAL_HANDLE* handle)
 
 void condition_mgr_deinit(SIGNAL_HANDLE handle)
 {
-    (void)handle;
-    // You don't have to deinit the condition variable
+    // You don't have to deinit the condition variable, only release it
+    free(handle);
 }
 
 int condition_mgr_signal(SIGNAL_HANDLE handle)
 {
-    WakeConditionVariable(&handle);
+    WakeConditionVariable(handle);
     return 0;
 }
 
@@ -81,6 +87,6 @@ int condition_mgr_timed_wait(SIGNAL_HANDLE handle, MUTEX_HANDLE mutex,
 
 int condition_mgr_broadcast(SIGNAL_HANDLE handle)
 {
-    WakeAllConditionVariable(&handle);
+    WakeAllConditionVariable(handle);
     return 0;
 }
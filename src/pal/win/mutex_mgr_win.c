@@ -17,7 +17,7 @@ int mutex_mgr_create(MUTEX_HANDLE* handle)
         log_error("Invalid parameter specified");
         result = __LINE__;
     }
-    else if ((test = CreateMutex(NULL, TRUE, NULL)) == NULL)
+    else if ((test = CreateMutex(NULL, FALSE, NULL)) == NULL)
     {
         log_error("Failure create mutex object");
         result = __LINE__;
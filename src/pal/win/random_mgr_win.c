@@ -0,0 +1,28 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdlib.h>
+#include <windows.h>
+#include <bcrypt.h>
+
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/random_mgr.h"
+
+int random_mgr_get_bytes(unsigned char* buffer, size_t len)
+{
+    int result;
+    if (buffer == NULL || len == 0 || len > ULONG_MAX)
+    {
+        log_error("Invalid parameter specified buffer: %p, len: %zu", buffer, len);
+        result = __LINE__;
+    }
+    else if (!BCRYPT_SUCCESS(BCryptGenRandom(NULL, buffer, (ULONG)len, BCRYPT_USE_SYSTEM_PREFERRED_RNG)))
+    {
+        log_error("Failure reading random bytes");
+        result = __LINE__;
+    }
+    else
+    {
+        result = 0;
+    }
+    return result;
+}
@@ -0,0 +1,404 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/app_logging.h"
+#include "lib-util-c/priority_queue.h"
+#include "lib-util-c/node_pool.h"
+
+// Four 16 byte slots per family so a sift down compares the children
+// from one or two cache lines and the tree is half the height of a
+// binary heap
+#define HEAP_ARITY                  4
+#define DEFAULT_HEAP_CAPACITY       16
+
+typedef struct PRIORITY_QUEUE_ENTRY_TAG
+{
+    // Free list link while the entry is unused
+    struct PRIORITY_QUEUE_ENTRY_TAG* next;
+    void* item;
+    size_t heap_index;
+} PRIORITY_QUEUE_ENTRY;
+
+// The priority sits in the heap next to the entry pointer so sifting
+// only touches the heap array
+typedef struct HEAP_SLOT_TAG
+{
+    uint64_t priority;
+    PRIORITY_QUEUE_ENTRY* entry;
+} HEAP_SLOT;
+
+typedef struct PRIORITY_QUEUE_INFO_TAG
+{
+    HEAP_SLOT* heap;
+    size_t item_count;
+    size_t heap_capacity;
+    NODE_POOL entry_pool;
+    PRIORITY_QUEUE_DESTROY_ITEM destroy_cb;
+    void* user_ctx;
+} PRIORITY_QUEUE_INFO;
+
+static int reserve_heap_slots(PRIORITY_QUEUE_INFO* queue_info, size_t capacity)
+{
+    int result;
+    if (capacity <= queue_info->heap_capacity)
+    {
+        result = 0;
+    }
+    else if (capacity > SIZE_MAX / sizeof(HEAP_SLOT))
+    {
+        log_error("Failure heap capacity %zu too large", capacity);
+        result = __LINE__;
+    }
+    else
+    {
+        HEAP_SLOT* temp_heap = (HEAP_SLOT*)realloc(queue_info->heap, capacity*sizeof(HEAP_SLOT));
+        if (temp_heap == NULL)
+        {
+            log_error("Failure reallocating heap");
+            result = __LINE__;
+        }
+        else
+        {
+            queue_info->heap = temp_heap;
+            queue_info->heap_capacity = capacity;
+            result = 0;
+        }
+    }
+    return result;
+}
+
+static void place_slot(PRIORITY_QUEUE_INFO* queue_info, size_t index, HEAP_SLOT slot)
+{
+    queue_info->heap[index] = slot;
+    slot.entry->heap_index = index;
+}
+
+// Moves parents down into the hole until slot fits, one write per level
+// instead of a swap
+static void sift_up(PRIORITY_QUEUE_INFO* queue_info, size_t index, HEAP_SLOT slot)
+{
+    while (index > 0)
+    {
+        size_t parent = (index - 1) / HEAP_ARITY;
+        if (queue_info->heap[parent].priority <= slot.priority)
+        {
+            break;
+        }
+        place_slot(queue_info, index, queue_info->heap[parent]);
+        index = parent;
+    }
+    place_slot(queue_info, index, slot);
+}
+
+static void sift_down(PRIORITY_QUEUE_INFO* queue_info, size_t index, HEAP_SLOT slot)
+{
+    size_t first_child;
+    while ((first_child = (index * HEAP_ARITY) + 1) < queue_info->item_count)
+    {
+        size_t last_child = first_child + HEAP_ARITY;
+        size_t min_child = first_child;
+        if (last_child > queue_info->item_count)
+        {
+            last_child = queue_info->item_count;
+        }
+        for (size_t child = first_child + 1; child < last_child; child++)
+        {
+            if (queue_info->heap[child].priority < queue_info->heap[min_child].priority)
+            {
+                min_child = child;
+            }
+        }
+        if (queue_info->heap[min_child].priority >= slot.priority)
+        {
+            break;
+        }
+        place_slot(queue_info, index, queue_info->heap[min_child]);
+        index = min_child;
+    }
+    place_slot(queue_info, index, slot);
+}
+
+static int grow_heap(PRIORITY_QUEUE_INFO* queue_info, size_t add_count)
+{
+    int result;
+    size_t required = queue_info->item_count + add_count;
+    if (required < queue_info->item_count)
+    {
+        log_error("Failure heap size overflow");
+        result = __LINE__;
+    }
+    else if (required <= queue_info->heap_capacity)
+    {
+        result = 0;
+    }
+    else
+    {
+        // Double the heap so pushes are amortized O(1)
+        size_t capacity = queue_info->heap_capacity == 0 ? DEFAULT_HEAP_CAPACITY : queue_info->heap_capacity;
+        while (capacity < required && capacity <= SIZE_MAX/2)
+        {
+            capacity *= 2;
+        }
+        if (capacity < required)
+        {
+            capacity = required;
+        }
+        result = reserve_heap_slots(queue_info, capacity);
+    }
+    return result;
+}
+
+PRIORITY_QUEUE_HANDLE priority_queue_create(size_t capacity, PRIORITY_QUEUE_DESTROY_ITEM destroy_cb, void* user_ctx)
+{
+    PRIORITY_QUEUE_INFO* result;
+    if ((result = (PRIORITY_QUEUE_INFO*)malloc(sizeof(PRIORITY_QUEUE_INFO))) == NULL)
+    {
+        log_error("Failure allocating priority queue");
+    }
+    else
+    {
+        memset(result, 0, sizeof(PRIORITY_QUEUE_INFO));
+        result->destroy_cb = destroy_cb;
+        result->user_ctx = user_ctx;
+        node_pool_init(&result->entry_pool, sizeof(PRIORITY_QUEUE_ENTRY), offsetof(PRIORITY_QUEUE_ENTRY, next));
+        if (capacity > 0)
+        {
+            if (reserve_heap_slots(result, capacity) != 0)
+            {
+                log_error("Failure allocating heap");
+                free(result);
+                result = NULL;
+            }
+            else if (node_pool_reserve(&result->entry_pool, capacity) != 0)
+            {
+                log_error("Failure preallocating entries");
+                free(result->heap);
+                free(result);
+                result = NULL;
+            }
+        }
+    }
+    return result;
+}
+
+void priority_queue_destroy(PRIORITY_QUEUE_HANDLE handle)
+{
+    if (handle != NULL)
+    {
+        if (handle->destroy_cb != NULL)
+        {
+            for (size_t index = 0; index < handle->item_count; index++)
+            {
+                handle->destroy_cb(handle->user_ctx, handle->heap[index].entry->item);
+            }
+        }
+        node_pool_deinit(&handle->entry_pool);
+        free(handle->heap);
+        free(handle);
+    }
+}
+
+int priority_queue_push(PRIORITY_QUEUE_HANDLE handle, uint64_t priority, void* item, PRIORITY_QUEUE_ENTRY_HANDLE* entry)
+{
+    int result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = __LINE__;
+    }
+    else if (grow_heap(handle, 1) != 0)
+    {
+        log_error("Failure growing heap");
+        result = __LINE__;
+    }
+    else
+    {
+        HEAP_SLOT slot;
+        if ((slot.entry = (PRIORITY_QUEUE_ENTRY*)node_pool_allocate(&handle->entry_pool)) == NULL)
+        {
+            log_error("Failure allocating entry");
+            result = __LINE__;
+        }
+        else
+        {
+            slot.priority = priority;
+            slot.entry->item = item;
+            handle->item_count++;
+            sift_up(handle, handle->item_count - 1, slot);
+            if (entry != NULL)
+            {
+                *entry = slot.entry;
+            }
+            result = 0;
+        }
+    }
+    return result;
+}
+
+int priority_queue_pop(PRIORITY_QUEUE_HANDLE handle, void** item, uint64_t* priority)
+{
+    int result;
+    if (handle == NULL || item == NULL)
+    {
+        log_error("Invalid parameter handle: %p, item: %p", handle, item);
+        result = __LINE__;
+    }
+    else if (handle->item_count == 0)
+    {
+        result = __LINE__;
+    }
+    else
+    {
+        PRIORITY_QUEUE_ENTRY* top = handle->heap[0].entry;
+        *item = top->item;
+        if (priority != NULL)
+        {
+            *priority = handle->heap[0].priority;
+        }
+        node_pool_release(&handle->entry_pool, top);
+
+        // Sift the last slot down from the root to fill the hole
+        handle->item_count--;
+        if (handle->item_count > 0)
+        {
+            sift_down(handle, 0, handle->heap[handle->item_count]);
+        }
+        result = 0;
+    }
+    return result;
+}
+
+void* priority_queue_peek(PRIORITY_QUEUE_HANDLE handle, uint64_t* priority)
+{
+    void* result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = NULL;
+    }
+    else if (handle->item_count == 0)
+    {
+        result = NULL;
+    }
+    else
+    {
+        result = handle->heap[0].entry->item;
+        if (priority != NULL)
+        {
+            *priority = handle->heap[0].priority;
+        }
+    }
+    return result;
+}
+
+int priority_queue_decrease_key(PRIORITY_QUEUE_HANDLE handle, PRIORITY_QUEUE_ENTRY_HANDLE entry, uint64_t priority)
+{
+    int result;
+    if (handle == NULL || entry == NULL)
+    {
+        log_error("Invalid parameter handle: %p, entry: %p", handle, entry);
+        result = __LINE__;
+    }
+    else if (entry->heap_index >= handle->item_count || handle->heap[entry->heap_index].entry != entry)
+    {
+        log_error("Invalid entry, it is not in the queue");
+        result = __LINE__;
+    }
+    else if (priority > handle->heap[entry->heap_index].priority)
+    {
+        log_error("Invalid priority, it is higher than the current priority");
+        result = __LINE__;
+    }
+    else
+    {
+        HEAP_SLOT slot;
+        slot.priority = priority;
+        slot.entry = entry;
+        sift_up(handle, entry->heap_index, slot);
+        result = 0;
+    }
+    return result;
+}
+
+int priority_queue_heapify(PRIORITY_QUEUE_HANDLE handle, const uint64_t* priorities, void** items, size_t count, PRIORITY_QUEUE_ENTRY_HANDLE* entries)
+{
+    int result;
+    if (handle == NULL || (count > 0 && (priorities == NULL || items == NULL)))
+    {
+        log_error("Invalid parameter handle: %p, priorities: %p, items: %p", handle, priorities, items);
+        result = __LINE__;
+    }
+    else if (grow_heap(handle, count) != 0)
+    {
+        log_error("Failure growing heap");
+        result = __LINE__;
+    }
+    else
+    {
+        size_t original_count = handle->item_count;
+        size_t index;
+        // Append without ordering, the heap is rebuilt once below
+        for (index = 0; index < count; index++)
+        {
+            HEAP_SLOT* slot = &handle->heap[original_count + index];
+            if ((slot->entry = (PRIORITY_QUEUE_ENTRY*)node_pool_allocate(&handle->entry_pool)) == NULL)
+            {
+                break;
+            }
+            slot->priority = priorities[index];
+            slot->entry->item = items[index];
+            slot->entry->heap_index = original_count + index;
+            if (entries != NULL)
+            {
+                entries[index] = slot->entry;
+            }
+        }
+
+        if (index < count)
+        {
+            log_error("Failure allocating entry");
+            while (index > 0)
+            {
+                index--;
+                node_pool_release(&handle->entry_pool, handle->heap[original_count + index].entry);
+            }
+            result = __LINE__;
+        }
+        else
+        {
+            handle->item_count += count;
+            // Floyd's build, sift every parent down starting from the last one
+            if (handle->item_count > 1)
+            {
+                for (index = ((handle->item_count - 2) / HEAP_ARITY) + 1; index > 0; index--)
+                {
+                    sift_down(handle, index - 1, handle->heap[index - 1]);
+                }
+            }
+            result = 0;
+        }
+    }
+    return result;
+}
+
+size_t priority_queue_item_count(PRIORITY_QUEUE_HANDLE handle)
+{
+    size_t result;
+    if (handle == NULL)
+    {
+        log_error("Invalid parameter handle NULL");
+        result = 0;
+    }
+    else
+    {
+        result = handle->item_count;
+    }
+    return result;
+}
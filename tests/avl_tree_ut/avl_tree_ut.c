@@ -0,0 +1,555 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#endif
+
+// Include the test tools.
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_bool.h"
+
+#include "lib-util-c/avl_tree.h"
+
+#define TEST_ITEM_COUNT         64
+
+typedef struct TEST_TREE_ITEM_TAG
+{
+    size_t id;
+    const char* tag;
+    AVL_TREE_ENTRY tree_entry;
+} TEST_TREE_ITEM;
+
+static int compare_items(const AVL_TREE_ENTRY* entry_1, const AVL_TREE_ENTRY* entry_2)
+{
+    size_t id_1 = AVL_TREE_CONTAINING_RECORD(entry_1, TEST_TREE_ITEM, tree_entry)->id;
+    size_t id_2 = AVL_TREE_CONTAINING_RECORD(entry_2, TEST_TREE_ITEM, tree_entry)->id;
+    return id_1 < id_2 ? -1 : (id_1 > id_2 ? 1 : 0);
+}
+
+static size_t get_item_id(const AVL_TREE_ENTRY* entry)
+{
+    return AVL_TREE_CONTAINING_RECORD(entry, TEST_TREE_ITEM, tree_entry)->id;
+}
+
+// Walks the whole tree checking the parent links, the stored heights
+// and the AVL balance, returns the subtree height or 0 on a violation
+static size_t validate_subtree(const AVL_TREE_ENTRY* entry, const AVL_TREE_ENTRY* parent, size_t* entry_count)
+{
+    size_t result;
+    if (entry == NULL)
+    {
+        result = 0;
+    }
+    else if (entry->parent != parent)
+    {
+        result = 0;
+    }
+    else
+    {
+        size_t left_height = entry->left == NULL ? 0 : validate_subtree(entry->left, entry, entry_count);
+        size_t right_height = entry->right == NULL ? 0 : validate_subtree(entry->right, entry, entry_count);
+        size_t expected_height = (left_height > right_height ? left_height : right_height) + 1;
+        if ((entry->left != NULL && left_height == 0) || (entry->right != NULL && right_height == 0) ||
+            left_height > right_height + 1 || right_height > left_height + 1 || entry->height != expected_height)
+        {
+            result = 0;
+        }
+        else
+        {
+            (*entry_count)++;
+            result = entry->height;
+        }
+    }
+    return result;
+}
+
+static bool is_tree_valid(const AVL_TREE_ROOT* tree_root)
+{
+    size_t entry_count = 0;
+    size_t height = validate_subtree(tree_root->root_entry, NULL, &entry_count);
+    return (tree_root->root_entry == NULL || height != 0) && entry_count == avl_tree_count(tree_root);
+}
+
+// Inserts the ids in a scrambled order so the rotations get exercised
+static void fill_tree(AVL_TREE_ROOT* tree_root, TEST_TREE_ITEM* items, size_t count)
+{
+    avl_tree_init(tree_root, compare_items);
+    for (size_t index = 0; index < count; index++)
+    {
+        items[index].id = ((index * 37) % count) * 2;
+        items[index].tag = "Test Item";
+        (void)avl_tree_insert(tree_root, &items[index].tree_entry);
+    }
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(avl_tree_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umock_c_init(on_umock_c_error));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, umocktypes_bool_register_types());
+
+    REGISTER_UMOCK_ALIAS_TYPE(PAVL_TREE_ENTRY, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(PAVL_TREE_ROOT, void*);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(avl_tree_init_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+
+    //act
+    avl_tree_init(&tree_root, compare_items);
+
+    //assert
+    CTEST_ASSERT_IS_NULL(tree_root.root_entry);
+    CTEST_ASSERT_IS_TRUE(avl_tree_is_empty(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, avl_tree_height(&tree_root));
+    CTEST_ASSERT_IS_NULL(avl_tree_first(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_tree_root_NULL_fail)
+{
+    //arrange
+    TEST_TREE_ITEM test_item = { 1, "Test Item 1" };
+
+    //act
+    int result = avl_tree_insert(NULL, &test_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_entry_NULL_fail)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    avl_tree_init(&tree_root, compare_items);
+
+    //act
+    int result = avl_tree_insert(&tree_root, NULL);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(avl_tree_is_empty(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_no_compare_fail)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item = { 1, "Test Item 1" };
+    avl_tree_init(&tree_root, NULL);
+
+    //act
+    int result = avl_tree_insert(&tree_root, &test_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(avl_tree_is_empty(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item = { 1, "Test Item 1" };
+    avl_tree_init(&tree_root, compare_items);
+
+    //act
+    int result = avl_tree_insert(&tree_root, &test_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_FALSE(avl_tree_is_empty(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item.tree_entry, tree_root.root_entry);
+    CTEST_ASSERT_IS_NULL(test_item.tree_entry.parent);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, avl_tree_height(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_duplicate_fail)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item_1 = { 1, "Test Item 1" };
+    TEST_TREE_ITEM test_item_2 = { 1, "Test Item 2" };
+    avl_tree_init(&tree_root, compare_items);
+    (void)avl_tree_insert(&tree_root, &test_item_1.tree_entry);
+
+    //act
+    int result = avl_tree_insert(&tree_root, &test_item_2.tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item_1.tree_entry, avl_tree_find(&tree_root, &test_item_2.tree_entry));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_insert_ascending_balanced_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    avl_tree_init(&tree_root, compare_items);
+
+    //act
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        test_items[index].id = index;
+        CTEST_ASSERT_ARE_EQUAL(int, 0, avl_tree_insert(&tree_root, &test_items[index].tree_entry));
+    }
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, avl_tree_count(&tree_root));
+    // 64 sorted inserts end up a perfect tree plus one level
+    CTEST_ASSERT_ARE_EQUAL(size_t, 7, avl_tree_height(&tree_root));
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_find_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    TEST_TREE_ITEM key_item = { 0 };
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        key_item.id = test_items[index].id;
+
+        //act
+        PAVL_TREE_ENTRY result = avl_tree_find(&tree_root, &key_item.tree_entry);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_items[index], AVL_TREE_CONTAINING_RECORD(result, TEST_TREE_ITEM, tree_entry));
+    }
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_find_not_found_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    TEST_TREE_ITEM key_item = { 7 };
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    //act
+    PAVL_TREE_ENTRY result = avl_tree_find(&tree_root, &key_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_IS_NULL(result);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_find_empty_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM key_item = { 1 };
+    avl_tree_init(&tree_root, compare_items);
+
+    //act
+    PAVL_TREE_ENTRY result = avl_tree_find(&tree_root, &key_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_IS_NULL(result);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_lower_bound_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    TEST_TREE_ITEM key_item = { 0 };
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    // The ids are the even numbers, an exact hit and the gap before it land on the same entry
+    for (size_t id = 0; id < TEST_ITEM_COUNT * 2 - 1; id++)
+    {
+        key_item.id = id;
+
+        //act
+        PAVL_TREE_ENTRY result = avl_tree_lower_bound(&tree_root, &key_item.tree_entry);
+
+        //assert
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, (id + 1) & ~(size_t)1, get_item_id(result));
+    }
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_lower_bound_past_end_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    TEST_TREE_ITEM key_item = { TEST_ITEM_COUNT * 2 };
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    //act
+    PAVL_TREE_ENTRY result = avl_tree_lower_bound(&tree_root, &key_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_IS_NULL(result);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_next_in_order_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    size_t visit_count = 0;
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    //act
+    for (PAVL_TREE_ENTRY entry = avl_tree_first(&tree_root); entry != NULL; entry = avl_tree_next(entry))
+    {
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(size_t, visit_count * 2, get_item_id(entry));
+        visit_count++;
+    }
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, visit_count);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_prev_in_order_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    size_t visit_count = 0;
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    //act
+    for (PAVL_TREE_ENTRY entry = avl_tree_last(&tree_root); entry != NULL; entry = avl_tree_prev(entry))
+    {
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(size_t, (TEST_ITEM_COUNT - 1 - visit_count) * 2, get_item_id(entry));
+        visit_count++;
+    }
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, visit_count);
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_remove_entry_leaf_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item_1 = { 1, "Test Item 1" };
+    TEST_TREE_ITEM test_item_2 = { 2, "Test Item 2" };
+    avl_tree_init(&tree_root, compare_items);
+    (void)avl_tree_insert(&tree_root, &test_item_1.tree_entry);
+    (void)avl_tree_insert(&tree_root, &test_item_2.tree_entry);
+
+    //act
+    avl_tree_remove_entry(&tree_root, &test_item_2.tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item_1.tree_entry, tree_root.root_entry);
+    CTEST_ASSERT_IS_NULL(test_item_1.tree_entry.right);
+    CTEST_ASSERT_IS_NULL(avl_tree_find(&tree_root, &test_item_2.tree_entry));
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_remove_entry_last_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item = { 1, "Test Item 1" };
+    avl_tree_init(&tree_root, compare_items);
+    (void)avl_tree_insert(&tree_root, &test_item.tree_entry);
+
+    //act
+    avl_tree_remove_entry(&tree_root, &test_item.tree_entry);
+
+    //assert
+    CTEST_ASSERT_IS_TRUE(avl_tree_is_empty(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, avl_tree_count(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_remove_entry_root_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+    PAVL_TREE_ENTRY root_entry = tree_root.root_entry;
+
+    //act
+    avl_tree_remove_entry(&tree_root, root_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT - 1, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, root_entry, tree_root.root_entry);
+    CTEST_ASSERT_IS_NULL(avl_tree_find(&tree_root, root_entry));
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_remove_entry_all_balanced_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+
+    //act
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        avl_tree_remove_entry(&tree_root, &test_items[(index * 11) % TEST_ITEM_COUNT].tree_entry);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+        CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT - index - 1, avl_tree_count(&tree_root));
+    }
+
+    //assert
+    CTEST_ASSERT_IS_TRUE(avl_tree_is_empty(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_remove_entry_reinsert_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    fill_tree(&tree_root, test_items, TEST_ITEM_COUNT);
+    avl_tree_remove_entry(&tree_root, &test_items[5].tree_entry);
+
+    //act
+    int result = avl_tree_insert(&tree_root, &test_items[5].tree_entry);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_items[5].tree_entry, avl_tree_find(&tree_root, &test_items[5].tree_entry));
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_link_entry_ascending_balanced_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_items[TEST_ITEM_COUNT];
+    PAVL_TREE_ENTRY parent_entry = NULL;
+    avl_tree_init(&tree_root, NULL);
+
+    //act
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        // The caller does the search, ascending ids always go below the rightmost entry
+        PAVL_TREE_ENTRY* link = parent_entry == NULL ? &tree_root.root_entry : &parent_entry->right;
+        test_items[index].id = index;
+        avl_tree_link_entry(&tree_root, parent_entry, link, &test_items[index].tree_entry);
+        parent_entry = &test_items[index].tree_entry;
+    }
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, avl_tree_count(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 7, avl_tree_height(&tree_root));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, get_item_id(avl_tree_first(&tree_root)));
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_FUNCTION(avl_tree_rebalance_entry_rotate_succeed)
+{
+    //arrange
+    AVL_TREE_ROOT tree_root;
+    TEST_TREE_ITEM test_item_1 = { 1, "Test Item 1" };
+    TEST_TREE_ITEM test_item_2 = { 2, "Test Item 2" };
+    TEST_TREE_ITEM test_item_3 = { 3, "Test Item 3" };
+    avl_tree_init(&tree_root, compare_items);
+    // A right leaning chain 1 -> 2 -> 3 with balanced subtrees below the top
+    test_item_1.tree_entry.parent = NULL;
+    test_item_1.tree_entry.left = NULL;
+    test_item_1.tree_entry.right = &test_item_2.tree_entry;
+    test_item_2.tree_entry.parent = &test_item_1.tree_entry;
+    test_item_2.tree_entry.left = NULL;
+    test_item_2.tree_entry.right = &test_item_3.tree_entry;
+    test_item_2.tree_entry.height = 2;
+    test_item_3.tree_entry.parent = &test_item_2.tree_entry;
+    test_item_3.tree_entry.left = test_item_3.tree_entry.right = NULL;
+    test_item_3.tree_entry.height = 1;
+
+    //act
+    tree_root.root_entry = avl_tree_rebalance_entry(&test_item_1.tree_entry);
+    tree_root.entry_count = 3;
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item_2.tree_entry, tree_root.root_entry);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item_1.tree_entry, test_item_2.tree_entry.left);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &test_item_3.tree_entry, test_item_2.tree_entry.right);
+    CTEST_ASSERT_IS_TRUE(is_tree_valid(&tree_root));
+
+    //cleanup
+}
+
+CTEST_END_TEST_SUITE(avl_tree_ut)
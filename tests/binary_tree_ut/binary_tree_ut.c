@@ -5,6 +5,7 @@
 #include <cstddef>
 #else
 #include <stdlib.h>
+#include <string.h>
 #endif
 
 static void* my_mem_shim_malloc(size_t size)
@@ -60,6 +61,58 @@ static const NODE_KEY INVALID_ITEM = 0x01;
 
 static void* DATA_VALUE = (void*)0x11;
 
+static const char* STRING_KEYS[] = { "mango", "apple", "peach", "banana", "cherry", "lemon", "grape" };
+#define WIDE_KEY_COUNT  1000
+
+static int compare_string_keys(const void* key_1, const void* key_2)
+{
+    return strcmp((const char*)key_1, (const char*)key_2);
+}
+
+#define MAX_VISITED_ITEMS   16
+
+typedef struct VISIT_RESULT_TAG
+{
+    size_t count;
+    // Stop the walk after this many items, 0 visits the whole range
+    size_t stop_after;
+    const void* items[MAX_VISITED_ITEMS];
+} VISIT_RESULT;
+
+static int visit_item(void* user_ctx, void* data)
+{
+    VISIT_RESULT* visit_result = (VISIT_RESULT*)user_ctx;
+    if (visit_result->count < MAX_VISITED_ITEMS)
+    {
+        visit_result->items[visit_result->count] = data;
+    }
+    visit_result->count++;
+    return visit_result->count == visit_result->stop_after ? 1 : 0;
+}
+
+// Each item's data points at its own key so the walk order can be checked
+static BINARY_TREE_HANDLE create_value_tree(void)
+{
+    BINARY_TREE_HANDLE result = binary_tree_create();
+    size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        (void)binary_tree_insert(result, INSERT_FOR_NO_ROTATION[index], (void*)&INSERT_FOR_NO_ROTATION[index]);
+    }
+    return result;
+}
+
+static BINARY_TREE_HANDLE create_string_tree(void)
+{
+    BINARY_TREE_HANDLE result = binary_tree_create_with_compare(compare_string_keys);
+    size_t count = sizeof(STRING_KEYS)/sizeof(STRING_KEYS[0]);
+    for (size_t index = 0; index < count; index++)
+    {
+        (void)binary_tree_insert_key(result, STRING_KEYS[index], (void*)STRING_KEYS[index]);
+    }
+    return result;
+}
+
 CTEST_BEGIN_TEST_SUITE(binary_tree_ut)
 
 CTEST_SUITE_INITIALIZE()
@@ -178,7 +231,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         BINARY_TREE_HANDLE handle = binary_tree_create();
 
         //act
-        size_t count = sizeof(INSERT_FOR_RIGHT_ROTATION);
+        size_t count = sizeof(INSERT_FOR_RIGHT_ROTATION)/sizeof(INSERT_FOR_RIGHT_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             int result = binary_tree_insert(handle, INSERT_FOR_RIGHT_ROTATION[index], DATA_VALUE);
@@ -198,7 +251,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         BINARY_TREE_HANDLE handle = binary_tree_create();
 
         //act
-        size_t count = sizeof(INSERT_FOR_RIGHT_LEFT_ROTATION);
+        size_t count = sizeof(INSERT_FOR_RIGHT_LEFT_ROTATION)/sizeof(INSERT_FOR_RIGHT_LEFT_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             int result = binary_tree_insert(handle, INSERT_FOR_RIGHT_LEFT_ROTATION[index], DATA_VALUE);
@@ -218,7 +271,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         BINARY_TREE_HANDLE handle = binary_tree_create();
 
         //act
-        size_t count = sizeof(INSERT_FOR_LEFT_RIGHT_ROTATION);
+        size_t count = sizeof(INSERT_FOR_LEFT_RIGHT_ROTATION)/sizeof(INSERT_FOR_LEFT_RIGHT_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             int result = binary_tree_insert(handle, INSERT_FOR_LEFT_RIGHT_ROTATION[index], DATA_VALUE);
@@ -241,7 +294,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         const NODE_KEY INSERT_FOR_LEFT_ROTATION[] = { 0x7, 0x5, 0xa, 0xb, 0xd };
         const char* VISUAL_LEFT_ROTATION = "7(5)(b(a)(d))";
 
-        size_t count = sizeof(INSERT_FOR_LEFT_ROTATION);
+        size_t count = sizeof(INSERT_FOR_LEFT_ROTATION)/sizeof(INSERT_FOR_LEFT_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             int result = binary_tree_insert(handle, INSERT_FOR_LEFT_ROTATION[index], DATA_VALUE);
@@ -264,7 +317,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         static const NODE_KEY INSERT_FOR_LEFT_ROTATION[] = { 0x7, 0x5, 0xa, 0xd, 0xb };
         const char* VISUAL_LEFT_ROTATION = "7(5)(b(a)(d))";
 
-        size_t count = sizeof(INSERT_FOR_LEFT_ROTATION);
+        size_t count = sizeof(INSERT_FOR_LEFT_ROTATION)/sizeof(INSERT_FOR_LEFT_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             int result = binary_tree_insert(handle, INSERT_FOR_LEFT_ROTATION[index], DATA_VALUE);
@@ -279,6 +332,75 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     }
 
 
+    CTEST_FUNCTION(binary_tree_insert_ascending_root_rotate_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        static const NODE_KEY INSERT_FOR_ROOT_ROTATION[] = { 0x1, 0x2, 0x3 };
+
+        //act
+        size_t count = sizeof(INSERT_FOR_ROOT_ROTATION)/sizeof(INSERT_FOR_ROOT_ROTATION[0]);
+        for (size_t index = 0; index < count; index++)
+        {
+            int result = binary_tree_insert(handle, INSERT_FOR_ROOT_ROTATION[index], DATA_VALUE);
+
+            //assert
+            CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        }
+        // The third insert rotates the root itself
+        CTEST_ASSERT_visual_check(handle, "2(1)(3)");
+        CTEST_ASSERT_ARE_EQUAL(size_t, 2, binary_tree_height(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_descending_root_rotate_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        static const NODE_KEY INSERT_FOR_ROOT_ROTATION[] = { 0x3, 0x2, 0x1 };
+
+        //act
+        size_t count = sizeof(INSERT_FOR_ROOT_ROTATION)/sizeof(INSERT_FOR_ROOT_ROTATION[0]);
+        for (size_t index = 0; index < count; index++)
+        {
+            int result = binary_tree_insert(handle, INSERT_FOR_ROOT_ROTATION[index], DATA_VALUE);
+
+            //assert
+            CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        }
+        CTEST_ASSERT_visual_check(handle, "2(1)(3)");
+        CTEST_ASSERT_ARE_EQUAL(size_t, 2, binary_tree_height(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_ascending_repeated_root_rotate_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        static const NODE_KEY INSERT_FOR_ROOT_ROTATION[] = { 0x1, 0x2, 0x3, 0x4, 0x5, 0x6, 0x7 };
+
+        //act
+        size_t count = sizeof(INSERT_FOR_ROOT_ROTATION)/sizeof(INSERT_FOR_ROOT_ROTATION[0]);
+        for (size_t index = 0; index < count; index++)
+        {
+            int result = binary_tree_insert(handle, INSERT_FOR_ROOT_ROTATION[index], DATA_VALUE);
+
+            //assert
+            CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        }
+        // The root rotates on the 3rd and 5th inserts
+        CTEST_ASSERT_visual_check(handle, "4(2(1)(3))(6(5)(7))");
+        CTEST_ASSERT_ARE_EQUAL(size_t, 3, binary_tree_height(handle));
+        CTEST_ASSERT_ARE_EQUAL(size_t, count, binary_tree_item_count(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
     CTEST_FUNCTION(binary_tree_find_handle_NULL_fail)
     {
         //arrange
@@ -295,7 +417,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -330,7 +452,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -350,7 +472,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -383,7 +505,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -416,7 +538,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -449,7 +571,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -474,7 +596,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         BINARY_TREE_HANDLE handle = binary_tree_create();
         const NODE_KEY REMOVE_TWO_CHILDREN_2[] = { 0xa, 0xf, 0x6, 0x3, 0xc, 0x12, 0x10 };
 
-        size_t count = sizeof(REMOVE_TWO_CHILDREN_2);
+        size_t count = sizeof(REMOVE_TWO_CHILDREN_2)/sizeof(REMOVE_TWO_CHILDREN_2[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, REMOVE_TWO_CHILDREN_2[index], DATA_VALUE);
@@ -497,7 +619,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -520,7 +642,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION_2[index], DATA_VALUE);
@@ -543,7 +665,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         const char* VISUAL_NO_ROTATION_AFTER_REMOVE = "a(5(7))(b(c))";
 
         for (size_t index = 0; index < count; index++)
@@ -566,7 +688,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         const char* VISUAL_NO_ROTATION_AFTER_REMOVE = "a(5(3))(b(c))";
 
         for (size_t index = 0; index < count; index++)
@@ -590,7 +712,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         static const char* VISUAL_NO_ROTATION_AFTER_REMOVE = "b(5(3)(7))(c)";
 
         for (size_t index = 0; index < count; index++)
@@ -614,7 +736,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         static const char* VISUAL_NO_ROTATION_AFTER_REMOVE = "b(5(3)(7))(c)";
 
         for (size_t index = 0; index < count; index++)
@@ -634,11 +756,35 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         binary_tree_destroy(handle);
     }
 
+    CTEST_FUNCTION(binary_tree_remove_root_rotate_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        static const NODE_KEY INSERT_FOR_REMOVE_ROTATION[] = { 0x5, 0x3, 0x8, 0x9 };
+        size_t count = sizeof(INSERT_FOR_REMOVE_ROTATION)/sizeof(INSERT_FOR_REMOVE_ROTATION[0]);
+        for (size_t index = 0; index < count; index++)
+        {
+            (void)binary_tree_insert(handle, INSERT_FOR_REMOVE_ROTATION[index], DATA_VALUE);
+        }
+
+        //act
+        int result = binary_tree_remove(handle, 0x3, remove_callback);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        // Removing the left leaf leaves the root right heavy, so it rotates
+        CTEST_ASSERT_visual_check(handle, "8(5)(9)");
+        CTEST_ASSERT_ARE_EQUAL(size_t, 2, binary_tree_height(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
     CTEST_FUNCTION(binary_tree_remove_item_not_found_succeed)
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
@@ -654,6 +800,622 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
         binary_tree_destroy(handle);
     }
 
+    CTEST_FUNCTION(binary_tree_insert_wide_keys_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        static size_t values[WIDE_KEY_COUNT];
+        int result = 0;
+
+        //act
+        for (size_t index = 0; index < WIDE_KEY_COUNT && result == 0; index++)
+        {
+            values[index] = index;
+            // Keys use the top bits so every one is past the old single byte range
+            result = binary_tree_insert(handle, (NODE_KEY)index << 54, &values[index]);
+        }
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, WIDE_KEY_COUNT, binary_tree_item_count(handle));
+        // An AVL tree of 1000 nodes is at most 14 levels
+        CTEST_ASSERT_IS_TRUE(binary_tree_height(handle) <= 14);
+        for (size_t index = 0; index < WIDE_KEY_COUNT; index++)
+        {
+            CTEST_ASSERT_ARE_EQUAL(void_ptr, &values[index], binary_tree_find(handle, (NODE_KEY)index << 54));
+        }
+        CTEST_ASSERT_IS_NULL(binary_tree_find(handle, 0x100));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_create_with_compare_NULL_fail)
+    {
+        //arrange
+
+        //act
+        BINARY_TREE_HANDLE result = binary_tree_create_with_compare(NULL);
+
+        //assert
+        CTEST_ASSERT_IS_NULL(result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_create_with_compare_succeed)
+    {
+        //arrange
+
+        //act
+        BINARY_TREE_HANDLE result = binary_tree_create_with_compare(compare_string_keys);
+
+        //assert
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, binary_tree_item_count(result));
+
+        //cleanup
+        binary_tree_destroy(result);
+    }
+
+    CTEST_FUNCTION(binary_tree_create_with_options_succeed)
+    {
+        //arrange
+
+        //act
+        BINARY_TREE_HANDLE result = binary_tree_create_with_options(BINARY_TREE_OPTION_NODE_POOL, 0, NULL);
+
+        //assert
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, binary_tree_item_count(result));
+
+        //cleanup
+        binary_tree_destroy(result);
+    }
+
+    CTEST_FUNCTION(binary_tree_create_with_options_capacity_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle;
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
+
+        //act
+        handle = binary_tree_create_with_options(BINARY_TREE_OPTION_NODE_POOL, count, NULL);
+        for (size_t index = 0; index < count; index++)
+        {
+            (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
+        }
+
+        //assert
+        CTEST_ASSERT_IS_NOT_NULL(handle);
+        CTEST_ASSERT_ARE_EQUAL(size_t, count, binary_tree_item_count(handle));
+        CTEST_ASSERT_visual_check(handle, VISUAL_NO_ROTATION);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_node_pool_reuse_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_options(BINARY_TREE_OPTION_NODE_POOL, 0, NULL);
+        static size_t values[WIDE_KEY_COUNT];
+        int result = 0;
+        for (size_t index = 0; index < WIDE_KEY_COUNT; index++)
+        {
+            values[index] = index;
+            (void)binary_tree_insert(handle, (NODE_KEY)index << 54, &values[index]);
+        }
+
+        //act
+        // Removed nodes go back to the pool and the inserts take them again
+        for (size_t index = 0; index < WIDE_KEY_COUNT && result == 0; index += 2)
+        {
+            result = binary_tree_remove(handle, (NODE_KEY)index << 54, remove_callback);
+        }
+        for (size_t index = 0; index < WIDE_KEY_COUNT && result == 0; index += 2)
+        {
+            result = binary_tree_insert(handle, (NODE_KEY)index << 54, &values[index]);
+        }
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, WIDE_KEY_COUNT, binary_tree_item_count(handle));
+        for (size_t index = 0; index < WIDE_KEY_COUNT; index++)
+        {
+            CTEST_ASSERT_ARE_EQUAL(void_ptr, &values[index], binary_tree_find(handle, (NODE_KEY)index << 54));
+        }
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_node_pool_compare_keys_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_options(BINARY_TREE_OPTION_NODE_POOL, 0, compare_string_keys);
+        size_t count = sizeof(STRING_KEYS)/sizeof(STRING_KEYS[0]);
+        int result = 0;
+
+        //act
+        for (size_t index = 0; index < count && result == 0; index++)
+        {
+            result = binary_tree_insert_key(handle, STRING_KEYS[index], (void*)STRING_KEYS[index]);
+        }
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, count, binary_tree_item_count(handle));
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, binary_tree_insert_key(handle, "mango", DATA_VALUE));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, STRING_KEYS[2], binary_tree_find_key(handle, "peach"));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, binary_tree_remove_key(handle, "peach", remove_callback));
+        CTEST_ASSERT_IS_NULL(binary_tree_find_key(handle, "peach"));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_key_handle_NULL_fail)
+    {
+        //arrange
+
+        //act
+        int result = binary_tree_insert_key(NULL, STRING_KEYS[0], DATA_VALUE);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_key_value_tree_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+
+        //act
+        int result = binary_tree_insert_key(handle, STRING_KEYS[0], DATA_VALUE);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, binary_tree_item_count(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_compare_tree_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_compare(compare_string_keys);
+
+        //act
+        int result = binary_tree_insert(handle, 0x4, DATA_VALUE);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, binary_tree_item_count(handle));
+        CTEST_ASSERT_IS_NULL(binary_tree_find(handle, 0x4));
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, binary_tree_remove(handle, 0x4, NULL));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_key_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_compare(compare_string_keys);
+        size_t count = sizeof(STRING_KEYS)/sizeof(STRING_KEYS[0]);
+        int result = 0;
+
+        //act
+        for (size_t index = 0; index < count && result == 0; index++)
+        {
+            result = binary_tree_insert_key(handle, STRING_KEYS[index], (void*)STRING_KEYS[index]);
+        }
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, count, binary_tree_item_count(handle));
+        CTEST_ASSERT_ARE_EQUAL(size_t, 4, binary_tree_height(handle));
+        for (size_t index = 0; index < count; index++)
+        {
+            // A different pointer with the same contents finds the item
+            char find_key[16];
+            (void)strcpy(find_key, STRING_KEYS[index]);
+            CTEST_ASSERT_ARE_EQUAL(void_ptr, STRING_KEYS[index], binary_tree_find_key(handle, find_key));
+        }
+        CTEST_ASSERT_IS_NULL(binary_tree_find_key(handle, "kiwi"));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_insert_key_duplicate_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_compare(compare_string_keys);
+        (void)binary_tree_insert_key(handle, STRING_KEYS[0], DATA_VALUE);
+
+        //act
+        int result = binary_tree_insert_key(handle, "mango", DATA_VALUE);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 1, binary_tree_item_count(handle));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_find_key_handle_NULL_fail)
+    {
+        //arrange
+
+        //act
+        void* result = binary_tree_find_key(NULL, STRING_KEYS[0]);
+
+        //assert
+        CTEST_ASSERT_IS_NULL(result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_remove_key_handle_NULL_fail)
+    {
+        //arrange
+
+        //act
+        int result = binary_tree_remove_key(NULL, STRING_KEYS[0], remove_callback);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_remove_key_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create_with_compare(compare_string_keys);
+        size_t count = sizeof(STRING_KEYS)/sizeof(STRING_KEYS[0]);
+        for (size_t index = 0; index < count; index++)
+        {
+            (void)binary_tree_insert_key(handle, STRING_KEYS[index], (void*)STRING_KEYS[index]);
+        }
+
+        //act
+        int result = binary_tree_remove_key(handle, "mango", remove_callback);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, count - 1, binary_tree_item_count(handle));
+        CTEST_ASSERT_IS_NULL(binary_tree_find_key(handle, "mango"));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, STRING_KEYS[1], binary_tree_find_key(handle, "apple"));
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, binary_tree_remove_key(handle, "mango", remove_callback));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_init_handle_NULL_fail)
+    {
+        //arrange
+        BINARY_TREE_ITERATOR iterator;
+
+        //act
+        int result = binary_tree_iterator_init(NULL, &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_init_iterator_NULL_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+
+        //act
+        int result = binary_tree_iterator_init(handle, NULL);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_next_no_items_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = binary_tree_create();
+        BINARY_TREE_ITERATOR iterator;
+
+        //act
+        int result = binary_tree_iterator_init(handle, &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_IS_NULL(binary_tree_iterator_next(handle, &iterator, NULL));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_next_in_order_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        BINARY_TREE_ITERATOR iterator;
+        NODE_KEY expected[] = { 0x3, 0x5, 0x7, 0xa, 0xb, 0xc };
+        size_t count = sizeof(expected)/sizeof(expected[0]);
+        (void)binary_tree_iterator_init(handle, &iterator);
+
+        //act
+        for (size_t index = 0; index < count; index++)
+        {
+            NODE_KEY value = 0;
+            const NODE_KEY* data = (const NODE_KEY*)binary_tree_iterator_next(handle, &iterator, &value);
+
+            //assert
+            CTEST_ASSERT_IS_NOT_NULL(data);
+            CTEST_ASSERT_IS_TRUE(expected[index] == value);
+            CTEST_ASSERT_IS_TRUE(expected[index] == *data);
+        }
+        CTEST_ASSERT_IS_NULL(binary_tree_iterator_next(handle, &iterator, NULL));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_next_compare_tree_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_string_tree();
+        BINARY_TREE_ITERATOR iterator;
+        (void)binary_tree_iterator_init(handle, &iterator);
+
+        //act
+        void* result = binary_tree_iterator_next(handle, &iterator, NULL);
+
+        //assert
+        CTEST_ASSERT_IS_NULL(result);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_iterator_next_key_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_string_tree();
+        BINARY_TREE_ITERATOR iterator;
+        const char* expected[] = { "apple", "banana", "cherry", "grape", "lemon", "mango", "peach" };
+        size_t count = sizeof(expected)/sizeof(expected[0]);
+        (void)binary_tree_iterator_init(handle, &iterator);
+
+        //act
+        for (size_t index = 0; index < count; index++)
+        {
+            const void* key = NULL;
+            const char* data = (const char*)binary_tree_iterator_next_key(handle, &iterator, &key);
+
+            //assert
+            CTEST_ASSERT_ARE_EQUAL(char_ptr, expected[index], data);
+            CTEST_ASSERT_ARE_EQUAL(char_ptr, expected[index], (const char*)key);
+        }
+        CTEST_ASSERT_IS_NULL(binary_tree_iterator_next_key(handle, &iterator, NULL));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_lower_bound_handle_NULL_fail)
+    {
+        //arrange
+        BINARY_TREE_ITERATOR iterator;
+
+        //act
+        int result = binary_tree_lower_bound(NULL, 0x5, &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_lower_bound_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        BINARY_TREE_ITERATOR iterator;
+        NODE_KEY value = 0;
+
+        //act
+        int result = binary_tree_lower_bound(handle, 0x6, &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_IS_NOT_NULL(binary_tree_iterator_next(handle, &iterator, &value));
+        CTEST_ASSERT_IS_TRUE(0x7 == value);
+        CTEST_ASSERT_IS_NOT_NULL(binary_tree_iterator_next(handle, &iterator, &value));
+        CTEST_ASSERT_IS_TRUE(0xa == value);
+
+        // An exact match starts at the key itself
+        (void)binary_tree_lower_bound(handle, 0xb, &iterator);
+        CTEST_ASSERT_IS_NOT_NULL(binary_tree_iterator_next(handle, &iterator, &value));
+        CTEST_ASSERT_IS_TRUE(0xb == value);
+
+        // Past the largest key the walk is already over
+        (void)binary_tree_lower_bound(handle, 0xd, &iterator);
+        CTEST_ASSERT_IS_NULL(binary_tree_iterator_next(handle, &iterator, &value));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_lower_bound_compare_tree_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_string_tree();
+        BINARY_TREE_ITERATOR iterator;
+
+        //act
+        int result = binary_tree_lower_bound(handle, 0x5, &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_lower_bound_key_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_string_tree();
+        BINARY_TREE_ITERATOR iterator;
+
+        //act
+        int result = binary_tree_lower_bound_key(handle, "date", &iterator);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, "grape", (const char*)binary_tree_iterator_next_key(handle, &iterator, NULL));
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, "lemon", (const char*)binary_tree_iterator_next_key(handle, &iterator, NULL));
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_handle_NULL_fail)
+    {
+        //arrange
+        VISIT_RESULT visit_result = { 0 };
+
+        //act
+        int result = binary_tree_range_for_each(NULL, 0x5, 0xb, visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, visit_result.count);
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_visit_NULL_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+
+        //act
+        int result = binary_tree_range_for_each(handle, 0x5, 0xb, NULL, NULL);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        VISIT_RESULT visit_result = { 0 };
+
+        //act
+        int result = binary_tree_range_for_each(handle, 0x5, 0xb, visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        // The end of the range is exclusive
+        CTEST_ASSERT_ARE_EQUAL(size_t, 3, visit_result.count);
+        CTEST_ASSERT_IS_TRUE(0x5 == *(const NODE_KEY*)visit_result.items[0]);
+        CTEST_ASSERT_IS_TRUE(0x7 == *(const NODE_KEY*)visit_result.items[1]);
+        CTEST_ASSERT_IS_TRUE(0xa == *(const NODE_KEY*)visit_result.items[2]);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_empty_range_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        VISIT_RESULT visit_result = { 0 };
+
+        //act
+        int result = binary_tree_range_for_each(handle, 0x8, 0xa, visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, visit_result.count);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_stop_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        VISIT_RESULT visit_result = { 0 };
+        visit_result.stop_after = 2;
+
+        //act
+        int result = binary_tree_range_for_each(handle, 0x0, 0xff, visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 2, visit_result.count);
+        CTEST_ASSERT_IS_TRUE(0x3 == *(const NODE_KEY*)visit_result.items[0]);
+        CTEST_ASSERT_IS_TRUE(0x5 == *(const NODE_KEY*)visit_result.items[1]);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_key_succeed)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_string_tree();
+        VISIT_RESULT visit_result = { 0 };
+
+        //act
+        int result = binary_tree_range_for_each_key(handle, "banana", "lemon", visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 3, visit_result.count);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, "banana", (const char*)visit_result.items[0]);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, "cherry", (const char*)visit_result.items[1]);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, "grape", (const char*)visit_result.items[2]);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
+    CTEST_FUNCTION(binary_tree_range_for_each_key_value_tree_fail)
+    {
+        //arrange
+        BINARY_TREE_HANDLE handle = create_value_tree();
+        VISIT_RESULT visit_result = { 0 };
+
+        //act
+        int result = binary_tree_range_for_each_key(handle, "banana", "lemon", visit_item, &visit_result);
+
+        //assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, visit_result.count);
+
+        //cleanup
+        binary_tree_destroy(handle);
+    }
+
     CTEST_FUNCTION(binary_tree_construct_visual_handle_NULL_fail)
     {
         //arrange
@@ -688,7 +1450,7 @@ static void CTEST_ASSERT_visual_check(BINARY_TREE_HANDLE handle, const char* exp
     {
         //arrange
         BINARY_TREE_HANDLE handle = binary_tree_create();
-        size_t count = sizeof(INSERT_FOR_NO_ROTATION);
+        size_t count = sizeof(INSERT_FOR_NO_ROTATION)/sizeof(INSERT_FOR_NO_ROTATION[0]);
         for (size_t index = 0; index < count; index++)
         {
             (void)binary_tree_insert(handle, INSERT_FOR_NO_ROTATION[index], DATA_VALUE);
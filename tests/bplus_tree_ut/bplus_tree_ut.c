@@ -0,0 +1,789 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mem_shim_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+
+MOCKABLE_FUNCTION(, void, item_destroy_callback, void*, user_ctx, void*, item);
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/bplus_tree.h"
+
+// One more than a node holds so the leaf splits
+#define TEST_NODE_KEYS          16
+#define TEST_SPLIT_COUNT        (TEST_NODE_KEYS + 1)
+#define TEST_LARGE_COUNT        5000
+
+static int TEST_ITEM_1 = 1;
+static int TEST_ITEM_2 = 2;
+static int TEST_ITEM_3 = 3;
+
+static size_t g_values[TEST_LARGE_COUNT];
+static uint64_t g_keys[TEST_LARGE_COUNT];
+static void* g_value_ptrs[TEST_LARGE_COUNT];
+
+static void my_item_destroy_cb(void* user_ctx, void* item)
+{
+    (void)user_ctx;
+    (void)item;
+}
+
+// Keys are spaced out by 10 so every gap has room for bound lookups
+static void setup_test_keys(size_t count)
+{
+    for (size_t index = 0; index < count; index++)
+    {
+        g_keys[index] = (index + 1)*10;
+        g_values[index] = index;
+        g_value_ptrs[index] = &g_values[index];
+    }
+}
+
+// Inserts the keys in a scattered order, 7919 is prime so every index is hit once
+static void insert_test_keys(BPLUS_TREE_HANDLE handle, size_t count)
+{
+    setup_test_keys(count);
+    for (size_t index = 0; index < count; index++)
+    {
+        size_t key_index = (index*7919) % count;
+        (void)bplus_tree_insert(handle, g_keys[key_index], g_value_ptrs[key_index]);
+    }
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(bplus_tree_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    REGISTER_UMOCK_ALIAS_TYPE(BPLUS_TREE_HANDLE, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(item_destroy_callback, my_item_destroy_cb);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_realloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(bplus_tree_create_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = bplus_tree_create(item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_item_count(result));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_height(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(result);
+}
+
+CTEST_FUNCTION(bplus_tree_create_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    result = bplus_tree_create(item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    bplus_tree_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_destroy_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    (void)bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+    (void)bplus_tree_insert(handle, 2, &TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(NULL, &TEST_ITEM_1));
+    STRICT_EXPECTED_CALL(item_destroy_callback(NULL, &TEST_ITEM_2));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    bplus_tree_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_insert_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = bplus_tree_insert(NULL, 1, &TEST_ITEM_1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_insert_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_height(handle));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, bplus_tree_find(handle, 1));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_insert_duplicate_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    (void)bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_insert(handle, 1, &TEST_ITEM_2);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, bplus_tree_find(handle, 1));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_insert_split_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    setup_test_keys(TEST_SPLIT_COUNT);
+    for (size_t index = 0; index < TEST_NODE_KEYS; index++)
+    {
+        (void)bplus_tree_insert(handle, g_keys[index], g_value_ptrs[index]);
+    }
+    umock_c_reset_all_calls();
+
+    // The full leaf splits and the tree grows a new root
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = bplus_tree_insert(handle, g_keys[TEST_NODE_KEYS], g_value_ptrs[TEST_NODE_KEYS]);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_SPLIT_COUNT, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, bplus_tree_height(handle));
+    for (size_t index = 0; index < TEST_SPLIT_COUNT; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[index], bplus_tree_find(handle, g_keys[index]));
+    }
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_insert_split_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    setup_test_keys(TEST_SPLIT_COUNT);
+    for (size_t index = 0; index < TEST_NODE_KEYS; index++)
+    {
+        (void)bplus_tree_insert(handle, g_keys[index], g_value_ptrs[index]);
+    }
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
+
+        // act
+        int result = bplus_tree_insert(handle, g_keys[TEST_NODE_KEYS], g_value_ptrs[TEST_NODE_KEYS]);
+
+        // assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, TEST_NODE_KEYS, bplus_tree_item_count(handle));
+        CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_height(handle));
+        CTEST_ASSERT_IS_NULL(bplus_tree_find(handle, g_keys[TEST_NODE_KEYS]));
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_insert_many_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+
+    // act
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_LARGE_COUNT, bplus_tree_item_count(handle));
+    // Half full nodes still fit 5000 keys in 4 levels
+    CTEST_ASSERT_IS_TRUE(bplus_tree_height(handle) <= 4);
+    for (size_t index = 0; index < TEST_LARGE_COUNT; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[index], bplus_tree_find(handle, g_keys[index]));
+    }
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_find_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    void* result = bplus_tree_find(NULL, 1);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_find_not_found_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    insert_test_keys(handle, TEST_SPLIT_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = bplus_tree_find(handle, g_keys[3] + 1);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_remove_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = bplus_tree_remove(NULL, 1, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_remove_not_found_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    (void)bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_remove(handle, 2, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_remove_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    void* value = NULL;
+    (void)bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+    (void)bplus_tree_insert(handle, 2, &TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_remove(handle, 1, &value);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, value);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_item_count(handle));
+    CTEST_ASSERT_IS_NULL(bplus_tree_find(handle, 1));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_2, bplus_tree_find(handle, 2));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_remove_last_item_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    (void)bplus_tree_insert(handle, 1, &TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = bplus_tree_remove(handle, 1, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_height(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_remove_all_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+
+    // act
+    // Removing in a different scattered order drives the borrows and merges
+    for (size_t index = 0; index < TEST_LARGE_COUNT; index++)
+    {
+        size_t key_index = (index*4001) % TEST_LARGE_COUNT;
+        void* value = NULL;
+        CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_remove(handle, g_keys[key_index], &value));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[key_index], value);
+        CTEST_ASSERT_IS_NULL(bplus_tree_find(handle, g_keys[key_index]));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_height(handle));
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_lower_bound_iterator_NULL_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_lower_bound(handle, 1, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_lower_bound_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    BPLUS_TREE_ITERATOR iterator;
+    uint64_t key = 0;
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_lower_bound(handle, g_keys[100], &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_iterator_next(handle, &iterator, &key, NULL));
+    CTEST_ASSERT_IS_TRUE(key == g_keys[100]);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_lower_bound(handle, g_keys[100] + 1, &iterator));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_iterator_next(handle, &iterator, &key, NULL));
+    CTEST_ASSERT_IS_TRUE(key == g_keys[101]);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_upper_bound_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    BPLUS_TREE_ITERATOR iterator;
+    uint64_t key = 0;
+    void* value = NULL;
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_upper_bound(handle, g_keys[100], &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_iterator_next(handle, &iterator, &key, &value));
+    CTEST_ASSERT_IS_TRUE(key == g_keys[101]);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[101], value);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_upper_bound_past_end_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    BPLUS_TREE_ITERATOR iterator;
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_upper_bound(handle, g_keys[TEST_LARGE_COUNT - 1], &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, bplus_tree_iterator_next(handle, &iterator, NULL, NULL));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_iterator_next_handle_NULL_fail)
+{
+    // arrange
+    BPLUS_TREE_ITERATOR iterator = { NULL, 0 };
+
+    // act
+    int result = bplus_tree_iterator_next(NULL, &iterator, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_iterator_next_range_scan_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    BPLUS_TREE_ITERATOR iterator;
+    uint64_t key;
+    void* value;
+    size_t index = 1000;
+    insert_test_keys(handle, TEST_LARGE_COUNT);
+    (void)bplus_tree_lower_bound(handle, g_keys[index] - 5, &iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    // The scan walks the leaf links across many leaves
+    while (bplus_tree_iterator_next(handle, &iterator, &key, &value) == 0 && key < g_keys[2000])
+    {
+        CTEST_ASSERT_IS_TRUE(key == g_keys[index]);
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[index], value);
+        index++;
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2000, index);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_handle_NULL_fail)
+{
+    // arrange
+    setup_test_keys(TEST_SPLIT_COUNT);
+
+    // act
+    int result = bplus_tree_bulk_load(NULL, g_keys, g_value_ptrs, TEST_SPLIT_COUNT);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    BPLUS_TREE_ITERATOR iterator;
+    uint64_t key;
+    size_t index = 0;
+    setup_test_keys(TEST_LARGE_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_bulk_load(handle, g_keys, g_value_ptrs, TEST_LARGE_COUNT);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_LARGE_COUNT, bplus_tree_item_count(handle));
+    // Full nodes fit 5000 keys in 313 leaves under 3 inner levels
+    CTEST_ASSERT_ARE_EQUAL(size_t, 4, bplus_tree_height(handle));
+    (void)bplus_tree_lower_bound(handle, 0, &iterator);
+    while (bplus_tree_iterator_next(handle, &iterator, &key, NULL) == 0)
+    {
+        CTEST_ASSERT_IS_TRUE(key == g_keys[index]);
+        index++;
+    }
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_LARGE_COUNT, index);
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_then_insert_succeed)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    setup_test_keys(TEST_LARGE_COUNT);
+    (void)bplus_tree_bulk_load(handle, g_keys, g_value_ptrs, TEST_LARGE_COUNT);
+    umock_c_reset_all_calls();
+
+    // act
+    for (size_t index = 0; index < TEST_LARGE_COUNT; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, bplus_tree_insert(handle, g_keys[index] + 1, &TEST_ITEM_3));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_LARGE_COUNT*2, bplus_tree_item_count(handle));
+    for (size_t index = 0; index < TEST_LARGE_COUNT; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, g_value_ptrs[index], bplus_tree_find(handle, g_keys[index]));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_3, bplus_tree_find(handle, g_keys[index] + 1));
+    }
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_unsorted_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    uint64_t keys[] = { 10, 30, 20 };
+    void* values[] = { &TEST_ITEM_1, &TEST_ITEM_3, &TEST_ITEM_2 };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_bulk_load(handle, keys, values, sizeof(keys)/sizeof(keys[0]));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_not_empty_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(NULL, NULL);
+    uint64_t keys[] = { 10, 20, 30 };
+    void* values[] = { &TEST_ITEM_1, &TEST_ITEM_2, &TEST_ITEM_3 };
+    (void)bplus_tree_insert(handle, 5, &TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = bplus_tree_bulk_load(handle, keys, values, sizeof(keys)/sizeof(keys[0]));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, bplus_tree_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_bulk_load_fail)
+{
+    // arrange
+    BPLUS_TREE_HANDLE handle = bplus_tree_create(item_destroy_callback, NULL);
+    setup_test_keys(TEST_SPLIT_COUNT);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    // Level arrays, two leaves and their root
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
+
+        // act
+        int result = bplus_tree_bulk_load(handle, g_keys, g_value_ptrs, TEST_SPLIT_COUNT);
+
+        // assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_item_count(handle));
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, bplus_tree_height(handle));
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+    bplus_tree_destroy(handle);
+}
+
+CTEST_FUNCTION(bplus_tree_item_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = bplus_tree_item_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(bplus_tree_height_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = bplus_tree_height(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_END_TEST_SUITE(bplus_tree_ut)
@@ -3,9 +3,11 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <string.h>
 #endif
 
 #include "ctest.h"
@@ -40,6 +42,16 @@ MOCKABLE_FUNCTION(, void, item_destroy_callback, void*, user_ctx, void*, item);
 #include "lib-util-c/buffer_alloc.h"
 
 #define DEFAULT_ALLOC_SIZE       64
+#define INLINE_CAPACITY          (BUFFER_INLINE_SIZE-1)
+// Past the inline capacity so the payload goes to the heap
+#define LONG_LENGTH              80
+
+static const char* make_long_string(char* target, char fill)
+{
+    memset(target, fill, LONG_LENGTH);
+    target[LONG_LENGTH] = '\0';
+    return target;
+}
 
 MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
 
@@ -111,14 +123,36 @@ CTEST_FUNCTION(string_buffer_construct_succeed)
     STRING_BUFFER buffer = { 0 };
     const char* src_string = "test_string";
 
-    STRICT_EXPECTED_CALL(malloc(11+DEFAULT_ALLOC_SIZE+1));
-
     // act
     int result = string_buffer_construct(&buffer, src_string);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_construct_long_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char long_string[LONG_LENGTH+1];
+    make_long_string(long_string, 'a');
+
+    STRICT_EXPECTED_CALL(malloc(LONG_LENGTH+DEFAULT_ALLOC_SIZE+1));
+
+    // act
+    int result = string_buffer_construct(&buffer, long_string);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, long_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH+DEFAULT_ALLOC_SIZE, buffer.alloc_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -142,6 +176,7 @@ CTEST_FUNCTION(string_buffer_construct_append_string_succeed)
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -159,8 +194,8 @@ CTEST_FUNCTION(string_buffer_construct_alloc_append_succeed)
     (void)string_buffer_construct(&buffer, src_string);
     umock_c_reset_all_calls();
 
-    //size_t realloc_len = strlen(second_string);
-    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG));
+    // Spills out of the inline storage
+    STRICT_EXPECTED_CALL(malloc(INLINE_CAPACITY*2+1));
 
     // act
     int result = string_buffer_construct(&buffer, second_string);
@@ -168,6 +203,7 @@ CTEST_FUNCTION(string_buffer_construct_alloc_append_succeed)
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -178,12 +214,13 @@ CTEST_FUNCTION(string_buffer_construct_malloc_fail)
 {
     // arrange
     STRING_BUFFER buffer = { 0 };
-    const char* src_string = "test_string";
+    char long_string[LONG_LENGTH+1];
+    make_long_string(long_string, 'a');
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
 
     // act
-    int result = string_buffer_construct(&buffer, src_string);
+    int result = string_buffer_construct(&buffer, long_string);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
@@ -232,14 +269,13 @@ CTEST_FUNCTION(string_buffer_construct_sprintf_succeed)
     const char* total_string = "test_string_123";
     int value = 123;
 
-    STRICT_EXPECTED_CALL(malloc(15+DEFAULT_ALLOC_SIZE+1));
-
     // act
     int result = string_buffer_construct_sprintf(&buffer, fmt_string, value);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -250,7 +286,7 @@ CTEST_FUNCTION(string_buffer_construct_sprintf_malloc_fail)
 {
     // arrange
     STRING_BUFFER buffer = { 0 };
-    const char* fmt_string = "test_string_%d";
+    const char* fmt_string = "test_string_%080d";
     int value = 123;
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
@@ -283,6 +319,7 @@ CTEST_FUNCTION(string_buffer_construct_sprintf_append_string_succeed)
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
@@ -302,30 +339,90 @@ CTEST_FUNCTION(string_buffer_free_buffer_NULL_fail)
     // cleanup
 }
 
-CTEST_FUNCTION(byte_buffer_construct_buffer_NULL_fail)
+CTEST_FUNCTION(string_buffer_construct_fill_capacity_no_realloc_succeed)
 {
     // arrange
-    const unsigned char binary_string[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
-    size_t bin_length = 5;
+    STRING_BUFFER buffer = { 0 };
+    char fill_string[INLINE_CAPACITY];
+    memset(fill_string, 'b', INLINE_CAPACITY-1);
+    fill_string[INLINE_CAPACITY-1] = '\0';
+
+    (void)string_buffer_construct(&buffer, "a");
+    umock_c_reset_all_calls();
 
     // act
-    int result = byte_buffer_construct(NULL, binary_string, bin_length);
+    int result = string_buffer_construct(&buffer, fill_string);
 
     // assert
-    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, strlen(buffer.payload));
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    string_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_construct_value_NULL_succeed)
+CTEST_FUNCTION(string_buffer_construct_growth_percent_succeed)
 {
     // arrange
-    BYTE_BUFFER buffer = { 0 };
-    size_t bin_length = 5;
+    STRING_BUFFER buffer = { 0 };
+    buffer.growth_percent = 50;
+    const char* src_string = "test_string";
+    char long_string[81];
+    memset(long_string, 'c', 80);
+    long_string[80] = '\0';
+
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(INLINE_CAPACITY*3/2+1));
 
     // act
-    int result = byte_buffer_construct(&buffer, NULL, bin_length);
+    int result = string_buffer_construct(&buffer, long_string);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY*3/2, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, strncmp(buffer.payload, src_string, 11));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, long_string, buffer.payload+11);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_construct_after_free_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* src_string = "test_string";
+
+    char long_string[LONG_LENGTH+1];
+
+    (void)string_buffer_construct(&buffer, make_long_string(long_string, 'a'));
+    string_buffer_free(&buffer);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = string_buffer_construct(&buffer, src_string);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_append_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = string_buffer_append(NULL, "test", 4);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
@@ -334,14 +431,13 @@ CTEST_FUNCTION(byte_buffer_construct_value_NULL_succeed)
     // cleanup
 }
 
-CTEST_FUNCTION(byte_buffer_construct_size_0_succeed)
+CTEST_FUNCTION(string_buffer_append_value_NULL_fail)
 {
     // arrange
-    BYTE_BUFFER buffer = { 0 };
-    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+    STRING_BUFFER buffer = { 0 };
 
     // act
-    int result = byte_buffer_construct(&buffer, binary_buff, 0);
+    int result = string_buffer_append(&buffer, NULL, 4);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
@@ -350,134 +446,937 @@ CTEST_FUNCTION(byte_buffer_construct_size_0_succeed)
     // cleanup
 }
 
-CTEST_FUNCTION(byte_buffer_construct_succeed)
+CTEST_FUNCTION(string_buffer_append_succeed)
 {
     // arrange
-    BYTE_BUFFER buffer = { 0 };
-    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
-    size_t bin_length = 5;
+    STRING_BUFFER buffer = { 0 };
+    // Only the first 4 characters get appended, no terminator is needed
+    const char* src_string = "test_string";
+
+    // act
+    int result = string_buffer_append(&buffer, src_string, 4);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "test", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 4, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
 
-    STRICT_EXPECTED_CALL(malloc(bin_length+DEFAULT_ALLOC_SIZE+1));
+CTEST_FUNCTION(string_buffer_append_sprintf_mixed_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* total_string = "test_string_123_end";
 
     // act
-    int result = byte_buffer_construct(&buffer, binary_buff, bin_length);
+    int result = string_buffer_append(&buffer, "test", 4);
+    result += string_buffer_construct_sprintf(&buffer, "_string_%d", 123);
+    result += string_buffer_construct(&buffer, "_end");
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
-    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_append_realloc_fail)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char src_string[LONG_LENGTH+1];
+    char long_string[LONG_LENGTH+1];
+    make_long_string(src_string, 'a');
+    make_long_string(long_string, 'e');
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = string_buffer_append(&buffer, long_string, LONG_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH, buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    byte_buffer_free(&buffer);
+    string_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_construct_malloc_fail)
+CTEST_FUNCTION(string_buffer_append_spill_malloc_fail)
 {
     // arrange
-    BYTE_BUFFER buffer = { 0 };
-    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
-    size_t bin_length = 5;
+    STRING_BUFFER buffer = { 0 };
+    const char* src_string = "test_string";
+    char long_string[LONG_LENGTH+1];
+    make_long_string(long_string, 'e');
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
 
     STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
 
     // act
-    int result = byte_buffer_construct(&buffer, binary_buff, bin_length);
+    int result = string_buffer_append(&buffer, long_string, LONG_LENGTH);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 11, buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    string_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_construct_append_binary_succeed)
+CTEST_FUNCTION(string_buffer_insert_buffer_NULL_fail)
 {
     // arrange
-    size_t bin_length = 64;
-    size_t init_length = 4;
-    BYTE_BUFFER buffer = { 0 };
-    unsigned char initial_buff[68];
-    for (size_t index = 0; index < bin_length+init_length; index++)
-    {
-        initial_buff[index] = (unsigned char)(0x25 + index);
-    }
 
-    (void)byte_buffer_construct(&buffer, initial_buff, init_length);
+    // act
+    int result = string_buffer_insert(NULL, 0, "test", 4);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(string_buffer_insert_position_past_end_fail)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    (void)string_buffer_construct(&buffer, "test");
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, bin_length+bin_length+init_length+DEFAULT_ALLOC_SIZE+1));
+    // act
+    int result = string_buffer_insert(&buffer, 5, "_string", 7);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "test", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_insert_middle_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* total_string = "test_string";
+    (void)string_buffer_construct(&buffer, "tstring");
+    umock_c_reset_all_calls();
 
     // act
-    int result = byte_buffer_construct(&buffer, initial_buff+init_length, bin_length);
+    int result = string_buffer_insert(&buffer, 1, "est_", 4);
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
-    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, initial_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    byte_buffer_free(&buffer);
+    string_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_construct_append_binary_realloc_fail)
+CTEST_FUNCTION(string_buffer_insert_front_and_end_succeed)
 {
     // arrange
-    size_t bin_length = 64;
-    size_t init_length = 4;
-    BYTE_BUFFER buffer = { 0 };
-    unsigned char initial_buff[68];
-    for (size_t index = 0; index < bin_length+init_length; index++)
-    {
-        initial_buff[index] = (unsigned char)(0x25 + index);
-    }
+    STRING_BUFFER buffer = { 0 };
+    const char* total_string = "test_string";
+    (void)string_buffer_construct(&buffer, "_str");
 
-    (void)byte_buffer_construct(&buffer, initial_buff, init_length);
-    umock_c_reset_all_calls();
+    // act
+    int result = string_buffer_insert(&buffer, 0, "test", 4);
+    result += string_buffer_insert(&buffer, buffer.payload_size, "ing", 3);
 
-    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, total_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, strlen(total_string), buffer.payload_size);
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_insert_empty_buffer_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
 
     // act
-    int result = byte_buffer_construct(&buffer, initial_buff+init_length, bin_length);
+    int result = string_buffer_insert(&buffer, 0, "test", 4);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "test", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 4, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_truncate_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = string_buffer_truncate(NULL, 0);
 
     // assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    byte_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_free_succeed)
+CTEST_FUNCTION(string_buffer_truncate_past_end_fail)
 {
     // arrange
-    BYTE_BUFFER buffer = { 0 };
-    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
-    size_t bin_length = 5;
-    (void)byte_buffer_construct(&buffer, binary_buff, bin_length);
+    STRING_BUFFER buffer = { 0 };
+    (void)string_buffer_construct(&buffer, "test");
     umock_c_reset_all_calls();
 
-    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    // act
+    int result = string_buffer_truncate(&buffer, 5);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "test", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 4, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_truncate_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    (void)string_buffer_construct(&buffer, "test_string");
+    umock_c_reset_all_calls();
 
     // act
-    byte_buffer_free(&buffer);
+    int result = string_buffer_truncate(&buffer, 4);
+    result += string_buffer_construct(&buffer, "ing");
 
     // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "testing", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 7, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    string_buffer_free(&buffer);
 }
 
-CTEST_FUNCTION(byte_buffer_free_buffer_NULL_fail)
+CTEST_FUNCTION(string_buffer_truncate_shrink_to_fit_succeed)
 {
     // arrange
+    STRING_BUFFER buffer = { 0 };
+    char long_string[LONG_LENGTH+1];
+    (void)string_buffer_construct(&buffer, make_long_string(long_string, 't'));
+    (void)string_buffer_truncate(&buffer, 4);
+    umock_c_reset_all_calls();
+
+    // Short enough to move back into the struct
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     // act
-    byte_buffer_free(NULL);
+    int result = string_buffer_shrink_to_fit(&buffer);
 
     // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "tttt", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_free_inline_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    (void)string_buffer_construct(&buffer, "test_string");
+    umock_c_reset_all_calls();
+
+    // act
+    string_buffer_free(&buffer);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(string_buffer_free_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char long_string[LONG_LENGTH+1];
+    (void)string_buffer_construct(&buffer, make_long_string(long_string, 'a'));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    string_buffer_free(&buffer);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(string_buffer_reserve_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = string_buffer_reserve(NULL, 128);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(string_buffer_reserve_empty_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+
+    STRICT_EXPECTED_CALL(malloc(128+1));
+
+    // act
+    int result = string_buffer_reserve(&buffer, 128);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 128, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_reserve_then_construct_no_realloc_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char long_string[128+1];
+    memset(long_string, 'd', 128);
+    long_string[128] = '\0';
+
+    (void)string_buffer_reserve(&buffer, 128);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = string_buffer_construct(&buffer, long_string);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, long_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_reserve_smaller_no_change_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* src_string = "test_string";
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = string_buffer_reserve(&buffer, 4);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_reserve_realloc_fail)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char src_string[LONG_LENGTH+1];
+    (void)string_buffer_construct(&buffer, make_long_string(src_string, 'a'));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, 256+1)).SetReturn(NULL);
+
+    // act
+    int result = string_buffer_reserve(&buffer, 256);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH+DEFAULT_ALLOC_SIZE, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_reserve_inline_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+
+    // act
+    int result = string_buffer_reserve(&buffer, 32);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, "", buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_reserve_spill_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* src_string = "test_string";
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(128+1));
+
+    // act
+    int result = string_buffer_reserve(&buffer, 128);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 11, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_shrink_to_fit_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = string_buffer_shrink_to_fit(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(string_buffer_shrink_to_fit_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    char src_string[LONG_LENGTH+1];
+    (void)string_buffer_construct(&buffer, make_long_string(src_string, 'a'));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, LONG_LENGTH+1));
+
+    // act
+    int result = string_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_shrink_to_fit_inline_no_change_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+    const char* src_string = "test_string";
+    (void)string_buffer_construct(&buffer, src_string);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = string_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, src_string, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    string_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(string_buffer_shrink_to_fit_empty_succeed)
+{
+    // arrange
+    STRING_BUFFER buffer = { 0 };
+
+    // act
+    int result = string_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_construct_buffer_NULL_fail)
+{
+    // arrange
+    const unsigned char binary_string[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+    size_t bin_length = 5;
+
+    // act
+    int result = byte_buffer_construct(NULL, binary_string, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_construct_value_NULL_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    size_t bin_length = 5;
+
+    // act
+    int result = byte_buffer_construct(&buffer, NULL, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_construct_size_0_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+
+    // act
+    int result = byte_buffer_construct(&buffer, binary_buff, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_construct_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+    size_t bin_length = 5;
+
+    // act
+    int result = byte_buffer_construct(&buffer, binary_buff, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_construct_long_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[LONG_LENGTH];
+    memset(binary_buff, 0x21, sizeof(binary_buff));
+
+    STRICT_EXPECTED_CALL(malloc(LONG_LENGTH+DEFAULT_ALLOC_SIZE+1));
+
+    // act
+    int result = byte_buffer_construct(&buffer, binary_buff, LONG_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_construct_malloc_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[LONG_LENGTH];
+    memset(binary_buff, 0x21, sizeof(binary_buff));
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = byte_buffer_construct(&buffer, binary_buff, LONG_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_construct_append_binary_succeed)
+{
+    // arrange
+    size_t bin_length = 96;
+    size_t init_length = LONG_LENGTH;
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char initial_buff[LONG_LENGTH+96];
+    for (size_t index = 0; index < bin_length+init_length; index++)
+    {
+        initial_buff[index] = (unsigned char)(0x25 + index);
+    }
+
+    (void)byte_buffer_construct(&buffer, initial_buff, init_length);
+    umock_c_reset_all_calls();
+
+    // The full buffer doubles
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, (init_length+DEFAULT_ALLOC_SIZE)*2+1));
+
+    // act
+    int result = byte_buffer_construct(&buffer, initial_buff+init_length, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, bin_length+init_length, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, (init_length+DEFAULT_ALLOC_SIZE)*2, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, initial_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_construct_append_binary_realloc_fail)
+{
+    // arrange
+    size_t bin_length = 96;
+    size_t init_length = LONG_LENGTH;
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char initial_buff[LONG_LENGTH+96];
+    for (size_t index = 0; index < bin_length+init_length; index++)
+    {
+        initial_buff[index] = (unsigned char)(0x25 + index);
+    }
+
+    (void)byte_buffer_construct(&buffer, initial_buff, init_length);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = byte_buffer_construct(&buffer, initial_buff+init_length, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, init_length, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, initial_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_construct_spill_from_inline_succeed)
+{
+    // arrange
+    size_t bin_length = 96;
+    size_t init_length = 4;
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char initial_buff[100];
+    for (size_t index = 0; index < bin_length+init_length; index++)
+    {
+        initial_buff[index] = (unsigned char)(0x25 + index);
+    }
+
+    (void)byte_buffer_construct(&buffer, initial_buff, init_length);
+    umock_c_reset_all_calls();
+
+    // The inline capacity doubles onto the heap
+    STRICT_EXPECTED_CALL(malloc(INLINE_CAPACITY*2+1));
+
+    // act
+    int result = byte_buffer_construct(&buffer, initial_buff+init_length, bin_length);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, bin_length+init_length, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, INLINE_CAPACITY*2, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, initial_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_free_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[LONG_LENGTH];
+    memset(binary_buff, 0x21, sizeof(binary_buff));
+    (void)byte_buffer_construct(&buffer, binary_buff, LONG_LENGTH);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    byte_buffer_free(&buffer);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_free_inline_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+    size_t bin_length = 5;
+    (void)byte_buffer_construct(&buffer, binary_buff, bin_length);
+    umock_c_reset_all_calls();
+
+    // act
+    byte_buffer_free(&buffer);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_free_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    byte_buffer_free(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_reserve_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = byte_buffer_reserve(NULL, 128);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_reserve_then_construct_no_realloc_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[256];
+    for (size_t index = 0; index < sizeof(binary_buff); index++)
+    {
+        binary_buff[index] = (unsigned char)index;
+    }
+
+    STRICT_EXPECTED_CALL(malloc(sizeof(binary_buff)+1));
+
+    // act
+    int result = byte_buffer_reserve(&buffer, sizeof(binary_buff));
+    for (size_t index = 0; index < sizeof(binary_buff); index += 16)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, byte_buffer_construct(&buffer, binary_buff+index, 16));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(binary_buff), buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(binary_buff), buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, buffer.payload_size));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_reserve_malloc_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = byte_buffer_reserve(&buffer, 128);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_shrink_to_fit_buffer_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = byte_buffer_shrink_to_fit(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(byte_buffer_shrink_to_fit_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[LONG_LENGTH];
+    size_t bin_length = LONG_LENGTH;
+    memset(binary_buff, 0x21, sizeof(binary_buff));
+    (void)byte_buffer_construct(&buffer, binary_buff, bin_length);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, bin_length+1));
+
+    // act
+    int result = byte_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, bin_length, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, bin_length));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_shrink_to_fit_realloc_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char binary_buff[LONG_LENGTH];
+    size_t bin_length = LONG_LENGTH;
+    memset(binary_buff, 0x21, sizeof(binary_buff));
+    (void)byte_buffer_construct(&buffer, binary_buff, bin_length);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = byte_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, bin_length+DEFAULT_ALLOC_SIZE, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, bin_length));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+}
+
+CTEST_FUNCTION(byte_buffer_shrink_to_fit_inline_no_change_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    const unsigned char binary_buff[] = { 0x21, 0x22, 0x23, 0x24, 0x25, 0x26 };
+    size_t bin_length = 5;
+    (void)byte_buffer_construct(&buffer, binary_buff, bin_length);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = byte_buffer_shrink_to_fit(&buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, buffer.inline_payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, binary_buff, bin_length));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
 }
 
 CTEST_END_TEST_SUITE(buffer_alloc_ut)
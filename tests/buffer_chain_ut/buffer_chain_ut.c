@@ -0,0 +1,875 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#ifndef WIN32
+#include <sys/uio.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mem_shim_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+
+MOCKABLE_FUNCTION(, void, segment_release_callback, void*, release_ctx, const unsigned char*, data, size_t, length);
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/buffer_chain.h"
+
+#define TEST_HEADER_LENGTH      8
+#define TEST_PAYLOAD_LENGTH     256
+#define TEST_TRAILER_LENGTH     4
+// Past the inline capacity so the byte buffer payload is on the heap
+#define LONG_LENGTH             80
+
+static const unsigned char TEST_HEADER[TEST_HEADER_LENGTH] = { 'H', 'E', 'A', 'D', 'E', 'R', '0', '1' };
+static const unsigned char TEST_TRAILER[TEST_TRAILER_LENGTH] = { 'T', 'R', 'L', 'R' };
+static unsigned char g_payload[TEST_PAYLOAD_LENGTH];
+
+static void fill_bytes(unsigned char* target, size_t length, unsigned char seed)
+{
+    for (size_t index = 0; index < length; index++)
+    {
+        target[index] = (unsigned char)(seed + index);
+    }
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(buffer_chain_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    REGISTER_UMOCK_ALIAS_TYPE(BUFFER_CHAIN_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(const unsigned char*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_realloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    fill_bytes(g_payload, TEST_PAYLOAD_LENGTH, 0x20);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(buffer_chain_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_create_malloc_fail)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    buffer_chain_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_destroy_releases_owned_segments_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, segment_release_callback, g_payload);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(segment_release_callback(g_payload, g_payload, TEST_PAYLOAD_LENGTH));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(handle));
+
+    // act
+    buffer_chain_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_append_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = buffer_chain_append(NULL, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_append_data_NULL_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append(handle, NULL, TEST_PAYLOAD_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_length_0_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append(handle, g_payload, 0, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_iovec(handle, iov_array, 2));
+    // Referenced in place, not copied
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH, iov_array[0].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_malloc_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, segment_release_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_prepend_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[4];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_prepend(handle, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_HEADER_LENGTH+TEST_PAYLOAD_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, buffer_chain_get_iovec(handle, iov_array, 4));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_HEADER, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[1].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_prepend_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = buffer_chain_prepend(NULL, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_append_copy_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    unsigned char trailer[TEST_TRAILER_LENGTH];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    memcpy(trailer, TEST_TRAILER, TEST_TRAILER_LENGTH);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_append_copy(handle, trailer, TEST_TRAILER_LENGTH);
+    // The chain holds its own copy
+    memset(trailer, 0, TEST_TRAILER_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, trailer, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_TRAILER_LENGTH, iov_array[0].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(iov_array[0].iov_base, TEST_TRAILER, TEST_TRAILER_LENGTH));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_copy_malloc_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = buffer_chain_append_copy(handle, TEST_TRAILER, TEST_TRAILER_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_prepend_copy_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_prepend_copy(handle, TEST_HEADER, TEST_HEADER_LENGTH);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(iov_array[0].iov_base, TEST_HEADER, TEST_HEADER_LENGTH));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[1].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_byte_buffer_heap_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)byte_buffer_construct(&buffer, g_payload, LONG_LENGTH);
+    unsigned char* payload = buffer.payload;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_append_byte_buffer(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.alloc_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_iovec(handle, iov_array, 2));
+    // The heap payload moved over as it was
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, payload, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH, iov_array[0].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_byte_buffer_inline_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)byte_buffer_construct(&buffer, TEST_HEADER, TEST_HEADER_LENGTH);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_append_byte_buffer(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_NOT_EQUAL(void_ptr, buffer.inline_payload, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(iov_array[0].iov_base, TEST_HEADER, TEST_HEADER_LENGTH));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_byte_buffer_malloc_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)byte_buffer_construct(&buffer, g_payload, LONG_LENGTH);
+    unsigned char* payload = buffer.payload;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = buffer_chain_append_byte_buffer(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    // The buffer still owns its payload
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, payload, buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, LONG_LENGTH, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_byte_buffer_empty_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append_byte_buffer(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_prepend_byte_buffer_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    (void)byte_buffer_construct(&buffer, TEST_HEADER, TEST_HEADER_LENGTH);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_prepend_byte_buffer(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(iov_array[0].iov_base, TEST_HEADER, TEST_HEADER_LENGTH));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[1].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_chain_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[4];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    BUFFER_CHAIN_HANDLE source = buffer_chain_create();
+    (void)buffer_chain_append(handle, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(source, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(source, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append_chain(handle, source);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_length(source));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer_chain_get_segment_count(source));
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_HEADER_LENGTH+TEST_PAYLOAD_LENGTH+TEST_TRAILER_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, buffer_chain_get_iovec(handle, iov_array, 4));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_HEADER, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[1].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_TRAILER, iov_array[2].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(source);
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_chain_to_empty_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    BUFFER_CHAIN_HANDLE source = buffer_chain_create();
+    (void)buffer_chain_append(source, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append_chain(handle, source);
+    // The tail came across as well
+    int append_result = buffer_chain_append(handle, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, append_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH+TEST_TRAILER_LENGTH, buffer_chain_get_length(handle));
+
+    // cleanup
+    buffer_chain_destroy(source);
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_append_chain_same_handle_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_append_chain(handle, handle);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_get_length_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = buffer_chain_get_length(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_get_segment_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = buffer_chain_get_segment_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_get_iovec_iov_array_NULL_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = buffer_chain_get_iovec(handle, NULL, 2);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_get_iovec_count_limit_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(handle, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = buffer_chain_get_iovec(handle, iov_array, 2);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_HEADER, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_HEADER_LENGTH, iov_array[0].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload, iov_array[1].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH, iov_array[1].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+#ifndef WIN32
+CTEST_FUNCTION(buffer_chain_iovec_matches_posix_iovec_succeed)
+{
+    // arrange
+
+    // act
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(struct iovec), sizeof(BUFFER_CHAIN_IOVEC));
+    CTEST_ASSERT_ARE_EQUAL(size_t, offsetof(struct iovec, iov_base), offsetof(BUFFER_CHAIN_IOVEC, iov_base));
+    CTEST_ASSERT_ARE_EQUAL(size_t, offsetof(struct iovec, iov_len), offsetof(BUFFER_CHAIN_IOVEC, iov_len));
+
+    // cleanup
+}
+#endif
+
+CTEST_FUNCTION(buffer_chain_consume_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = buffer_chain_consume(NULL, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_consume_past_length_fail)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_consume(handle, TEST_PAYLOAD_LENGTH+1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_consume_partial_segment_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    size_t written = 100;
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, segment_release_callback, NULL);
+    (void)buffer_chain_append(handle, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_consume(handle, written);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH-written+TEST_TRAILER_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, g_payload+written, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH-written, iov_array[0].iov_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_consume_releases_segments_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_IOVEC iov_array[2];
+    size_t written = 10;
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, segment_release_callback, NULL);
+    (void)buffer_chain_append(handle, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+    (void)buffer_chain_consume(handle, written);
+    umock_c_reset_all_calls();
+
+    // Released with what it was added with, not what was left of it
+    STRICT_EXPECTED_CALL(segment_release_callback(NULL, g_payload, TEST_PAYLOAD_LENGTH));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_consume(handle, TEST_PAYLOAD_LENGTH-written+1);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_TRAILER_LENGTH-1, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_iovec(handle, iov_array, 2));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_TRAILER+1, iov_array[0].iov_base);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_consume_all_succeed)
+{
+    // arrange
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, TEST_HEADER, TEST_HEADER_LENGTH, NULL, NULL);
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = buffer_chain_consume(handle, TEST_HEADER_LENGTH+TEST_PAYLOAD_LENGTH);
+    // An emptied chain can be reused
+    int append_result = buffer_chain_append(handle, TEST_TRAILER, TEST_TRAILER_LENGTH, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, append_result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_TRAILER_LENGTH, buffer_chain_get_length(handle));
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_flatten_handle_NULL_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+
+    // act
+    int result = buffer_chain_flatten(NULL, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(buffer_chain_flatten_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    unsigned char expected[TEST_HEADER_LENGTH+TEST_PAYLOAD_LENGTH+TEST_TRAILER_LENGTH];
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    (void)buffer_chain_prepend_copy(handle, TEST_HEADER, TEST_HEADER_LENGTH);
+    (void)buffer_chain_append_copy(handle, TEST_TRAILER, TEST_TRAILER_LENGTH);
+    memcpy(expected, TEST_HEADER, TEST_HEADER_LENGTH);
+    memcpy(expected+TEST_HEADER_LENGTH, g_payload, TEST_PAYLOAD_LENGTH);
+    memcpy(expected+TEST_HEADER_LENGTH+TEST_PAYLOAD_LENGTH, TEST_TRAILER, TEST_TRAILER_LENGTH);
+    umock_c_reset_all_calls();
+
+    // One allocation for the whole message
+    STRICT_EXPECTED_CALL(malloc(sizeof(expected)+1));
+
+    // act
+    int result = buffer_chain_flatten(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(expected), buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(buffer.payload, expected, sizeof(expected)));
+    // The chain is left as it was
+    CTEST_ASSERT_ARE_EQUAL(size_t, 3, buffer_chain_get_segment_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(expected), buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    byte_buffer_free(&buffer);
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_flatten_empty_chain_succeed)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = buffer_chain_flatten(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(buffer.payload);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_FUNCTION(buffer_chain_flatten_malloc_fail)
+{
+    // arrange
+    BYTE_BUFFER buffer = { 0 };
+    BUFFER_CHAIN_HANDLE handle = buffer_chain_create();
+    (void)buffer_chain_append(handle, g_payload, TEST_PAYLOAD_LENGTH, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = buffer_chain_flatten(handle, &buffer);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, buffer.payload_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_PAYLOAD_LENGTH, buffer_chain_get_length(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    buffer_chain_destroy(handle);
+}
+
+CTEST_END_TEST_SUITE(buffer_chain_ut)
@@ -0,0 +1,711 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_stdint.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/item_map.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/atomic_operations.h"
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/concurrent_map.h"
+
+#define TEST_SHARD_COUNT    4
+#define TEST_MAP_SIZE       100
+
+static MUTEX_HANDLE TEST_MUTEX_HANDLE = (MUTEX_HANDLE)0x1234;
+static ITEM_MAP_HANDLE TEST_ITEM_MAP_HANDLE = (ITEM_MAP_HANDLE)0x5678;
+static const char* TEST_KEY = "test_key";
+static const uint32_t TEST_HASH_VALUE = 42;
+static const int TEST_VALUE = 22;
+static size_t g_shard_size;
+static size_t g_stored_len;
+
+static int my_mutex_mgr_create(MUTEX_HANDLE* handle)
+{
+    *handle = TEST_MUTEX_HANDLE;
+    return 0;
+}
+
+static int my_item_map_add_item(ITEM_MAP_HANDLE handle, const char* key, const void* value, size_t len)
+{
+    (void)handle;
+    (void)key;
+    (void)value;
+    (void)len;
+    g_shard_size++;
+    return 0;
+}
+
+static int my_item_map_remove_item(ITEM_MAP_HANDLE handle, const char* key)
+{
+    (void)handle;
+    (void)key;
+    if (g_shard_size > 0)
+    {
+        g_shard_size--;
+    }
+    return 0;
+}
+
+static int my_item_map_clear_all(ITEM_MAP_HANDLE handle)
+{
+    (void)handle;
+    g_shard_size = 0;
+    return 0;
+}
+
+static size_t my_item_map_size(ITEM_MAP_HANDLE handle)
+{
+    (void)handle;
+    return g_shard_size;
+}
+
+static const void* my_item_map_get_item_prehashed(ITEM_MAP_HANDLE handle, const char* key, size_t key_len, uint32_t hash, size_t* len)
+{
+    (void)handle;
+    (void)key;
+    (void)key_len;
+    (void)hash;
+    if (len != NULL)
+    {
+        *len = g_stored_len;
+    }
+    return &TEST_VALUE;
+}
+
+static long my_atomic_add(long* operand, long value)
+{
+    *operand += value;
+    return *operand;
+}
+
+static long my_atomic_subtract(long* operand, long value)
+{
+    *operand -= value;
+    return *operand;
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+static void setup_concurrent_map_create_mocks(size_t shard_count)
+{
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    for (size_t index = 0; index < shard_count; index++)
+    {
+        STRICT_EXPECTED_CALL(mutex_mgr_create(IGNORED_ARG));
+        STRICT_EXPECTED_CALL(item_map_create_with_options(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    }
+}
+
+CTEST_BEGIN_TEST_SUITE(concurrent_map_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    int result;
+
+    (void)umock_c_init(on_umock_c_error);
+
+    result = umocktypes_charptr_register_types();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    result = umocktypes_stdint_register_types();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(ITEM_MAP_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ITEM_MAP_DESTROY_ITEM, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(ITEM_MAP_HASH_FUNCTION, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(MUTEX_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(MUTEX_HANDLE*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(long*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mutex_mgr_create, my_mutex_mgr_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mutex_mgr_create, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(mutex_mgr_lock, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mutex_mgr_lock, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(mutex_mgr_unlock, 0);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mutex_mgr_unlock, __LINE__);
+
+    REGISTER_GLOBAL_MOCK_RETURN(item_map_create_with_options, TEST_ITEM_MAP_HANDLE);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_map_create_with_options, NULL);
+    REGISTER_GLOBAL_MOCK_RETURN(item_map_hash_key, TEST_HASH_VALUE);
+    REGISTER_GLOBAL_MOCK_HOOK(item_map_add_item, my_item_map_add_item);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_map_add_item, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(item_map_remove_item, my_item_map_remove_item);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(item_map_remove_item, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(item_map_clear_all, my_item_map_clear_all);
+    REGISTER_GLOBAL_MOCK_HOOK(item_map_size, my_item_map_size);
+    REGISTER_GLOBAL_MOCK_HOOK(item_map_get_item_prehashed, my_item_map_get_item_prehashed);
+
+    REGISTER_GLOBAL_MOCK_HOOK(atomic_add, my_atomic_add);
+    REGISTER_GLOBAL_MOCK_HOOK(atomic_subtract, my_atomic_subtract);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    g_shard_size = 0;
+    g_stored_len = sizeof(TEST_VALUE);
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(concurrent_map_create_succeed)
+{
+    // arrange
+    setup_concurrent_map_create_mocks(TEST_SHARD_COUNT);
+
+    // act
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_create_shard_size_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mutex_mgr_create(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_map_create_with_options(TEST_MAP_SIZE/2, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mutex_mgr_create(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_map_create_with_options(TEST_MAP_SIZE/2, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(2, TEST_MAP_SIZE, NULL, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_create_default_shards_succeed)
+{
+    // arrange
+    setup_concurrent_map_create_mocks(CONCURRENT_MAP_DEFAULT_SHARDS);
+
+    // act
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(0, TEST_MAP_SIZE, NULL, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_create_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    setup_concurrent_map_create_mocks(TEST_SHARD_COUNT);
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+
+            // assert
+            CTEST_ASSERT_IS_NULL(handle, "concurrent_map_create failure in test %zu", index);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(concurrent_map_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    concurrent_map_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_destroy_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(2, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_destroy(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_destroy(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_destroy(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_destroy(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    concurrent_map_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_add_item_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = concurrent_map_add_item(NULL, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_add_item_key_NULL_fail)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = concurrent_map_add_item(handle, NULL, &TEST_VALUE, sizeof(TEST_VALUE));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_add_item_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_add_item(TEST_ITEM_MAP_HANDLE, TEST_KEY, IGNORED_ARG, sizeof(TEST_VALUE)));
+    STRICT_EXPECTED_CALL(atomic_add(IGNORED_ARG, 1));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_add_item(handle, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_add_item_fail)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_add_item(TEST_ITEM_MAP_HANDLE, TEST_KEY, IGNORED_ARG, sizeof(TEST_VALUE)));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            int result = concurrent_map_add_item(handle, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+
+            // assert
+            CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "concurrent_map_add_item failure in test %zu", index);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_handle_NULL_fail)
+{
+    // arrange
+    int value;
+
+    // act
+    int result = concurrent_map_get_item(NULL, TEST_KEY, &value, sizeof(value), NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_value_NULL_fail)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, NULL, sizeof(int), NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_succeed)
+{
+    // arrange
+    int value = 0;
+    size_t value_len = 0;
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_get_item_prehashed(TEST_ITEM_MAP_HANDLE, TEST_KEY, strlen(TEST_KEY), TEST_HASH_VALUE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, &value, sizeof(value), &value_len);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, TEST_VALUE, value);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(TEST_VALUE), value_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_stored_value_shorter_succeed)
+{
+    // arrange
+    int value[2] = { 0, 0 };
+    size_t value_len = 0;
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_get_item_prehashed(TEST_ITEM_MAP_HANDLE, TEST_KEY, strlen(TEST_KEY), TEST_HASH_VALUE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, value, sizeof(value), &value_len);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, TEST_VALUE, value[0]);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, value[1]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(TEST_VALUE), value_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_buffer_too_small_truncates)
+{
+    // arrange
+    unsigned char value[sizeof(TEST_VALUE) + 1];
+    size_t value_len = 0;
+    memset(value, 0xFF, sizeof(value));
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_get_item_prehashed(TEST_ITEM_MAP_HANDLE, TEST_KEY, strlen(TEST_KEY), TEST_HASH_VALUE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, value, 2, &value_len);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(value, &TEST_VALUE, 2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0xFF, value[2]);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(TEST_VALUE), value_len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_not_found_fail)
+{
+    // arrange
+    int value = 0;
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_get_item_prehashed(TEST_ITEM_MAP_HANDLE, TEST_KEY, strlen(TEST_KEY), TEST_HASH_VALUE, IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, &value, sizeof(value), NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, value);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_get_item_lock_fail)
+{
+    // arrange
+    int value = 0;
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE)).SetReturn(__LINE__);
+
+    // act
+    int result = concurrent_map_get_item(handle, TEST_KEY, &value, sizeof(value), NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_remove_item_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = concurrent_map_remove_item(NULL, TEST_KEY);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_remove_item_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    (void)concurrent_map_add_item(handle, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_remove_item(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(atomic_subtract(IGNORED_ARG, 1));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_remove_item(handle, TEST_KEY);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, concurrent_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_remove_item_not_found_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_map_hash_key(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_remove_item(TEST_ITEM_MAP_HANDLE, TEST_KEY));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(atomic_subtract(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_remove_item(handle, TEST_KEY);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, concurrent_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_clear_all_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = concurrent_map_clear_all(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_clear_all_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(2, TEST_MAP_SIZE, NULL, NULL, NULL);
+    (void)concurrent_map_add_item(handle, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_clear_all(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(atomic_subtract(IGNORED_ARG, 1));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_size(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(item_map_clear_all(TEST_ITEM_MAP_HANDLE));
+    STRICT_EXPECTED_CALL(atomic_subtract(IGNORED_ARG, 0));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = concurrent_map_clear_all(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, concurrent_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_FUNCTION(concurrent_map_size_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = concurrent_map_size(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(concurrent_map_size_succeed)
+{
+    // arrange
+    CONCURRENT_MAP_HANDLE handle = concurrent_map_create(TEST_SHARD_COUNT, TEST_MAP_SIZE, NULL, NULL, NULL);
+    (void)concurrent_map_add_item(handle, TEST_KEY, &TEST_VALUE, sizeof(TEST_VALUE));
+    (void)concurrent_map_add_item(handle, "another_key", &TEST_VALUE, sizeof(TEST_VALUE));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(atomic_add(IGNORED_ARG, 0));
+
+    // act
+    size_t result = concurrent_map_size(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    concurrent_map_destroy(handle);
+}
+
+CTEST_END_TEST_SUITE(concurrent_map_ut)
@@ -0,0 +1,580 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/mutex_mgr.h"
+#include "lib-util-c/condition_mgr.h"
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/concurrent_queue.h"
+
+#define TEST_QUEUE_CAPACITY     4
+
+typedef struct TEST_RECORD_TAG
+{
+    int value;
+    DLLIST_ENTRY entry;
+} TEST_RECORD;
+
+static MUTEX_HANDLE TEST_MUTEX_HANDLE = (MUTEX_HANDLE)0x1234;
+static SIGNAL_HANDLE TEST_SIGNAL_HANDLE = (SIGNAL_HANDLE)0x4321;
+static void* TEST_ITEM_1 = (void*)0x11;
+static void* TEST_ITEM_2 = (void*)0x12;
+static void* TEST_ITEM_3 = (void*)0x13;
+
+// Stand in for a producer thread pushing while the consumer sleeps
+static MPMC_QUEUE_HANDLE g_mpmc_queue;
+static MPSC_QUEUE_HANDLE g_mpsc_queue;
+static TEST_RECORD g_wait_record;
+
+static int my_mutex_mgr_create(MUTEX_HANDLE* handle)
+{
+    *handle = TEST_MUTEX_HANDLE;
+    return 0;
+}
+
+static int my_condition_mgr_init(SIGNAL_HANDLE* signal_item)
+{
+    *signal_item = TEST_SIGNAL_HANDLE;
+    return 0;
+}
+
+static int my_condition_mgr_wait(SIGNAL_HANDLE signal_item, MUTEX_HANDLE mutex)
+{
+    (void)signal_item;
+    (void)mutex;
+    if (g_mpmc_queue != NULL)
+    {
+        (void)mpmc_queue_push(g_mpmc_queue, TEST_ITEM_3);
+    }
+    if (g_mpsc_queue != NULL)
+    {
+        (void)mpsc_queue_push(g_mpsc_queue, &g_wait_record.entry);
+    }
+    return 0;
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+static void setup_queue_signal_mocks(void)
+{
+    STRICT_EXPECTED_CALL(mutex_mgr_create(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(condition_mgr_init(IGNORED_ARG));
+}
+
+CTEST_BEGIN_TEST_SUITE(concurrent_queue_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    int result;
+
+    (void)umock_c_init(on_umock_c_error);
+
+    result = umocktypes_charptr_register_types();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(MUTEX_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(MUTEX_HANDLE*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SIGNAL_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(SIGNAL_HANDLE*, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mutex_mgr_create, my_mutex_mgr_create);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mutex_mgr_create, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(mutex_mgr_lock, 0);
+    REGISTER_GLOBAL_MOCK_RETURN(mutex_mgr_unlock, 0);
+
+    REGISTER_GLOBAL_MOCK_HOOK(condition_mgr_init, my_condition_mgr_init);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(condition_mgr_init, __LINE__);
+    REGISTER_GLOBAL_MOCK_HOOK(condition_mgr_wait, my_condition_mgr_wait);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(condition_mgr_wait, __LINE__);
+    REGISTER_GLOBAL_MOCK_RETURN(condition_mgr_signal, 0);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    g_mpmc_queue = NULL;
+    g_mpsc_queue = NULL;
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(mpmc_queue_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    setup_queue_signal_mocks();
+
+    // act
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_create_capacity_0_fail)
+{
+    // arrange
+
+    // act
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(0);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpmc_queue_create_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    setup_queue_signal_mocks();
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+
+            // assert
+            CTEST_ASSERT_IS_NULL(handle, "mpmc_queue_create failure in test %zu", index);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(mpmc_queue_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    mpmc_queue_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpmc_queue_destroy_succeed)
+{
+    // arrange
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(condition_mgr_deinit(TEST_SIGNAL_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_destroy(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    mpmc_queue_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpmc_queue_push_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = mpmc_queue_push(NULL, TEST_ITEM_1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpmc_queue_push_full_fail)
+{
+    // arrange
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    for (size_t index = 0; index < TEST_QUEUE_CAPACITY; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, mpmc_queue_push(handle, TEST_ITEM_1));
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    int result = mpmc_queue_push(handle, TEST_ITEM_2);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_try_pop_handle_NULL_fail)
+{
+    // arrange
+    void* item;
+
+    // act
+    int result = mpmc_queue_try_pop(NULL, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpmc_queue_try_pop_empty_fail)
+{
+    // arrange
+    void* item;
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = mpmc_queue_try_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_try_pop_fifo_succeed)
+{
+    // arrange
+    void* item;
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    umock_c_reset_all_calls();
+
+    // act
+    // Several laps around the ring
+    for (size_t index = 0; index < TEST_QUEUE_CAPACITY*3; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, mpmc_queue_push(handle, TEST_ITEM_1));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, mpmc_queue_push(handle, TEST_ITEM_2));
+
+        // assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, mpmc_queue_try_pop(handle, &item));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, item);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, mpmc_queue_try_pop(handle, &item));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_2, item);
+    }
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, mpmc_queue_try_pop(handle, &item));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_pop_item_ready_succeed)
+{
+    // arrange
+    void* item;
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    (void)mpmc_queue_push(handle, TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = mpmc_queue_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_1, item);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_pop_waits_succeed)
+{
+    // arrange
+    void* item;
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    g_mpmc_queue = handle;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_wait(TEST_SIGNAL_HANDLE, TEST_MUTEX_HANDLE));
+    // The producer sees the waiter and signals it
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_signal(TEST_SIGNAL_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = mpmc_queue_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, TEST_ITEM_3, item);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpmc_queue_pop_wait_fail)
+{
+    // arrange
+    void* item;
+    MPMC_QUEUE_HANDLE handle = mpmc_queue_create(TEST_QUEUE_CAPACITY);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_wait(TEST_SIGNAL_HANDLE, TEST_MUTEX_HANDLE)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    int result = mpmc_queue_pop(handle, &item);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpmc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpsc_queue_create_succeed)
+{
+    // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    setup_queue_signal_mocks();
+
+    // act
+    MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_IS_NULL(mpsc_queue_try_pop(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpsc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpsc_queue_create_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    setup_queue_signal_mocks();
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+
+            // assert
+            CTEST_ASSERT_IS_NULL(handle, "mpsc_queue_create failure in test %zu", index);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(mpsc_queue_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    mpsc_queue_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpsc_queue_push_entry_NULL_fail)
+{
+    // arrange
+    MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    // act
+    int result = mpsc_queue_push(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpsc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpsc_queue_try_pop_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    PDLLIST_ENTRY result = mpsc_queue_try_pop(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(mpsc_queue_try_pop_fifo_succeed)
+{
+    // arrange
+    TEST_RECORD records[3];
+    MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    // act
+    // Drains the queue between rounds so the stub is pushed back each time
+    for (size_t round = 0; round < 2; round++)
+    {
+        for (int index = 0; index < 3; index++)
+        {
+            records[index].value = index;
+            CTEST_ASSERT_ARE_EQUAL(int, 0, mpsc_queue_push(handle, &records[index].entry));
+        }
+
+        // assert
+        for (int index = 0; index < 3; index++)
+        {
+            PDLLIST_ENTRY entry = mpsc_queue_try_pop(handle);
+            CTEST_ASSERT_IS_NOT_NULL(entry);
+            CTEST_ASSERT_ARE_EQUAL(int, index, LIST_CONTAINING_RECORD(entry, TEST_RECORD, entry)->value);
+        }
+        CTEST_ASSERT_IS_NULL(mpsc_queue_try_pop(handle));
+    }
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpsc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpsc_queue_pop_waits_succeed)
+{
+    // arrange
+    MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+    g_mpsc_queue = handle;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_wait(TEST_SIGNAL_HANDLE, TEST_MUTEX_HANDLE));
+    // The producer sees the waiter and signals it
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_signal(TEST_SIGNAL_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    PDLLIST_ENTRY result = mpsc_queue_pop(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &g_wait_record.entry, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpsc_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(mpsc_queue_pop_wait_fail)
+{
+    // arrange
+    MPSC_QUEUE_HANDLE handle = mpsc_queue_create();
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(mutex_mgr_lock(TEST_MUTEX_HANDLE));
+    STRICT_EXPECTED_CALL(condition_mgr_wait(TEST_SIGNAL_HANDLE, TEST_MUTEX_HANDLE)).SetReturn(__LINE__);
+    STRICT_EXPECTED_CALL(mutex_mgr_unlock(TEST_MUTEX_HANDLE));
+
+    // act
+    PDLLIST_ENTRY result = mpsc_queue_pop(handle);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    mpsc_queue_destroy(handle);
+}
+
+CTEST_END_TEST_SUITE(concurrent_queue_ut)
@@ -62,6 +62,9 @@ CTEST_SUITE_INITIALIZE()
     result = umocktypes_charptr_register_types();
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
 
+    REGISTER_UMOCK_ALIAS_TYPE(pthread_cond_t*, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(pthread_mutex_t*, void*);
+
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
@@ -115,6 +118,7 @@ CTEST_FUNCTION(condition_mgr_init_success)
     SIGNAL_HANDLE handle;
 
     // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(pthread_cond_init(IGNORED_ARG, IGNORED_ARG));
 
     // act
@@ -122,9 +126,11 @@ CTEST_FUNCTION(condition_mgr_init_success)
 
     // assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(handle);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_init_fail)
@@ -135,30 +141,51 @@ CTEST_FUNCTION(condition_mgr_init_fail)
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
 
     // arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(pthread_cond_init(IGNORED_ARG, IGNORED_ARG));
 
     umock_c_negative_tests_snapshot();
 
-    // act
-    umock_c_negative_tests_reset();
-    umock_c_negative_tests_fail_call(0);
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
 
-    int result = condition_mgr_init(&handle);
+        // act
+        int result = condition_mgr_init(&handle);
+
+        // assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result, "condition_mgr_init failure %zu/%zu", index, count);
+        CTEST_ASSERT_IS_NULL(handle);
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(condition_mgr_deinit_handle_NULL_success)
+{
+    // arrange
+
+    // act
+    condition_mgr_deinit(NULL);
 
     // assert
-    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
-    umock_c_negative_tests_deinit();
 }
 
 CTEST_FUNCTION(condition_mgr_deinit_success)
 {
     SIGNAL_HANDLE handle;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     // arrange
-    STRICT_EXPECTED_CALL(pthread_cond_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(pthread_cond_destroy(handle));
+    STRICT_EXPECTED_CALL(free(handle));
 
     // act
     condition_mgr_deinit(handle);
@@ -172,6 +199,8 @@ CTEST_FUNCTION(condition_mgr_deinit_success)
 CTEST_FUNCTION(condition_mgr_signal_success)
 {
     SIGNAL_HANDLE handle;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     // arrange
     STRICT_EXPECTED_CALL(pthread_cond_signal(IGNORED_ARG));
@@ -184,11 +213,14 @@ CTEST_FUNCTION(condition_mgr_signal_success)
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_signal_fail)
 {
     SIGNAL_HANDLE handle;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
@@ -210,12 +242,15 @@ CTEST_FUNCTION(condition_mgr_signal_fail)
 
     // cleanup
     umock_c_negative_tests_deinit();
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_wait_success)
 {
     SIGNAL_HANDLE handle;
-    MUTEX_HANDLE mutex;
+    MUTEX_HANDLE mutex = NULL;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     // arrange
     STRICT_EXPECTED_CALL(pthread_cond_wait(IGNORED_ARG, IGNORED_ARG));
@@ -228,12 +263,15 @@ CTEST_FUNCTION(condition_mgr_wait_success)
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_wait_fail)
 {
     SIGNAL_HANDLE handle;
-    MUTEX_HANDLE mutex;
+    MUTEX_HANDLE mutex = NULL;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
@@ -255,13 +293,16 @@ CTEST_FUNCTION(condition_mgr_wait_fail)
 
     // cleanup
     umock_c_negative_tests_deinit();
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_timed_wait_success)
 {
     SIGNAL_HANDLE handle;
-    MUTEX_HANDLE mutex;
+    MUTEX_HANDLE mutex = NULL;
     struct timespec abstime;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     // arrange
     STRICT_EXPECTED_CALL(pthread_cond_timedwait(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
@@ -274,13 +315,16 @@ CTEST_FUNCTION(condition_mgr_timed_wait_success)
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_timed_wait_fail)
 {
     SIGNAL_HANDLE handle;
-    MUTEX_HANDLE mutex;
+    MUTEX_HANDLE mutex = NULL;
     struct timespec abstime;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
@@ -302,11 +346,14 @@ CTEST_FUNCTION(condition_mgr_timed_wait_fail)
 
     // cleanup
     umock_c_negative_tests_deinit();
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_broadcast_success)
 {
     SIGNAL_HANDLE handle;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     // arrange
     STRICT_EXPECTED_CALL(pthread_cond_broadcast(IGNORED_ARG));
@@ -319,11 +366,14 @@ CTEST_FUNCTION(condition_mgr_broadcast_success)
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     // cleanup
+    condition_mgr_deinit(handle);
 }
 
 CTEST_FUNCTION(condition_mgr_broadcast_fail)
 {
     SIGNAL_HANDLE handle;
+    (void)condition_mgr_init(&handle);
+    umock_c_reset_all_calls();
 
     int negativeTestsInitResult = umock_c_negative_tests_init();
     CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
@@ -345,6 +395,7 @@ CTEST_FUNCTION(condition_mgr_broadcast_fail)
 
     // cleanup
     umock_c_negative_tests_deinit();
+    condition_mgr_deinit(handle);
 }
 
 CTEST_END_TEST_SUITE(condition_mgr_posix_ut)
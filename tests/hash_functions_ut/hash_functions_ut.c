@@ -0,0 +1,389 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#endif
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+// Include the test tools.
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_charptr.h"
+#include "umock_c/umocktypes_stdint.h"
+#include "umock_c/umocktypes_bool.h"
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#include "lib-util-c/atomic_operations.h"
+#include "lib-util-c/random_mgr.h"
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/hash_functions.h"
+
+static const char* TEST_HASH_STRING = "device/000042/telemetry";
+
+// Reference key and message from the SipHash paper, bytes 00 01 02 ...
+static const unsigned char TEST_SIPHASH_KEY[HASH_SIPHASH_KEY_SIZE] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f };
+static const unsigned char TEST_SIPHASH_MSG[] = {
+    0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+    0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e };
+static const uint64_t TEST_SIPHASH_EMPTY_RESULT = 0x726fdb47dd0e0e31ULL;
+static const uint64_t TEST_SIPHASH_15_BYTE_RESULT = 0xa129ca6149be45e5ULL;
+
+// Values produced by the reference XXH3_64bits_withSeed
+static const uint64_t TEST_XXH3_EMPTY_RESULT = 0x2d06800538d394c2ULL;
+static const uint64_t TEST_XXH3_ABC_RESULT = 0x78af5f94892f3950ULL;
+static const uint64_t TEST_XXH3_SEEDED_RESULT = 0x972a5725e93d338eULL;
+
+static bool g_siphash_key_seeded;
+
+static int64_t my_atomic_load64(int64_t* value)
+{
+    return *value;
+}
+
+static void my_atomic_store64(int64_t* value, int64_t new_value)
+{
+    *value = new_value;
+}
+
+static bool my_atomic_compare_exchange64(int64_t* value, int64_t expected, int64_t desired)
+{
+    bool result;
+    if (*value == expected)
+    {
+        *value = desired;
+        result = true;
+    }
+    else
+    {
+        result = false;
+    }
+    return result;
+}
+
+static int my_random_mgr_get_bytes(unsigned char* buffer, size_t len)
+{
+    memcpy(buffer, TEST_SIPHASH_KEY, len);
+    g_siphash_key_seeded = true;
+    return 0;
+}
+
+// The key is seeded once per process, only the first
+// hash_siphash_string call of the run reads the random source
+static void setup_siphash_key_mocks(void)
+{
+    STRICT_EXPECTED_CALL(atomic_load64(IGNORED_ARG));
+    if (!g_siphash_key_seeded)
+    {
+        STRICT_EXPECTED_CALL(atomic_compare_exchange64(IGNORED_ARG, IGNORED_ARG, IGNORED_ARG));
+        STRICT_EXPECTED_CALL(random_mgr_get_bytes(IGNORED_ARG, HASH_SIPHASH_KEY_SIZE));
+        STRICT_EXPECTED_CALL(atomic_store64(IGNORED_ARG, IGNORED_ARG));
+    }
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(hash_functions_ut)
+
+    CTEST_SUITE_INITIALIZE()
+    {
+        int result;
+
+        (void)umock_c_init(on_umock_c_error);
+
+        result = umocktypes_charptr_register_types();
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        result = umocktypes_stdint_register_types();
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        result = umocktypes_bool_register_types();
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+
+        REGISTER_UMOCK_ALIAS_TYPE(int64_t*, void*);
+        REGISTER_UMOCK_ALIAS_TYPE(unsigned char*, void*);
+
+        REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+        REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+        REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+
+        REGISTER_GLOBAL_MOCK_HOOK(atomic_load64, my_atomic_load64);
+        REGISTER_GLOBAL_MOCK_HOOK(atomic_store64, my_atomic_store64);
+        REGISTER_GLOBAL_MOCK_HOOK(atomic_compare_exchange64, my_atomic_compare_exchange64);
+        REGISTER_GLOBAL_MOCK_HOOK(random_mgr_get_bytes, my_random_mgr_get_bytes);
+    }
+
+    CTEST_SUITE_CLEANUP()
+    {
+        umock_c_deinit();
+    }
+
+    CTEST_FUNCTION_INITIALIZE()
+    {
+        umock_c_reset_all_calls();
+    }
+
+    CTEST_FUNCTION_CLEANUP()
+    {
+    }
+
+    CTEST_FUNCTION(hash_xxh3_empty_succeed)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_xxh3("", 0, 0);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(TEST_XXH3_EMPTY_RESULT == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_xxh3_short_succeed)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_xxh3("abc", 3, 0);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(TEST_XXH3_ABC_RESULT == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_xxh3_seed_succeed)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_xxh3("hello world", 11, 42);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(TEST_XXH3_SEEDED_RESULT == result);
+        CTEST_ASSERT_IS_TRUE(hash_xxh3("hello world", 11, 0) != result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_xxh3_all_lengths_succeed)
+    {
+        //arrange
+        unsigned char buffer[1024];
+        for (size_t index = 0; index < sizeof(buffer); index++)
+        {
+            buffer[index] = (unsigned char)(index * 131 + 7);
+        }
+
+        //act
+        uint64_t prev_hash = hash_xxh3(buffer, 0, 0);
+        for (size_t index = 1; index < sizeof(buffer); index++)
+        {
+            uint64_t result = hash_xxh3(buffer, index, 0);
+
+            //assert
+            CTEST_ASSERT_IS_TRUE(prev_hash != result);
+            CTEST_ASSERT_IS_TRUE(hash_xxh3(buffer, index, 0) == result);
+            prev_hash = result;
+        }
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_wyhash_deterministic_succeed)
+    {
+        //arrange
+        size_t key_len = strlen(TEST_HASH_STRING);
+
+        //act
+        uint64_t result = hash_wyhash(TEST_HASH_STRING, key_len, 0);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(hash_wyhash(TEST_HASH_STRING, key_len, 0) == result);
+        CTEST_ASSERT_IS_TRUE(hash_wyhash(TEST_HASH_STRING, key_len, 1) != result);
+        CTEST_ASSERT_IS_TRUE(hash_wyhash(TEST_HASH_STRING, key_len - 1, 0) != result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_wyhash_all_lengths_succeed)
+    {
+        //arrange
+        unsigned char buffer[256];
+        memset(buffer, 'a', sizeof(buffer));
+
+        //act
+        uint64_t prev_hash = hash_wyhash(buffer, 0, 0);
+        for (size_t index = 1; index < sizeof(buffer); index++)
+        {
+            uint64_t result = hash_wyhash(buffer, index, 0);
+
+            //assert
+            CTEST_ASSERT_IS_TRUE(prev_hash != result);
+            prev_hash = result;
+        }
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_key_NULL_fail)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_siphash(TEST_SIPHASH_MSG, sizeof(TEST_SIPHASH_MSG), NULL);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(0 == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_data_NULL_fail)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_siphash(NULL, 10, TEST_SIPHASH_KEY);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(0 == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_empty_succeed)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_siphash(TEST_SIPHASH_MSG, 0, TEST_SIPHASH_KEY);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(TEST_SIPHASH_EMPTY_RESULT == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_succeed)
+    {
+        //arrange
+
+        //act
+        uint64_t result = hash_siphash(TEST_SIPHASH_MSG, sizeof(TEST_SIPHASH_MSG), TEST_SIPHASH_KEY);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(TEST_SIPHASH_15_BYTE_RESULT == result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_string_seeded_key_succeed)
+    {
+        //arrange
+        uint64_t expected = hash_siphash(TEST_HASH_STRING, strlen(TEST_HASH_STRING), TEST_SIPHASH_KEY);
+        setup_siphash_key_mocks();
+
+        //act
+        uint32_t string_hash = hash_siphash_string(TEST_HASH_STRING);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE((uint32_t)(expected ^ (expected >> 32)) == string_hash);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_siphash_string_seeds_key_once_succeed)
+    {
+        //arrange
+        uint32_t first_hash = hash_siphash_string(TEST_HASH_STRING);
+        umock_c_reset_all_calls();
+
+        STRICT_EXPECTED_CALL(atomic_load64(IGNORED_ARG));
+
+        //act
+        uint32_t string_hash = hash_siphash_string(TEST_HASH_STRING);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE(first_hash == string_hash);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_string_NULL_succeed)
+    {
+        //arrange
+
+        //act
+        uint32_t wy_result = hash_wyhash_string(NULL);
+        uint32_t xxh3_result = hash_xxh3_string(NULL);
+        uint32_t sip_result = hash_siphash_string(NULL);
+
+        //assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, (int)wy_result);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, (int)xxh3_result);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, (int)sip_result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+    CTEST_FUNCTION(hash_string_folds_64bit_hash_succeed)
+    {
+        //arrange
+        size_t key_len = strlen(TEST_HASH_STRING);
+        uint64_t wy_hash = hash_wyhash(TEST_HASH_STRING, key_len, 0);
+        uint64_t xxh3_hash = hash_xxh3(TEST_HASH_STRING, key_len, 0);
+
+        //act
+        uint32_t wy_result = hash_wyhash_string(TEST_HASH_STRING);
+        uint32_t xxh3_result = hash_xxh3_string(TEST_HASH_STRING);
+
+        //assert
+        CTEST_ASSERT_IS_TRUE((uint32_t)(wy_hash ^ (wy_hash >> 32)) == wy_result);
+        CTEST_ASSERT_IS_TRUE((uint32_t)(xxh3_hash ^ (xxh3_hash >> 32)) == xxh3_result);
+        CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+        //cleanup
+    }
+
+CTEST_END_TEST_SUITE(hash_functions_ut)
@@ -20,6 +20,11 @@ static void* my_mem_shim_malloc(size_t size)
     return malloc(size);
 }
 
+static void* my_mem_shim_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
 static void my_mem_shim_free(void* ptr)
 {
     free(ptr);
@@ -68,6 +73,8 @@ CTEST_SUITE_INITIALIZE()
 
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_realloc, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
 }
 
@@ -610,4 +617,545 @@ CTEST_FUNCTION(item_list_get_next_succeed)
     item_list_destroy(handle);
 }
 
+CTEST_FUNCTION(item_list_remove_item_tail_then_add_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create(item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    item_list_add_item(handle, TEST_ITEM_2);
+    (void)item_list_remove_item(handle, 1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = item_list_add_item(handle, TEST_ITEM_3);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 2, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_3, item_list_get_item(handle, 1), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_create_with_options_array_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+
+    // act
+    result = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 16, item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_item_count(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(result);
+}
+
+CTEST_FUNCTION(item_list_create_with_options_array_fail)
+{
+    // arrange
+    ITEM_LIST_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 16, item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_list_add_item_array_grows_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 2, item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    item_list_add_item(handle, TEST_ITEM_2);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int result = item_list_add_item(handle, TEST_ITEM_3);
+    int result_2 = item_list_add_item(handle, TEST_ITEM_4);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result_2);
+    CTEST_ASSERT_ARE_EQUAL(int, 4, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_add_item_array_grow_fail)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = item_list_add_item(handle, TEST_ITEM_1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_get_item_array_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    for (size_t index = 0; index < item_count; index++)
+    {
+        const void* result = item_list_get_item(handle, index);
+
+        // assert
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ARRAY[index], result, TEST_ITEM_SIZE));
+    }
+    CTEST_ASSERT_IS_NULL(item_list_get_item(handle, item_count));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_1, item_list_get_front(handle), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_remove_item_array_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    item_list_add_copy(handle, TEST_ITEM_1, TEST_ITEM_SIZE);
+    item_list_add_item(handle, TEST_ITEM_2);
+    item_list_add_copy(handle, TEST_ITEM_3, TEST_ITEM_SIZE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = item_list_remove_item(handle, 1);
+    int result_2 = item_list_remove_item(handle, 0);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result_2);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_3, item_list_get_item(handle, 0), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_get_next_array_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    ITERATOR_HANDLE iterator = item_list_iterator(handle);
+    umock_c_reset_all_calls();
+
+    // act
+    for (size_t index = 0; index < item_count; index++)
+    {
+        const unsigned char* item = item_list_get_next(handle, &iterator);
+
+        // assert
+        CTEST_ASSERT_IS_NOT_NULL(item);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(item, TEST_ARRAY[index], TEST_ITEM_SIZE));
+    }
+    CTEST_ASSERT_IS_NULL(item_list_get_next(handle, &iterator));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_get_next_array_after_remove_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    item_list_add_item(handle, TEST_ITEM_2);
+    item_list_add_item(handle, TEST_ITEM_3);
+    ITERATOR_HANDLE iterator = item_list_iterator(handle);
+    (void)item_list_get_next(handle, &iterator);
+    (void)item_list_get_next(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    (void)item_list_remove_item(handle, 0);
+    (void)item_list_remove_item(handle, 0);
+    const void* item = item_list_get_next(handle, &iterator);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(item);
+    CTEST_ASSERT_IS_NULL(iterator);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_clear_array_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    item_list_add_copy(handle, TEST_ITEM_2, TEST_ITEM_SIZE);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = item_list_clear(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_item_count(handle));
+    CTEST_ASSERT_IS_NULL(item_list_get_front(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_create_with_options_node_pool_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 4, item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(result);
+}
+
+CTEST_FUNCTION(item_list_create_with_options_node_pool_fail)
+{
+    // arrange
+    ITEM_LIST_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    result = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 4, item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_list_add_remove_node_pool_no_allocations_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 2, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    for (size_t index = 0; index < 3; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_add_item(handle, TEST_ITEM_1));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_add_item(handle, TEST_ITEM_2));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_remove_item(handle, 0));
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_2, item_list_get_front(handle), TEST_ITEM_SIZE));
+        (void)item_list_clear(handle);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_add_item_node_pool_grows_succeed)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 1, item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = item_list_add_item(handle, TEST_ITEM_2);
+    int result_2 = item_list_add_item(handle, TEST_ITEM_3);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result_2);
+    CTEST_ASSERT_ARE_EQUAL(int, 3, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_add_item_node_pool_fail)
+{
+    // arrange
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_NODE_POOL, 0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = item_list_add_item(handle, TEST_ITEM_1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_iterator_init_handle_NULL_fail)
+{
+    // arrange
+    ITEM_LIST_ITERATOR iterator;
+
+    // act
+    int result = item_list_iterator_init(NULL, &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_list_iterator_next_nested_succeed)
+{
+    // arrange
+    ITEM_LIST_ITERATOR outer;
+    ITEM_LIST_ITERATOR inner;
+    size_t visited = 0;
+    ITEM_LIST_HANDLE handle = item_list_create(item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_iterator_init(handle, &outer));
+    while (item_list_iterator_next(handle, &outer) != NULL)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_iterator_init(handle, &inner));
+        for (size_t index = 0; index < item_count; index++)
+        {
+            const void* item = item_list_iterator_next(handle, &inner);
+            CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ARRAY[index], item, TEST_ITEM_SIZE));
+            visited++;
+        }
+        CTEST_ASSERT_IS_NULL(item_list_iterator_next(handle, &inner));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, item_count*item_count, visited);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_iterator_remove_current_no_item_fail)
+{
+    // arrange
+    ITEM_LIST_ITERATOR iterator;
+    ITEM_LIST_HANDLE handle = item_list_create(item_destroy_callback, NULL);
+    item_list_add_item(handle, TEST_ITEM_1);
+    (void)item_list_iterator_init(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_list_iterator_remove_current(handle, &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_iterator_remove_current_succeed)
+{
+    // arrange
+    ITEM_LIST_ITERATOR iterator;
+    ITEM_LIST_HANDLE handle = item_list_create(item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    (void)item_list_iterator_init(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    // Removes the first, third and last items
+    for (size_t index = 0; index < item_count; index += 2)
+    {
+        STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, TEST_ARRAY[index]));
+        STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    }
+
+    // act
+    for (size_t index = 0; index < item_count; index++)
+    {
+        const void* item = item_list_iterator_next(handle, &iterator);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ARRAY[index], item, TEST_ITEM_SIZE));
+        if (index % 2 == 0)
+        {
+            CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_iterator_remove_current(handle, &iterator));
+        }
+    }
+    CTEST_ASSERT_IS_NULL(item_list_iterator_next(handle, &iterator));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 2, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_2, item_list_get_item(handle, 0), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_4, item_list_get_item(handle, 1), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_iterator_remove_current_array_succeed)
+{
+    // arrange
+    ITEM_LIST_ITERATOR iterator;
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    (void)item_list_iterator_init(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, TEST_ITEM_2));
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, TEST_ITEM_3));
+
+    // act
+    for (size_t index = 0; index < item_count; index++)
+    {
+        const void* item = item_list_iterator_next(handle, &iterator);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ARRAY[index], item, TEST_ITEM_SIZE));
+        if (index == 1 || index == 2)
+        {
+            CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_iterator_remove_current(handle, &iterator));
+        }
+    }
+    CTEST_ASSERT_IS_NULL(item_list_iterator_next(handle, &iterator));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 3, item_list_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_4, item_list_get_item(handle, 1), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
+CTEST_FUNCTION(item_list_iterator_remove_current_array_walk_stopped_succeed)
+{
+    // arrange
+    ITEM_LIST_ITERATOR iterator;
+    ITEM_LIST_HANDLE handle = item_list_create_with_options(ITEM_LIST_OPTION_ARRAY, 0, item_destroy_callback, NULL);
+    size_t item_count = sizeof(TEST_ARRAY)/sizeof(TEST_ARRAY[0]);
+    for (size_t index = 0; index < item_count; index++)
+    {
+        item_list_add_item(handle, TEST_ARRAY[index]);
+    }
+    (void)item_list_iterator_init(handle, &iterator);
+    (void)item_list_iterator_next(handle, &iterator);
+    (void)item_list_iterator_next(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(item_destroy_callback(IGNORED_ARG, TEST_ITEM_2));
+
+    // act
+    int result = item_list_iterator_remove_current(handle, &iterator);
+    const void* item = item_list_iterator_next(handle, &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_3, item, TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(int, item_count - 1, item_list_item_count(handle));
+    for (size_t index = 2; index < item_count; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ARRAY[index], item_list_get_item(handle, index - 1), TEST_ITEM_SIZE));
+    }
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_list_add_item(handle, TEST_ITEM_2));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_3, item_list_get_item(handle, 1), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(TEST_ITEM_2, item_list_get_item(handle, item_count - 1), TEST_ITEM_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_list_destroy(handle);
+}
+
 CTEST_END_TEST_SUITE(item_list_ut)
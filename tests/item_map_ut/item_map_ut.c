@@ -3,9 +3,13 @@
 #ifdef __cplusplus
 #include <cstdlib>
 #include <cstddef>
+#include <cstdio>
+#include <cstring>
 #else
 #include <stdlib.h>
 #include <stddef.h>
+#include <stdio.h>
+#include <string.h>
 #endif
 
 #include "ctest.h"
@@ -52,6 +56,12 @@ static void my_map_destroy_cb(void* user_ctx, const char* key, void* remove_valu
     (void)remove_value;
 }
 
+static uint32_t my_constant_hash(const char* key)
+{
+    (void)key;
+    return 42;
+}
+
 static int my_clone_string(char** target, const char* source)
 {
     size_t len = strlen(source);
@@ -387,6 +397,119 @@ CTEST_FUNCTION(item_map_get_item_not_found_fail)
     item_map_destroy(handle);
 }
 
+CTEST_FUNCTION(item_map_get_item_prehashed_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    const void* result = item_map_get_item_prehashed(NULL, "test_key", 8, 0, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_get_item_prehashed_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "aaaaaa", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "aaaba", &value_2, sizeof(int));
+    uint32_t hash = item_map_hash_key(handle, "aaaba");
+    umock_c_reset_all_calls();
+
+    // act
+    const int* result = (const int*)item_map_get_item_prehashed(handle, "aaaba", 5, hash, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_item_prehashed_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "test_key1", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "test_key2", &value_2, sizeof(int));
+    uint32_t hash = item_map_hash_key(handle, "test_key2");
+    size_t len = 0;
+    umock_c_reset_all_calls();
+
+    // act
+    const int* result = (const int*)item_map_get_item_prehashed(handle, "test_key2", 9, hash, &len);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(int), len);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_item_prehashed_wrong_length_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "test_key1", &value, sizeof(int));
+    uint32_t hash = item_map_hash_key(handle, "test_key1");
+    umock_c_reset_all_calls();
+
+    // act
+    const void* result = item_map_get_item_prehashed(handle, "test_key1", 8, hash, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_hash_key_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    uint32_t result = item_map_hash_key(NULL, "test_key");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, (int)result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_hash_key_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, my_constant_hash);
+    umock_c_reset_all_calls();
+
+    // act
+    uint32_t result = item_map_hash_key(handle, "test_key");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 42, (int)result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
 CTEST_FUNCTION(item_map_size_handle_NULL_fail)
 {
     // arrange
@@ -631,4 +754,1076 @@ CTEST_FUNCTION(item_map_clear_all_no_items_succeed)
     item_map_destroy(handle);
 }
 
+CTEST_FUNCTION(item_map_create_with_options_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, item_map_size(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(result);
+}
+
+CTEST_FUNCTION(item_map_create_with_options_open_addressing_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE result;
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        if (umock_c_negative_tests_can_call_fail(index))
+        {
+            umock_c_negative_tests_reset();
+            umock_c_negative_tests_fail_call(index);
+
+            // act
+            result = item_map_create_with_options(20, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+
+            // assert
+            CTEST_ASSERT_IS_NULL(result);
+        }
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(item_map_add_item_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    setup_item_map_add_item_mocks();
+
+    // act
+    int value = 22;
+    int result = item_map_add_item(handle, "test_key", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_open_addressing_grow_succeed)
+{
+    // arrange
+    char key[32];
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    for (int index = 0; index < 500; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_map_add_item(handle, key, &index, sizeof(int)));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 500, item_map_size(handle));
+    for (int index = 0; index < 500; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        const int* result = (const int*)item_map_get_item(handle, key);
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(int, index, *result);
+    }
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_item_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "test_key1", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "test_key2", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    const int* result = (const int*)item_map_get_item(handle, "test_key2");
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *result);
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "test_key3"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_item_open_addressing_same_hash_succeed)
+{
+    // arrange
+    char key[32];
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, my_constant_hash);
+    for (int index = 0; index < 100; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        (void)item_map_add_item(handle, key, &index, sizeof(int));
+    }
+    for (int index = 0; index < 100; index += 2)
+    {
+        sprintf(key, "test_key_%d", index);
+        (void)item_map_remove_item(handle, key);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    for (int index = 0; index < 100; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        const int* result = (const int*)item_map_get_item(handle, key);
+
+        // assert
+        if (index % 2 == 0)
+        {
+            CTEST_ASSERT_IS_NULL(result);
+        }
+        else
+        {
+            CTEST_ASSERT_IS_NOT_NULL(result);
+            CTEST_ASSERT_ARE_EQUAL(int, index, *result);
+        }
+    }
+    CTEST_ASSERT_ARE_EQUAL(size_t, 50, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_remove_item_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "sunny_day", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = item_map_remove_item(handle, "rainy_day");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, item_map_size(handle));
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "rainy_day"));
+    CTEST_ASSERT_IS_NOT_NULL(item_map_get_item(handle, "sunny_day"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_clear_all_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "aaaaaa", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "aaaba", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = item_map_clear_all(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, item_map_size(handle));
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "aaaaaa"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_inline_storage_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int value = 22;
+    int result = item_map_add_item(handle, "test_key", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, value, *(const int*)item_map_get_item(handle, "test_key"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_inline_storage_no_alloc_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE | ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "test_key1", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    int value_2 = 77;
+    int result = item_map_add_item(handle, "test_key2", &value_2, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, value, *(const int*)item_map_get_item(handle, "test_key1"));
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *(const int*)item_map_get_item(handle, "test_key2"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_inline_storage_long_key_succeed)
+{
+    // arrange
+    const char* long_key = "a_key_that_is_much_too_long_to_fit_in_the_inline_storage_of_an_entry";
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+
+    // act
+    int value = 22;
+    int result = item_map_add_item(handle, long_key, &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, value, *(const int*)item_map_get_item(handle, long_key));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_inline_storage_large_value_succeed)
+{
+    // arrange
+    unsigned char large_value[128] = { 0 };
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(sizeof(large_value)));
+
+    // act
+    int result = item_map_add_item(handle, "test_key", large_value, sizeof(large_value));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(item_map_get_item(handle, "test_key"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_item_inline_storage_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int value = 22;
+    int result = item_map_add_item(handle, "test_key", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_remove_item_inline_storage_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "sunny_day", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_remove_item(handle, "rainy_day");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 1, item_map_size(handle));
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "rainy_day"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_destroy_inline_storage_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "sunny_day", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    item_map_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_add_item_power_of_two_succeed)
+{
+    // arrange
+    char key[32];
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_POWER_OF_TWO, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    for (int index = 0; index < 200; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, item_map_add_item(handle, key, &index, sizeof(int)));
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 200, item_map_size(handle));
+    for (int index = 0; index < 200; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        const int* result = (const int*)item_map_get_item(handle, key);
+        CTEST_ASSERT_IS_NOT_NULL(result);
+        CTEST_ASSERT_ARE_EQUAL(int, index, *result);
+    }
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_remove_item_power_of_two_collision_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_POWER_OF_TWO, map_destroy_callback, NULL, my_constant_hash);
+    int value = 22;
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "sunny_day", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_remove_item(handle, "rainy_day");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "rainy_day"));
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *(const int*)item_map_get_item(handle, "sunny_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_batch_handle_NULL_fail)
+{
+    // arrange
+    const char* keys[] = { "test_key1" };
+    int value = 22;
+    const void* values[] = { &value };
+    size_t lens[] = { sizeof(int) };
+
+    // act
+    int result = item_map_add_batch(NULL, keys, values, lens, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_add_batch_invalid_item_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    const char* keys[] = { "test_key1", NULL };
+    int value = 22;
+    const void* values[] = { &value, &value };
+    size_t lens[] = { sizeof(int), sizeof(int) };
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_add_batch(handle, keys, values, lens, 2);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_batch_succeed)
+{
+    // arrange
+    char key_buffer[40][32];
+    const char* keys[40];
+    int items[40];
+    const void* values[40];
+    size_t lens[40];
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    for (int index = 0; index < 40; index++)
+    {
+        sprintf(key_buffer[index], "test_key_%d", index);
+        keys[index] = key_buffer[index];
+        items[index] = index;
+        values[index] = &items[index];
+        lens[index] = sizeof(int);
+    }
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_add_batch(handle, keys, values, lens, 40);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 40, item_map_size(handle));
+    for (int index = 0; index < 40; index++)
+    {
+        const int* item = (const int*)item_map_get_item(handle, keys[index]);
+        CTEST_ASSERT_IS_NOT_NULL(item);
+        CTEST_ASSERT_ARE_EQUAL(int, index, *item);
+    }
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_batch_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    const char* keys[] = { "test_key1", "test_key2" };
+    int value = 22;
+    const void* values[] = { &value, &value };
+    size_t lens[] = { sizeof(int), sizeof(int) };
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = item_map_add_batch(handle, keys, values, lens, 2);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_batch_handle_NULL_fail)
+{
+    // arrange
+    const char* keys[] = { "test_key1" };
+    const void* values[1];
+
+    // act
+    size_t result = item_map_get_batch(NULL, keys, 1, values);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_get_batch_succeed)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    int value = 22;
+    (void)item_map_add_item(handle, "test_key1", &value, sizeof(int));
+    int value_2 = 77;
+    (void)item_map_add_item(handle, "test_key2", &value_2, sizeof(int));
+    const char* keys[] = { "test_key2", "missing_key", "test_key1" };
+    const void* values[3];
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = item_map_get_batch(handle, keys, 3, values);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 2, result);
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *(const int*)values[0]);
+    CTEST_ASSERT_IS_NULL(values[1]);
+    CTEST_ASSERT_ARE_EQUAL(int, value, *(const int*)values[2]);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_batch_open_addressing_succeed)
+{
+    // arrange
+    char key_buffer[100][32];
+    const char* keys[101];
+    const void* values[101];
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    for (int index = 0; index < 100; index++)
+    {
+        sprintf(key_buffer[index], "test_key_%d", index);
+        keys[index] = key_buffer[index];
+        (void)item_map_add_item(handle, keys[index], &index, sizeof(int));
+    }
+    keys[100] = "missing_key";
+    umock_c_reset_all_calls();
+
+    // act
+    size_t result = item_map_get_batch(handle, keys, 101, values);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 100, result);
+    for (int index = 0; index < 100; index++)
+    {
+        CTEST_ASSERT_IS_NOT_NULL(values[index]);
+        CTEST_ASSERT_ARE_EQUAL(int, index, *(const int*)values[index]);
+    }
+    CTEST_ASSERT_IS_NULL(values[100]);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_borrowed_item_handle_NULL_fail)
+{
+    // arrange
+    int value = 22;
+
+    // act
+    int result = item_map_add_borrowed_item(NULL, "test_key", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_add_borrowed_item_value_NULL_fail)
+{
+    // arrange
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_add_borrowed_item(handle, "test_key", NULL, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_borrowed_item_succeed)
+{
+    // arrange
+    const char* key = "rainy_day";
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = item_map_add_borrowed_item(handle, key, &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &value, item_map_get_item(handle, "rainy_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_add_borrowed_item_fail)
+{
+    // arrange
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = item_map_add_borrowed_item(handle, "rainy_day", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, item_map_size(handle));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_remove_borrowed_item_succeed)
+{
+    // arrange
+    const char* key = "rainy_day";
+    int value = 22;
+    int value_2 = 77;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_borrowed_item(handle, key, &value, sizeof(int));
+    (void)item_map_add_item(handle, "sunny_day", &value_2, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(map_destroy_callback(NULL, key, &value));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    int result = item_map_remove_item(handle, "rainy_day");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_destroy_borrowed_item_no_callback_succeed)
+{
+    // arrange
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, NULL, NULL, NULL);
+    (void)item_map_add_borrowed_item(handle, "rainy_day", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    item_map_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_remove_borrowed_item_open_addressing_succeed)
+{
+    // arrange
+    const char* key = "rainy_day";
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_borrowed_item(handle, key, &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(map_destroy_callback(NULL, key, &value));
+
+    // act
+    int result = item_map_remove_item(handle, "rainy_day");
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, item_map_size(handle));
+    CTEST_ASSERT_IS_NULL(item_map_get_item(handle, "rainy_day"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_upsert_handle_NULL_fail)
+{
+    // arrange
+    int value = 22;
+
+    // act
+    int result = item_map_upsert(NULL, "test_key", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_upsert_new_item_succeed)
+{
+    // arrange
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = item_map_upsert(handle, "rainy_day", &value, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_upsert_existing_item_succeed)
+{
+    // arrange
+    int value = 22;
+    int value_2 = 77;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    int result = item_map_upsert(handle, "rainy_day", &value_2, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, item_map_size(handle));
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *(const int*)item_map_get_item(handle, "rainy_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_upsert_larger_value_succeed)
+{
+    // arrange
+    int value = 22;
+    int64_t value_2 = 77;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = item_map_upsert(handle, "rainy_day", &value_2, sizeof(int64_t));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_IS_TRUE(value_2 == *(const int64_t*)item_map_get_item(handle, "rainy_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_upsert_borrowed_item_succeed)
+{
+    // arrange
+    const char* key = "rainy_day";
+    int value = 22;
+    int value_2 = 77;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_borrowed_item(handle, key, &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(map_destroy_callback(NULL, key, &value));
+
+    // act
+    int result = item_map_upsert(handle, "rainy_day", &value_2, sizeof(int));
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(int, value_2, *(const int*)item_map_get_item(handle, "rainy_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_upsert_fail)
+{
+    // arrange
+    int value = 22;
+    int64_t value_2 = 77;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_item(handle, "rainy_day", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = item_map_upsert(handle, "rainy_day", &value_2, sizeof(int64_t));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    CTEST_ASSERT_ARE_EQUAL(int, value, *(const int*)item_map_get_item(handle, "rainy_day"));
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_or_insert_handle_NULL_fail)
+{
+    // arrange
+    bool inserted;
+
+    // act
+    void* result = item_map_get_or_insert(NULL, "test_key", sizeof(int), &inserted);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_get_or_insert_new_item_succeed)
+{
+    // arrange
+    bool inserted = false;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING, map_destroy_callback, NULL, NULL);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(clone_string(IGNORED_ARG, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int* result = (int*)item_map_get_or_insert(handle, "counter", sizeof(int), &inserted);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_IS_TRUE(inserted);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, *result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_or_insert_existing_item_succeed)
+{
+    // arrange
+    bool inserted = true;
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_item(handle, "counter", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    int* result = (int*)item_map_get_or_insert(handle, "counter", sizeof(int), &inserted);
+    (*result)++;
+
+    // assert
+    CTEST_ASSERT_IS_FALSE(inserted);
+    CTEST_ASSERT_ARE_EQUAL(int, 23, *(const int*)item_map_get_item(handle, "counter"));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_or_insert_existing_item_too_small_fail)
+{
+    // arrange
+    int value = 22;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_add_item(handle, "counter", &value, sizeof(int));
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = item_map_get_or_insert(handle, "counter", sizeof(int64_t), NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_iterator_handle_NULL_fail)
+{
+    // arrange
+    ITEM_MAP_ITERATOR iterator;
+
+    // act
+    int result = item_map_iterator(NULL, &iterator);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(item_map_get_next_empty_map_succeed)
+{
+    // arrange
+    ITEM_MAP_ITERATOR iterator;
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, NULL);
+    (void)item_map_iterator(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    const void* result = item_map_get_next(handle, &iterator, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_next_succeed)
+{
+    // arrange
+    ITEM_MAP_ITERATOR iterator;
+    const char* key;
+    size_t len;
+    int found[5] = { 0 };
+    ITEM_MAP_HANDLE handle = item_map_create(10, map_destroy_callback, NULL, my_constant_hash);
+    for (size_t index = 0; index < 5; index++)
+    {
+        char item_key[16];
+        sprintf(item_key, "key_%d", (int)index);
+        (void)item_map_add_item(handle, item_key, TEST_ARRAY[index], TEST_ITEM_SIZE);
+    }
+    (void)item_map_iterator(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    const unsigned char* item;
+    while ((item = (const unsigned char*)item_map_get_next(handle, &iterator, &key, &len)) != NULL)
+    {
+        int index = key[4] - '0';
+        CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_SIZE, len);
+        CTEST_ASSERT_ARE_EQUAL(int, 0, memcmp(item, TEST_ARRAY[index], TEST_ITEM_SIZE));
+        found[index]++;
+    }
+
+    // assert
+    for (size_t index = 0; index < 5; index++)
+    {
+        CTEST_ASSERT_ARE_EQUAL(int, 1, found[index]);
+    }
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
+CTEST_FUNCTION(item_map_get_next_open_addressing_succeed)
+{
+    // arrange
+    ITEM_MAP_ITERATOR iterator;
+    char key[32];
+    size_t count = 0;
+    int sum = 0;
+    ITEM_MAP_HANDLE handle = item_map_create_with_options(10, ITEM_MAP_OPTION_OPEN_ADDRESSING | ITEM_MAP_OPTION_INLINE_STORAGE, map_destroy_callback, NULL, NULL);
+    for (int index = 0; index < 200; index++)
+    {
+        sprintf(key, "test_key_%d", index);
+        (void)item_map_add_item(handle, key, &index, sizeof(int));
+    }
+    (void)item_map_iterator(handle, &iterator);
+    umock_c_reset_all_calls();
+
+    // act
+    const int* item;
+    while ((item = (const int*)item_map_get_next(handle, &iterator, NULL, NULL)) != NULL)
+    {
+        sum += *item;
+        count++;
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 200, count);
+    CTEST_ASSERT_ARE_EQUAL(int, 199*200/2, sum);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    item_map_destroy(handle);
+}
+
 CTEST_END_TEST_SUITE(item_map_ut)
@@ -82,6 +82,8 @@ CTEST_SUITE_INITIALIZE()
     result = umocktypes_charptr_register_types();
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
 
+    REGISTER_UMOCK_ALIAS_TYPE(pthread_mutex_t*, void*);
+
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
     REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
     REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
@@ -114,11 +116,26 @@ CTEST_FUNCTION_CLEANUP()
 {
 }
 
+CTEST_FUNCTION(mutex_mgr_create_handle_NULL_fail)
+{
+    //arrange
+
+    //act
+    int result = mutex_mgr_create(NULL);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
 CTEST_FUNCTION(mutex_mgr_create_succeed)
 {
     MUTEX_HANDLE handle;
 
     //arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(pthread_mutex_init(IGNORED_ARG, IGNORED_ARG));
 
     //act
@@ -126,6 +143,26 @@ CTEST_FUNCTION(mutex_mgr_create_succeed)
 
     //assert
     CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(handle);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+    mutex_mgr_destroy(handle);
+}
+
+CTEST_FUNCTION(mutex_mgr_create_malloc_fail)
+{
+    MUTEX_HANDLE handle;
+
+    //arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    //act
+    int result = mutex_mgr_create(&handle);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(handle);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     //cleanup
@@ -137,19 +174,35 @@ CTEST_FUNCTION(mutex_mgr_create_fail)
     MUTEX_HANDLE handle;
 
     //arrange
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
     STRICT_EXPECTED_CALL(pthread_mutex_init(IGNORED_ARG, IGNORED_ARG)).SetReturn(-1);
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
 
     //act
     int result = mutex_mgr_create(&handle);
 
     //assert
     CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(handle);
     CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
 
     //cleanup
     mutex_mgr_destroy(handle);
 }
 
+CTEST_FUNCTION(mutex_mgr_destroy_handle_NULL_succeed)
+{
+    //arrange
+
+    //act
+    mutex_mgr_destroy(NULL);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
 CTEST_FUNCTION(mutex_mgr_destroy_succeed)
 {
     MUTEX_HANDLE handle;
@@ -157,7 +210,8 @@ CTEST_FUNCTION(mutex_mgr_destroy_succeed)
     umock_c_reset_all_calls();
 
     //arrange
-    STRICT_EXPECTED_CALL(pthread_mutex_destroy(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(pthread_mutex_destroy(handle));
+    STRICT_EXPECTED_CALL(free(handle));
 
     //act
     mutex_mgr_destroy(handle);
@@ -168,6 +222,30 @@ CTEST_FUNCTION(mutex_mgr_destroy_succeed)
     //cleanup
 }
 
+CTEST_FUNCTION(mutex_mgr_lock_copied_handle_succeed)
+{
+    MUTEX_HANDLE handle;
+    mutex_mgr_create(&handle);
+    MUTEX_HANDLE handle_copy = handle;
+    umock_c_reset_all_calls();
+
+    //arrange
+    STRICT_EXPECTED_CALL(pthread_mutex_lock(handle));
+    STRICT_EXPECTED_CALL(pthread_mutex_unlock(handle));
+
+    //act
+    int lock_result = mutex_mgr_lock(handle_copy);
+    int unlock_result = mutex_mgr_unlock(handle);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, lock_result);
+    CTEST_ASSERT_ARE_EQUAL(int, 0, unlock_result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+    mutex_mgr_destroy(handle);
+}
+
 CTEST_FUNCTION(mutex_mgr_lock_succeed)
 {
     MUTEX_HANDLE handle;
@@ -80,7 +80,7 @@ CTEST_FUNCTION(mutex_mgr_create_succeed)
     MUTEX_HANDLE handle;
 
     //arrange
-    STRICT_EXPECTED_CALL(CreateMutex(IGNORED_ARG, TRUE, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(CreateMutex(IGNORED_ARG, FALSE, IGNORED_ARG));
 
     //act
     int result = mutex_mgr_create(&handle);
@@ -98,7 +98,7 @@ CTEST_FUNCTION(mutex_mgr_create_fail)
     MUTEX_HANDLE handle;
 
     //arrange
-    STRICT_EXPECTED_CALL(CreateMutex(IGNORED_ARG, TRUE, IGNORED_ARG)).SetReturn(NULL);
+    STRICT_EXPECTED_CALL(CreateMutex(IGNORED_ARG, FALSE, IGNORED_ARG)).SetReturn(NULL);
 
     //act
     int result = mutex_mgr_create(&handle);
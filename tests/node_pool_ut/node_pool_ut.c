@@ -0,0 +1,288 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/node_pool.h"
+
+// The link sits after the key so the offset handling is exercised
+typedef struct TEST_NODE_TAG
+{
+    uint64_t key;
+    struct TEST_NODE_TAG* next;
+    uint32_t value;
+} TEST_NODE;
+
+#define TEST_SLAB_COUNT         4
+#define TEST_MIN_SLAB_NODES     16
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(node_pool_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(node_pool_init_succeed)
+{
+    // arrange
+    NODE_POOL pool;
+
+    // act
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    // assert
+    CTEST_ASSERT_IS_NULL(pool.slab_list);
+    CTEST_ASSERT_IS_NULL(pool.free_nodes);
+    CTEST_ASSERT_ARE_EQUAL(size_t, sizeof(TEST_NODE), pool.node_size);
+    CTEST_ASSERT_ARE_EQUAL(size_t, offsetof(TEST_NODE, next), pool.link_offset);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_reserve_pool_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = node_pool_reserve(NULL, TEST_SLAB_COUNT);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(node_pool_reserve_too_large_fail)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    // act
+    int result = node_pool_reserve(&pool, SIZE_MAX/sizeof(TEST_NODE));
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(pool.slab_list);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_reserve_malloc_fail)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    int result = node_pool_reserve(&pool, TEST_SLAB_COUNT);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NULL(pool.free_nodes);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_reserve_succeed)
+{
+    // arrange
+    NODE_POOL pool;
+    TEST_NODE* nodes[TEST_SLAB_COUNT];
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = node_pool_reserve(&pool, TEST_SLAB_COUNT);
+    for (size_t index = 0; index < TEST_SLAB_COUNT; index++)
+    {
+        nodes[index] = (TEST_NODE*)node_pool_allocate(&pool);
+    }
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    for (size_t index = 0; index < TEST_SLAB_COUNT; index++)
+    {
+        // Nodes come out in address order
+        CTEST_ASSERT_IS_TRUE(index == 0 || nodes[index] == nodes[index - 1] + 1);
+    }
+    CTEST_ASSERT_IS_NULL(pool.free_nodes);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_allocate_pool_NULL_fail)
+{
+    // arrange
+
+    // act
+    void* result = node_pool_allocate(NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(node_pool_allocate_grows_slab_succeed)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    for (size_t index = 0; index < TEST_MIN_SLAB_NODES + 1; index++)
+    {
+        TEST_NODE* node = (TEST_NODE*)node_pool_allocate(&pool);
+        CTEST_ASSERT_IS_NOT_NULL(node);
+        node->key = index;
+    }
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(pool.free_nodes);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_allocate_malloc_fail)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG)).SetReturn(NULL);
+
+    // act
+    void* result = node_pool_allocate(&pool);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_release_reuse_succeed)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+    (void)node_pool_reserve(&pool, TEST_SLAB_COUNT);
+    TEST_NODE* node = (TEST_NODE*)node_pool_allocate(&pool);
+    node->key = 0x1234;
+    node->value = 0x5678;
+    umock_c_reset_all_calls();
+
+    // act
+    node_pool_release(&pool, node);
+    TEST_NODE* result = (TEST_NODE*)node_pool_allocate(&pool);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, node, result);
+    // Only the link is written while the node sits on the free list
+    CTEST_ASSERT_ARE_EQUAL(int, 0x1234, (int)result->key);
+    CTEST_ASSERT_ARE_EQUAL(int, 0x5678, (int)result->value);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    node_pool_deinit(&pool);
+}
+
+CTEST_FUNCTION(node_pool_deinit_succeed)
+{
+    // arrange
+    NODE_POOL pool;
+    node_pool_init(&pool, sizeof(TEST_NODE), offsetof(TEST_NODE, next));
+    (void)node_pool_reserve(&pool, TEST_SLAB_COUNT);
+    (void)node_pool_reserve(&pool, TEST_SLAB_COUNT);
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    node_pool_deinit(&pool);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(pool.slab_list);
+    CTEST_ASSERT_IS_NULL(pool.free_nodes);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_END_TEST_SUITE(node_pool_ut)
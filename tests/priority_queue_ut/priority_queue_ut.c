@@ -0,0 +1,648 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstdint>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <stdint.h>
+#endif
+
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umock_c_negative_tests.h"
+#include "umock_c/umocktypes_charptr.h"
+
+static void* my_mem_shim_malloc(size_t size)
+{
+    return malloc(size);
+}
+
+static void* my_mem_shim_realloc(void* ptr, size_t size)
+{
+    return realloc(ptr, size);
+}
+
+static void my_mem_shim_free(void* ptr)
+{
+    free(ptr);
+}
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+#include "lib-util-c/sys_debug_shim.h"
+
+MOCKABLE_FUNCTION(, void, item_destroy_callback, void*, user_ctx, void*, item);
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/priority_queue.h"
+
+static int TEST_ITEM_1 = 1;
+static int TEST_ITEM_2 = 2;
+static int TEST_ITEM_3 = 3;
+static int TEST_ITEM_4 = 4;
+static int TEST_ITEM_5 = 5;
+
+static void* TEST_ITEMS[] = { &TEST_ITEM_3, &TEST_ITEM_5, &TEST_ITEM_1, &TEST_ITEM_4, &TEST_ITEM_2 };
+static const uint64_t TEST_PRIORITIES[] = { 30, 50, 10, 40, 20 };
+#define TEST_ITEM_COUNT     5
+
+static void my_item_destroy_cb(void* user_ctx, void* item)
+{
+    (void)user_ctx;
+    (void)item;
+}
+
+static void push_test_items(PRIORITY_QUEUE_HANDLE handle, PRIORITY_QUEUE_ENTRY_HANDLE* entries)
+{
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        (void)priority_queue_push(handle, TEST_PRIORITIES[index], TEST_ITEMS[index], entries == NULL ? NULL : &entries[index]);
+    }
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(priority_queue_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    umock_c_init(on_umock_c_error);
+
+    REGISTER_UMOCK_ALIAS_TYPE(PRIORITY_QUEUE_HANDLE, void*);
+    REGISTER_UMOCK_ALIAS_TYPE(PRIORITY_QUEUE_ENTRY_HANDLE, void*);
+
+    REGISTER_GLOBAL_MOCK_HOOK(item_destroy_callback, my_item_destroy_cb);
+
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_malloc, my_mem_shim_malloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_malloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_realloc, my_mem_shim_realloc);
+    REGISTER_GLOBAL_MOCK_FAIL_RETURN(mem_shim_realloc, NULL);
+    REGISTER_GLOBAL_MOCK_HOOK(mem_shim_free, my_mem_shim_free);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(priority_queue_create_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = priority_queue_create(0, item_destroy_callback, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, priority_queue_item_count(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(result);
+}
+
+CTEST_FUNCTION(priority_queue_create_capacity_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE result;
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    result = priority_queue_create(TEST_ITEM_COUNT, item_destroy_callback, NULL);
+    push_test_items(result, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NOT_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, priority_queue_item_count(result));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(result);
+}
+
+CTEST_FUNCTION(priority_queue_create_fail)
+{
+    // arrange
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
+
+        // act
+        PRIORITY_QUEUE_HANDLE result = priority_queue_create(TEST_ITEM_COUNT, item_destroy_callback, NULL);
+
+        // assert
+        CTEST_ASSERT_IS_NULL(result);
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+}
+
+CTEST_FUNCTION(priority_queue_destroy_handle_NULL_succeed)
+{
+    // arrange
+
+    // act
+    priority_queue_destroy(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_destroy_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    push_test_items(handle, NULL);
+    umock_c_reset_all_calls();
+
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        STRICT_EXPECTED_CALL(item_destroy_callback(NULL, IGNORED_ARG));
+    }
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+    STRICT_EXPECTED_CALL(free(IGNORED_ARG));
+
+    // act
+    priority_queue_destroy(handle);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_push_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = priority_queue_push(NULL, 1, &TEST_ITEM_1, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_push_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entry = NULL;
+    uint64_t priority = 0;
+    umock_c_reset_all_calls();
+
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    // act
+    int result = priority_queue_push(handle, 7, &TEST_ITEM_1, &entry);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_NOT_NULL(entry);
+    CTEST_ASSERT_ARE_EQUAL(size_t, 1, priority_queue_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, priority_queue_peek(handle, &priority));
+    CTEST_ASSERT_ARE_EQUAL(int, 7, (int)priority);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_push_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
+
+        // act
+        int result = priority_queue_push(handle, 1, &TEST_ITEM_1, NULL);
+
+        // assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, priority_queue_item_count(handle));
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_pop_handle_NULL_fail)
+{
+    // arrange
+    void* item;
+
+    // act
+    int result = priority_queue_pop(NULL, &item, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_pop_item_NULL_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    push_test_items(handle, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_pop(handle, NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, priority_queue_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_pop_empty_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    void* item;
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_pop(handle, &item, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_pop_priority_order_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    int* expected[] = { &TEST_ITEM_1, &TEST_ITEM_2, &TEST_ITEM_3, &TEST_ITEM_4, &TEST_ITEM_5 };
+    push_test_items(handle, NULL);
+    umock_c_reset_all_calls();
+
+    for (size_t index = 0; index < TEST_ITEM_COUNT; index++)
+    {
+        void* item;
+        uint64_t priority;
+
+        // act
+        int result = priority_queue_pop(handle, &item, &priority);
+
+        // assert
+        CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, expected[index], item);
+        CTEST_ASSERT_ARE_EQUAL(int, (int)(index + 1)*10, (int)priority);
+    }
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, priority_queue_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_pop_reuses_entry_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    void* item;
+    push_test_items(handle, NULL);
+    (void)priority_queue_pop(handle, &item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_push(handle, 1, &TEST_ITEM_1, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, priority_queue_peek(handle, NULL));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_peek_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    void* result = priority_queue_peek(NULL, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_peek_empty_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = priority_queue_peek(handle, NULL);
+
+    // assert
+    CTEST_ASSERT_IS_NULL(result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_peek_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    uint64_t priority;
+    push_test_items(handle, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    void* result = priority_queue_peek(handle, &priority);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, result);
+    CTEST_ASSERT_ARE_EQUAL(int, 10, (int)priority);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT, priority_queue_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_decrease_key_handle_NULL_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[TEST_ITEM_COUNT];
+    push_test_items(handle, entries);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_decrease_key(NULL, entries[0], 1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_decrease_key_entry_NULL_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    push_test_items(handle, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_decrease_key(handle, NULL, 1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_decrease_key_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[TEST_ITEM_COUNT];
+    uint64_t priority;
+    push_test_items(handle, entries);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_decrease_key(handle, entries[1], 5);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_5, priority_queue_peek(handle, &priority));
+    CTEST_ASSERT_ARE_EQUAL(int, 5, (int)priority);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_decrease_key_higher_priority_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[TEST_ITEM_COUNT];
+    push_test_items(handle, entries);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_decrease_key(handle, entries[2], 60);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_1, priority_queue_peek(handle, NULL));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_decrease_key_popped_entry_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[TEST_ITEM_COUNT];
+    void* item;
+    push_test_items(handle, entries);
+    (void)priority_queue_pop(handle, &item, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_decrease_key(handle, entries[2], 1);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(void_ptr, &TEST_ITEM_2, priority_queue_peek(handle, NULL));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_heapify_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    int result = priority_queue_heapify(NULL, TEST_PRIORITIES, TEST_ITEMS, TEST_ITEM_COUNT, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_FUNCTION(priority_queue_heapify_items_NULL_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_heapify(handle, TEST_PRIORITIES, NULL, TEST_ITEM_COUNT, NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_heapify_succeed)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    PRIORITY_QUEUE_ENTRY_HANDLE entries[TEST_ITEM_COUNT];
+    int* expected[] = { &TEST_ITEM_5, &TEST_ITEM_1, &TEST_ITEM_2, &TEST_ITEM_1, &TEST_ITEM_3, &TEST_ITEM_4 };
+    (void)priority_queue_push(handle, 25, &TEST_ITEM_1, NULL);
+    umock_c_reset_all_calls();
+
+    // act
+    int result = priority_queue_heapify(handle, TEST_PRIORITIES, TEST_ITEMS, TEST_ITEM_COUNT, entries);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(size_t, TEST_ITEM_COUNT + 1, priority_queue_item_count(handle));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+    // The returned entries follow the order of the items passed in
+    CTEST_ASSERT_ARE_EQUAL(int, 0, priority_queue_decrease_key(handle, entries[1], 1));
+    for (size_t index = 0; index < TEST_ITEM_COUNT + 1; index++)
+    {
+        void* item;
+        CTEST_ASSERT_ARE_EQUAL(int, 0, priority_queue_pop(handle, &item, NULL));
+        CTEST_ASSERT_ARE_EQUAL(void_ptr, expected[index], item);
+    }
+
+    // cleanup
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_heapify_fail)
+{
+    // arrange
+    PRIORITY_QUEUE_HANDLE handle = priority_queue_create(0, item_destroy_callback, NULL);
+    umock_c_reset_all_calls();
+
+    int negativeTestsInitResult = umock_c_negative_tests_init();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, negativeTestsInitResult);
+
+    STRICT_EXPECTED_CALL(realloc(NULL, IGNORED_ARG));
+    STRICT_EXPECTED_CALL(malloc(IGNORED_ARG));
+
+    umock_c_negative_tests_snapshot();
+
+    size_t count = umock_c_negative_tests_call_count();
+    for (size_t index = 0; index < count; index++)
+    {
+        umock_c_negative_tests_reset();
+        umock_c_negative_tests_fail_call(index);
+
+        // act
+        int result = priority_queue_heapify(handle, TEST_PRIORITIES, TEST_ITEMS, TEST_ITEM_COUNT, NULL);
+
+        // assert
+        CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+        CTEST_ASSERT_ARE_EQUAL(size_t, 0, priority_queue_item_count(handle));
+    }
+
+    // cleanup
+    umock_c_negative_tests_deinit();
+    priority_queue_destroy(handle);
+}
+
+CTEST_FUNCTION(priority_queue_item_count_handle_NULL_fail)
+{
+    // arrange
+
+    // act
+    size_t result = priority_queue_item_count(NULL);
+
+    // assert
+    CTEST_ASSERT_ARE_EQUAL(size_t, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    // cleanup
+}
+
+CTEST_END_TEST_SUITE(priority_queue_ut)
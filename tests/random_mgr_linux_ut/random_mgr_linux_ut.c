@@ -0,0 +1,206 @@
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+
+#ifdef __cplusplus
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#else
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#endif
+
+#include <sys/types.h>
+#include <errno.h>
+
+// Include the test tools.
+#include "ctest.h"
+#include "macro_utils/macro_utils.h"
+
+#include "umock_c/umock_c.h"
+#include "umock_c/umocktypes_charptr.h"
+
+#define ENABLE_MOCKS
+#include "umock_c/umock_c_prod.h"
+
+MOCKABLE_FUNCTION(, ssize_t, getrandom, void*, buffer, size_t, length, unsigned int, flags);
+#undef ENABLE_MOCKS
+
+#include "lib-util-c/random_mgr.h"
+
+#define TEST_RANDOM_BYTE        0xA5
+#define TEST_BUFFER_SIZE        16
+#define TEST_SHORT_READ_SIZE    10
+
+static int g_getrandom_errno;
+
+static ssize_t my_getrandom(void* buffer, size_t length, unsigned int flags)
+{
+    ssize_t result;
+    (void)flags;
+    if (g_getrandom_errno != 0)
+    {
+        errno = g_getrandom_errno;
+        g_getrandom_errno = 0;
+        result = -1;
+    }
+    else
+    {
+        memset(buffer, TEST_RANDOM_BYTE, length);
+        result = (ssize_t)length;
+    }
+    return result;
+}
+
+static int is_filled(const unsigned char* buffer, size_t len)
+{
+    int result = 1;
+    for (size_t index = 0; index < len; index++)
+    {
+        if (buffer[index] != TEST_RANDOM_BYTE)
+        {
+            result = 0;
+        }
+    }
+    return result;
+}
+
+MU_DEFINE_ENUM_STRINGS(UMOCK_C_ERROR_CODE, UMOCK_C_ERROR_CODE_VALUES)
+static void on_umock_c_error(UMOCK_C_ERROR_CODE error_code)
+{
+    CTEST_ASSERT_FAIL("umock_c reported error :%s", MU_ENUM_TO_STRING(UMOCK_C_ERROR_CODE, error_code));
+}
+
+CTEST_BEGIN_TEST_SUITE(random_mgr_linux_ut)
+
+CTEST_SUITE_INITIALIZE()
+{
+    int result;
+
+    (void)umock_c_init(on_umock_c_error);
+
+    result = umocktypes_charptr_register_types();
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+
+    REGISTER_UMOCK_ALIAS_TYPE(ssize_t, long);
+
+    REGISTER_GLOBAL_MOCK_HOOK(getrandom, my_getrandom);
+}
+
+CTEST_SUITE_CLEANUP()
+{
+    umock_c_deinit();
+}
+
+CTEST_FUNCTION_INITIALIZE()
+{
+    g_getrandom_errno = 0;
+    umock_c_reset_all_calls();
+}
+
+CTEST_FUNCTION_CLEANUP()
+{
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_buffer_NULL_fail)
+{
+    //arrange
+
+    //act
+    int result = random_mgr_get_bytes(NULL, TEST_BUFFER_SIZE);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_len_0_fail)
+{
+    //arrange
+    unsigned char buffer[TEST_BUFFER_SIZE];
+
+    //act
+    int result = random_mgr_get_bytes(buffer, 0);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_succeed)
+{
+    //arrange
+    unsigned char buffer[TEST_BUFFER_SIZE] = { 0 };
+    STRICT_EXPECTED_CALL(getrandom(buffer, TEST_BUFFER_SIZE, 0));
+
+    //act
+    int result = random_mgr_get_bytes(buffer, TEST_BUFFER_SIZE);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(is_filled(buffer, TEST_BUFFER_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_short_read_succeed)
+{
+    //arrange
+    unsigned char buffer[TEST_BUFFER_SIZE] = { 0 };
+    memset(buffer, TEST_RANDOM_BYTE, TEST_SHORT_READ_SIZE);
+    STRICT_EXPECTED_CALL(getrandom(buffer, TEST_BUFFER_SIZE, 0)).SetReturn(TEST_SHORT_READ_SIZE);
+    STRICT_EXPECTED_CALL(getrandom(buffer + TEST_SHORT_READ_SIZE, TEST_BUFFER_SIZE - TEST_SHORT_READ_SIZE, 0));
+
+    //act
+    int result = random_mgr_get_bytes(buffer, TEST_BUFFER_SIZE);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(is_filled(buffer, TEST_BUFFER_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_interrupted_succeed)
+{
+    //arrange
+    unsigned char buffer[TEST_BUFFER_SIZE] = { 0 };
+    g_getrandom_errno = EINTR;
+    STRICT_EXPECTED_CALL(getrandom(buffer, TEST_BUFFER_SIZE, 0));
+    STRICT_EXPECTED_CALL(getrandom(buffer, TEST_BUFFER_SIZE, 0));
+
+    //act
+    int result = random_mgr_get_bytes(buffer, TEST_BUFFER_SIZE);
+
+    //assert
+    CTEST_ASSERT_ARE_EQUAL(int, 0, result);
+    CTEST_ASSERT_IS_TRUE(is_filled(buffer, TEST_BUFFER_SIZE));
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_FUNCTION(random_mgr_get_bytes_fail)
+{
+    //arrange
+    unsigned char buffer[TEST_BUFFER_SIZE] = { 0 };
+    g_getrandom_errno = ENOSYS;
+    STRICT_EXPECTED_CALL(getrandom(buffer, TEST_BUFFER_SIZE, 0));
+
+    //act
+    int result = random_mgr_get_bytes(buffer, TEST_BUFFER_SIZE);
+
+    //assert
+    CTEST_ASSERT_ARE_NOT_EQUAL(int, 0, result);
+    CTEST_ASSERT_ARE_EQUAL(char_ptr, umock_c_get_expected_calls(), umock_c_get_actual_calls());
+
+    //cleanup
+}
+
+CTEST_END_TEST_SUITE(random_mgr_linux_ut)